@@ -0,0 +1,256 @@
+/*
+ * BufferPoolBenchmark.cpp - cost of acquiring and releasing frame buffers with many lcores
+ * contending for them.
+ *
+ * Every worker lcore repeatedly acquires a small batch of frame buffers, writes to the start of
+ * each as the packet processor does when resetting the super frame header, and releases them
+ * again. This is run first against a multi-producer/multi-consumer rte_ring populated with the
+ * buffers, as the shared clear_frames ring used to be, then against a DpdkBufferPool without and
+ * with per-lcore caches. The mean TSC cycles per acquire and release pair on each lcore and the
+ * aggregate rate across all lcores are reported for each variant. Run with 8 or more worker
+ * lcores to see the effect of contention.
+ *
+ * Usage: buffer_pool_benchmark [EAL args] -- [iterations] [hold] [cache_size] [num_buffers]
+ *            [buffer_size]
+ *
+ * e.g. buffer_pool_benchmark -l 0-8 -- 1000000 4 8
+ */
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include <log4cxx/logger.h>
+#include <log4cxx/basicconfigurator.h>
+
+#include <rte_cycles.h>
+#include <rte_eal.h>
+#include <rte_launch.h>
+#include <rte_lcore.h>
+#include <rte_pause.h>
+#include <rte_ring.h>
+
+#include "DpdkBufferPool.h"
+#include "DpdkSharedBuffer.h"
+#include "DpdkUtils.h"
+
+using namespace FrameProcessor;
+
+static const uint64_t default_iterations = 1000000;
+static const unsigned int default_hold = 4;
+static const unsigned int default_cache_size = 8;
+static const unsigned int default_num_buffers = 4096;
+static const std::size_t default_buffer_size = 65536;
+static const std::size_t header_touch_size = 256;
+static const unsigned int max_hold = 64;
+
+//! Acquire and release buffers through a shared MPMC ring
+struct RingBuffers
+{
+    struct rte_ring* ring;
+
+    inline void* acquire(void)
+    {
+        void* buffer;
+        return (rte_ring_dequeue(ring, &buffer) == 0) ? buffer : NULL;
+    }
+
+    inline void release(void* buffer)
+    {
+        rte_ring_enqueue(ring, buffer);
+    }
+};
+
+//! Acquire and release buffers through a buffer pool
+struct PoolBuffers
+{
+    DpdkBufferPool* pool;
+
+    inline void* acquire(void) { return pool->acquire(); }
+    inline void release(void* buffer) { pool->release(buffer); }
+};
+
+//! Shared state for one benchmark run across all worker lcores
+template <typename BuffersT>
+struct BenchmarkRun
+{
+    BuffersT buffers;               //!< Buffer acquire and release implementation
+    uint64_t iterations;            //!< Acquire and release batches per lcore
+    unsigned int hold;              //!< Buffers held in each batch
+    std::atomic<unsigned int> ready;    //!< Number of lcores ready to start
+    std::atomic<bool> go;               //!< Start flag for all lcores
+    std::atomic<uint64_t> failures;     //!< Total failed acquires
+    uint64_t cycles[RTE_MAX_LCORE];     //!< TSC cycles taken by each lcore
+};
+
+template <typename BuffersT>
+static int run_worker(void* arg)
+{
+    BenchmarkRun<BuffersT>* run = static_cast<BenchmarkRun<BuffersT>*>(arg);
+    void* held[max_hold];
+    uint64_t failures = 0;
+
+    run->ready.fetch_add(1);
+    while (!run->go.load())
+    {
+        rte_pause();
+    }
+
+    uint64_t start = rte_rdtsc_precise();
+    for (uint64_t iteration = 0; iteration < run->iterations; iteration++)
+    {
+        unsigned int acquired = 0;
+        for (unsigned int idx = 0; idx < run->hold; idx++)
+        {
+            void* buffer = run->buffers.acquire();
+            if (buffer == NULL)
+            {
+                failures++;
+                continue;
+            }
+            memset(buffer, 0, header_touch_size);
+            held[acquired++] = buffer;
+        }
+        while (acquired > 0)
+        {
+            run->buffers.release(held[--acquired]);
+        }
+    }
+    run->cycles[rte_lcore_id()] = rte_rdtsc_precise() - start;
+    run->failures.fetch_add(failures);
+
+    return 0;
+}
+
+//! Run the benchmark on all worker lcores and report the results
+template <typename BuffersT>
+static void run_benchmark(const char* name, BuffersT buffers, uint64_t iterations, unsigned int hold)
+{
+    BenchmarkRun<BuffersT> run;
+    run.buffers = buffers;
+    run.iterations = iterations;
+    run.hold = hold;
+    run.ready = 0;
+    run.go = false;
+    run.failures = 0;
+    memset(run.cycles, 0, sizeof(run.cycles));
+
+    rte_eal_mp_remote_launch(run_worker<BuffersT>, &run, SKIP_MAIN);
+    while (run.ready.load() < rte_lcore_count() - 1)
+    {
+        rte_pause();
+    }
+    run.go = true;
+    rte_eal_mp_wait_lcore();
+
+    uint64_t total_cycles = 0;
+    uint64_t max_cycles = 0;
+    unsigned int lcore_id;
+    RTE_LCORE_FOREACH_WORKER(lcore_id)
+    {
+        total_cycles += run.cycles[lcore_id];
+        if (run.cycles[lcore_id] > max_cycles)
+        {
+            max_cycles = run.cycles[lcore_id];
+        }
+    }
+
+    unsigned int num_workers = rte_lcore_count() - 1;
+    uint64_t ops_per_lcore = iterations * hold;
+    double seconds = static_cast<double>(max_cycles) / rte_get_tsc_hz();
+
+    std::cout << name << " cycles/op:  "
+              << static_cast<double>(total_cycles) / (ops_per_lcore * num_workers) << std::endl
+              << name << " Mops/sec:   "
+              << (ops_per_lcore * num_workers) / seconds / 1e6 << std::endl
+              << name << " failures:   " << run.failures.load() << std::endl;
+}
+
+//! Run all the benchmark variants over a shared buffer of the given size
+static bool run_all(
+    uint64_t iterations, unsigned int hold, unsigned int cache_size, unsigned int num_buffers,
+    std::size_t buffer_size, int socket_id
+)
+{
+    DpdkSharedBuffer shared_buffer(num_buffers * buffer_size, buffer_size, socket_id);
+
+    std::cout << "Worker lcores:              " << rte_lcore_count() - 1 << std::endl
+              << "Iterations:                 " << iterations << std::endl
+              << "Buffers held per iteration: " << hold << std::endl
+              << "Buffers:                    " << shared_buffer.get_num_buffers() << std::endl
+              << "Buffer size:                " << buffer_size << std::endl;
+
+    // Shared MPMC ring, as used for the clear_frames ring before the buffer pool
+    struct rte_ring* ring = rte_ring_create(
+        "buffer_pool_bench_ring", nearest_power_two(shared_buffer.get_num_buffers() + 1),
+        socket_id, 0
+    );
+    if (ring == NULL)
+    {
+        std::cerr << "Failed to create ring" << std::endl;
+        return false;
+    }
+    for (unsigned int element = 0; element < shared_buffer.get_num_buffers(); element++)
+    {
+        rte_ring_enqueue(ring, shared_buffer.get_buffer_address(element));
+    }
+    run_benchmark("MPMC ring          ", RingBuffers{ring}, iterations, hold);
+    rte_ring_free(ring);
+
+    {
+        DpdkBufferPool pool(shared_buffer, 0, socket_id);
+        run_benchmark("Pool, no cache     ", PoolBuffers{&pool}, iterations, hold);
+    }
+    {
+        DpdkBufferPool pool(shared_buffer, cache_size, socket_id);
+        std::cout << "Pool cache size:            " << cache_size << std::endl;
+        run_benchmark("Pool, lcore caches ", PoolBuffers{&pool}, iterations, hold);
+    }
+
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    log4cxx::BasicConfigurator::configure();
+    log4cxx::Logger::getRootLogger()->setLevel(log4cxx::Level::getWarn());
+
+    int eal_args = rte_eal_init(argc, argv);
+    if (eal_args < 0)
+    {
+        std::cerr << "Failed to initialise the DPDK EAL" << std::endl;
+        return 1;
+    }
+    argc -= eal_args;
+    argv += eal_args;
+
+    if (rte_lcore_count() < 2)
+    {
+        std::cerr << "At least one worker lcore is required" << std::endl;
+        rte_eal_cleanup();
+        return 1;
+    }
+
+    uint64_t iterations = (argc > 1) ? strtoull(argv[1], NULL, 0) : default_iterations;
+    unsigned int hold = (argc > 2) ? atoi(argv[2]) : default_hold;
+    unsigned int cache_size = (argc > 3) ? atoi(argv[3]) : default_cache_size;
+    unsigned int num_buffers = (argc > 4) ? atoi(argv[4]) : default_num_buffers;
+    std::size_t buffer_size = (argc > 5) ? strtoull(argv[5], NULL, 0) : default_buffer_size;
+
+    if (iterations == 0) iterations = default_iterations;
+    if ((hold == 0) || (hold > max_hold)) hold = default_hold;
+    if (num_buffers == 0) num_buffers = default_num_buffers;
+    if (buffer_size < header_touch_size) buffer_size = default_buffer_size;
+
+    int socket_id = rte_socket_id();
+    if (!run_all(iterations, hold, cache_size, num_buffers, buffer_size, socket_id))
+    {
+        rte_eal_cleanup();
+        return 1;
+    }
+
+    rte_eal_cleanup();
+    return 0;
+}
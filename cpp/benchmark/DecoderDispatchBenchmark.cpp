@@ -0,0 +1,163 @@
+/*
+ * DecoderDispatchBenchmark.cpp - packet rate of the packet processor decoder path with virtual
+ * and devirtualized decoder calls.
+ *
+ * Emulates the per-packet decoder work done by PacketProcessorCoreT::run: decoding the frame and
+ * packet numbers from the packet header, locating the frame header and payload destination in the
+ * super frame buffer and marking the packet received. The same templated loop is run first
+ * through a PacketProtocolDecoder pointer, as in PacketProcessorCore, then through a
+ * DummyDpdkDecoder pointer, as in DummyDpdkPacketProcessorCore. Payload copies are excluded by
+ * default so the figures isolate the decoder call overhead; pass a non-zero second argument to
+ * include them. The packets per second and mean TSC cycles per packet of each variant are
+ * reported.
+ *
+ * Usage: decoder_dispatch_benchmark [num_frames] [copy_payload]
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include <rte_cycles.h>
+
+#include "DataBlockFrame.h"
+#include "DummyDpdkDecoder.h"
+
+static const uint64_t default_num_frames = 20000;
+
+struct BenchmarkResult
+{
+    uint64_t packets;   //!< Number of packets processed
+    uint64_t cycles;    //!< TSC cycles taken
+    double seconds;     //!< Wall clock time taken
+};
+
+//! Build one frame of packets with the headers filled in for a dummy decoder
+static std::vector<char> build_packets(DummyDpdkDecoder& decoder, std::size_t& packet_size)
+{
+    std::size_t packets_per_frame = decoder.get_packets_per_frame();
+    packet_size = decoder.get_packet_payload_offset() + decoder.get_payload_size();
+
+    std::vector<char> packets(packet_size * packets_per_frame, 0);
+    for (std::size_t packet = 0; packet < packets_per_frame; packet++)
+    {
+        X10GPacketHeader* hdr = reinterpret_cast<X10GPacketHeader*>(
+            &packets[packet * packet_size] +
+            decoder.get_packet_payload_offset() - decoder.get_packet_header_size()
+        );
+        hdr->frame_number = 0;
+        hdr->packet_number = rte_cpu_to_be_32(static_cast<uint32_t>(packet));
+    }
+    return packets;
+}
+
+//! Run the packet processor decoder path over the packets for the given number of frames
+template <typename DecoderT>
+__attribute__((noinline)) static BenchmarkResult run_decoder_path(
+    DecoderT* decoder, std::vector<char>& packets, std::size_t packet_size,
+    SuperFrameHeader* super_frame, uint64_t num_frames, bool copy_payload
+)
+{
+    // Hide the dynamic type of the decoder so the virtual variant is not devirtualized
+    asm volatile("" : "+r"(decoder));
+
+    const std::size_t packets_per_frame = decoder->get_packets_per_frame();
+    const std::size_t payload_size = decoder->get_payload_size();
+    const std::size_t pkt_hdr_offset =
+        decoder->get_packet_payload_offset() - decoder->get_packet_header_size();
+    const std::size_t pkt_payload_offset = decoder->get_packet_payload_offset();
+    const uint64_t frame_outer_chunk_size = decoder->get_frame_outer_chunk_size();
+
+    uint64_t received = 0;
+
+    auto wall_start = std::chrono::steady_clock::now();
+    uint64_t start = rte_rdtsc_precise();
+
+    for (uint64_t frame = 0; frame < num_frames; frame++)
+    {
+        decoder->reset_super_frame(super_frame);
+        decoder->set_super_frame_number(super_frame, frame);
+
+        for (std::size_t packet = 0; packet < packets_per_frame; packet++)
+        {
+            char* pkt = &packets[packet * packet_size];
+            PacketHeader* pkt_header = reinterpret_cast<PacketHeader*>(pkt + pkt_hdr_offset);
+
+            uint64_t frame_number = decoder->get_frame_number(pkt_header) + frame;
+            uint32_t packet_number = decoder->get_packet_number(pkt_header);
+            uint64_t frame_index = frame_number % frame_outer_chunk_size;
+
+            RawFrameHeader* frame_header = decoder->get_frame_header(super_frame, frame_index);
+            char* payload_dest = decoder->get_image_data_start(super_frame) +
+                (frame_index * payload_size * packets_per_frame) + (packet_number * payload_size);
+
+            if (copy_payload)
+            {
+                rte_memcpy(payload_dest, pkt + pkt_payload_offset, payload_size);
+            }
+
+            if (decoder->set_packet_received(frame_header, packet_number))
+            {
+                if (decoder->get_packets_received(frame_header) == packets_per_frame)
+                {
+                    decoder->set_super_frame_frames_received(super_frame, frame_index);
+                }
+            }
+            received += (payload_dest != NULL);
+        }
+    }
+
+    uint64_t cycles = rte_rdtsc_precise() - start;
+    std::chrono::duration<double> wall = std::chrono::steady_clock::now() - wall_start;
+
+    return BenchmarkResult{received, cycles, wall.count()};
+}
+
+static void report(const char* name, const BenchmarkResult& result)
+{
+    std::cout << name << " packets/sec:    " << result.packets / result.seconds << std::endl
+              << name << " cycles/packet:  " << (double)result.cycles / result.packets
+              << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+    uint64_t num_frames = (argc > 1) ? strtoull(argv[1], NULL, 0) : default_num_frames;
+    if (num_frames == 0)
+    {
+        num_frames = default_num_frames;
+    }
+    bool copy_payload = (argc > 2) && (atoi(argv[2]) != 0);
+
+    DummyDpdkDecoder decoder;
+    PacketProtocolDecoder* virtual_decoder = &decoder;
+
+    std::size_t packet_size;
+    std::vector<char> packets = build_packets(decoder, packet_size);
+    std::vector<char> buffer(decoder.get_frame_buffer_size(), 0);
+    SuperFrameHeader* super_frame = reinterpret_cast<SuperFrameHeader*>(buffer.data());
+
+    // Warm up the caches before timing
+    run_decoder_path(virtual_decoder, packets, packet_size, super_frame, num_frames / 10 + 1,
+        copy_payload);
+    run_decoder_path(&decoder, packets, packet_size, super_frame, num_frames / 10 + 1,
+        copy_payload);
+
+    BenchmarkResult virtual_result = run_decoder_path(
+        virtual_decoder, packets, packet_size, super_frame, num_frames, copy_payload
+    );
+    BenchmarkResult direct_result = run_decoder_path(
+        &decoder, packets, packet_size, super_frame, num_frames, copy_payload
+    );
+
+    std::cout << "Frames:                     " << num_frames << std::endl
+              << "Packets per frame:          " << decoder.get_packets_per_frame() << std::endl
+              << "Payload copy:               " << (copy_payload ? "yes" : "no") << std::endl;
+    report("Virtual     ", virtual_result);
+    report("Devirtualized", direct_result);
+    std::cout << "Speedup:                    "
+              << (double)virtual_result.cycles / direct_result.cycles << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,705 @@
+/*
+ * PipelineBenchmark.cpp - offline throughput and latency benchmark of the packet receive pipeline.
+ *
+ * Runs the PacketRxCore -> PacketProcessorCore -> FrameBuilderCore -> FrameWrapperCore pipeline
+ * through a DpdkCoreManager exactly as the DummyDpdk plugin does, but without a NIC or remote
+ * packet generator. The EAL is booted without hugepages and the RX core hot plugs a net_ring
+ * virtual device. The main lcore then injects packets directly into the receive ring of that
+ * device, either synthetic X10G packets for the DummyDpdkDecoder or the packets of a pcap file,
+ * at a controlled rate and with optional packet loss and reordering within each frame.
+ *
+ * Frames delivered to the frame callback are timed against the injection time of their first
+ * packet, and a report of packet and frame rates, per-stage latency percentiles and drops is
+ * printed once the pipeline has drained.
+ *
+ * Usage: pipeline_benchmark --help
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <arpa/inet.h>
+
+#include <boost/program_options.hpp>
+#include <boost/scoped_ptr.hpp>
+
+#include <log4cxx/logger.h>
+#include <log4cxx/basicconfigurator.h>
+
+#include <rapidjson/document.h>
+
+#include <rte_cycles.h>
+#include <rte_ether.h>
+#include <rte_ip.h>
+#include <rte_mbuf.h>
+#include <rte_mempool.h>
+#include <rte_pause.h>
+#include <rte_ring.h>
+#include <rte_udp.h>
+
+#include "DpdkCoreManager.h"
+#include "DummyDpdkDecoder.h"
+#include "PacketProcessorCoreImpl.h"
+
+namespace po = boost::program_options;
+using namespace FrameProcessor;
+
+// The specialised dummy decoder core is registered by DummyDpdkPlugin, which is not linked here
+typedef PacketProcessorCoreT<DummyDpdkDecoder> DummyDpdkPacketProcessorCore;
+PACKETPROCESSORREGISTER(DummyDpdkPacketProcessorCore, DummyDpdkDecoder, "DummyDpdkPacketProcessorCore");
+
+static const std::string plugin_name = "PipelineBenchmark";
+static const uint16_t rx_port = 1234;
+static const char* device_ip = "10.0.0.1";
+static const unsigned int mbuf_pool_size = 16383;
+static const unsigned int inject_burst_size = 32;
+
+//! Benchmark options parsed from the command line
+struct PipelineBenchmarkOptions
+{
+    uint64_t num_frames;            //!< Number of frames to inject
+    double rate;                    //!< Injection rate in packets per second, 0 for unpaced
+    double loss;                    //!< Probability of dropping each packet before injection
+    double reorder;                 //!< Probability of displacing each packet within its frame
+    unsigned int reorder_distance;  //!< Maximum distance a packet is displaced by
+    unsigned int processor_cores;   //!< Number of packet processor cores
+    unsigned int builder_cores;     //!< Number of frame builder cores
+    std::string processor_class;    //!< Packet processor core class to run
+    std::string corelist;           //!< EAL lcore list, main lcore first
+    std::string device;             //!< Name of the net_ring virtual device
+    std::string pcap_file;          //!< Pcap file to replay instead of synthetic packets
+    unsigned int frame_timeout_ms;  //!< Packet processor frame timeout
+    unsigned int memory_mb;         //!< EAL memory size
+    unsigned int shared_buffer_mb;  //!< Shared frame buffer size
+    unsigned int seed;              //!< Random seed for loss and reordering
+    bool dump_status;               //!< Print the full core status after the run
+};
+
+//! An entry in the injection schedule, referencing a synthetic packet or a pcap record
+struct ScheduledPacket
+{
+    uint32_t frame;     //!< Frame index relative to the first frame injected
+    uint32_t source;    //!< Packet number in frame, or index of the pcap record
+};
+
+//! Per-frame timestamps shared between the injector and the frame callback
+struct FrameTimes
+{
+    std::vector<uint64_t> first_inject;     //!< TSC at injection of the first packet of a frame
+    std::vector<uint64_t> processor_start;  //!< TSC the packet processor started the frame at
+    std::vector<uint64_t> delivered;        //!< TSC the frame was delivered to the callback
+    std::vector<uint32_t> packets_received; //!< Packets received into the frame
+};
+
+//! Read the packet records of a pcap file
+static bool read_pcap(const std::string& file_name, std::vector<std::vector<char> >& records)
+{
+    std::ifstream pcap(file_name, std::ios::binary);
+    if (!pcap)
+    {
+        std::cerr << "Unable to open pcap file " << file_name << std::endl;
+        return false;
+    }
+
+    uint32_t global_hdr[6];
+    if (!pcap.read(reinterpret_cast<char*>(global_hdr), sizeof(global_hdr)))
+    {
+        std::cerr << "Pcap file " << file_name << " has no global header" << std::endl;
+        return false;
+    }
+
+    // Microsecond or nanosecond resolution files are accepted in either byte order
+    bool swapped;
+    if ((global_hdr[0] == 0xa1b2c3d4) || (global_hdr[0] == 0xa1b23c4d))
+    {
+        swapped = false;
+    }
+    else if ((global_hdr[0] == 0xd4c3b2a1) || (global_hdr[0] == 0x4d3cb2a1))
+    {
+        swapped = true;
+    }
+    else
+    {
+        std::cerr << "Pcap file " << file_name << " has unknown magic number" << std::endl;
+        return false;
+    }
+
+    uint32_t record_hdr[4];
+    while (pcap.read(reinterpret_cast<char*>(record_hdr), sizeof(record_hdr)))
+    {
+        uint32_t incl_len = swapped ? rte_bswap32(record_hdr[2]) : record_hdr[2];
+        std::vector<char> record(incl_len);
+        if (!pcap.read(record.data(), incl_len))
+        {
+            break;
+        }
+        records.push_back(std::move(record));
+    }
+    return true;
+}
+
+//! Build the template of a synthetic packet for the dummy decoder
+static std::vector<char> build_packet_template(DummyDpdkDecoder& decoder)
+{
+    std::vector<char> packet(decoder.get_packet_payload_offset() + decoder.get_payload_size(), 0);
+
+    struct rte_ether_hdr* ether_hdr = reinterpret_cast<struct rte_ether_hdr*>(packet.data());
+    ether_hdr->ether_type = rte_cpu_to_be_16(RTE_ETHER_TYPE_IPV4);
+
+    struct rte_ipv4_hdr* ipv4_hdr = reinterpret_cast<struct rte_ipv4_hdr*>(ether_hdr + 1);
+    ipv4_hdr->version_ihl = RTE_IPV4_VHL_DEF;
+    ipv4_hdr->time_to_live = 64;
+    ipv4_hdr->next_proto_id = IPPROTO_UDP;
+    ipv4_hdr->total_length = rte_cpu_to_be_16(packet.size() - sizeof(struct rte_ether_hdr));
+    ipv4_hdr->dst_addr = inet_addr(device_ip);
+
+    struct rte_udp_hdr* udp_hdr = reinterpret_cast<struct rte_udp_hdr*>(ipv4_hdr + 1);
+    udp_hdr->dst_port = rte_cpu_to_be_16(rx_port);
+    udp_hdr->dgram_len = rte_cpu_to_be_16(
+        packet.size() - sizeof(struct rte_ether_hdr) - sizeof(struct rte_ipv4_hdr)
+    );
+
+    return packet;
+}
+
+//! Build the injection schedule, applying packet loss and reordering within each frame
+static std::vector<ScheduledPacket> build_schedule(
+    const PipelineBenchmarkOptions& opts, DummyDpdkDecoder& decoder,
+    const std::vector<std::vector<char> >& records, uint64_t& lost_packets
+)
+{
+    std::vector<ScheduledPacket> schedule;
+    std::mt19937_64 rng(opts.seed);
+    std::uniform_real_distribution<double> chance(0.0, 1.0);
+    std::uniform_int_distribution<unsigned int> distance(1, std::max(1u, opts.reorder_distance));
+
+    if (records.empty())
+    {
+        uint32_t packets_per_frame = decoder.get_packets_per_frame();
+        schedule.reserve(opts.num_frames * packets_per_frame);
+        for (uint32_t frame = 0; frame < opts.num_frames; frame++)
+        {
+            for (uint32_t packet = 0; packet < packets_per_frame; packet++)
+            {
+                schedule.push_back(ScheduledPacket{frame, packet});
+            }
+        }
+    }
+    else
+    {
+        // Frame indexes of replayed packets are relative to the first frame in the file
+        const std::size_t pkt_hdr_offset =
+            decoder.get_packet_payload_offset() - decoder.get_packet_header_size();
+        int64_t first_frame = -1;
+        for (uint32_t idx = 0; idx < records.size(); idx++)
+        {
+            if (records[idx].size() < decoder.get_packet_payload_offset())
+            {
+                continue;
+            }
+            PacketHeader* pkt_header = reinterpret_cast<PacketHeader*>(
+                const_cast<char*>(records[idx].data()) + pkt_hdr_offset
+            );
+            int64_t frame_number = decoder.get_frame_number(pkt_header);
+            if (first_frame == -1)
+            {
+                first_frame = frame_number;
+            }
+            if ((frame_number >= first_frame) &&
+                (static_cast<uint64_t>(frame_number - first_frame) < opts.num_frames))
+            {
+                schedule.push_back(ScheduledPacket{
+                    static_cast<uint32_t>(frame_number - first_frame), idx
+                });
+            }
+        }
+    }
+
+    // Displace packets by swapping them with a later packet of the same frame. The first packet
+    // of the schedule is left in place so the RX core latches the expected first frame
+    for (std::size_t idx = 1; idx < schedule.size(); idx++)
+    {
+        if ((opts.reorder > 0.0) && (chance(rng) < opts.reorder))
+        {
+            std::size_t swap_idx = idx + distance(rng);
+            if ((swap_idx < schedule.size()) && (schedule[swap_idx].frame == schedule[idx].frame))
+            {
+                std::swap(schedule[idx], schedule[swap_idx]);
+            }
+        }
+    }
+
+    if (opts.loss > 0.0)
+    {
+        std::size_t kept = 1;
+        for (std::size_t idx = 1; idx < schedule.size(); idx++)
+        {
+            if (chance(rng) < opts.loss)
+            {
+                lost_packets++;
+            }
+            else
+            {
+                schedule[kept++] = schedule[idx];
+            }
+        }
+        schedule.resize(std::min(kept, schedule.size()));
+    }
+
+    return schedule;
+}
+
+//! Build the plugin configuration for the benchmark pipeline
+static std::string build_config(const PipelineBenchmarkOptions& opts)
+{
+    unsigned int num_lcores = 4 + opts.processor_cores + opts.builder_cores;
+    std::string corelist = opts.corelist.empty() ?
+        "0-" + std::to_string(num_lcores - 1) : opts.corelist;
+
+    std::stringstream config;
+    config << "{"
+        << "\"dpdk_process_rank\": 0,"
+        << "\"num_secondary_processes\": 0,"
+        << "\"shared_buffer_size\": " << (uint64_t)opts.shared_buffer_mb * 1024 * 1024 << ","
+        << "\"dpdk_eal\": {"
+        <<     "\"corelist\": \"" << corelist << "\","
+        <<     "\"no-huge\": true,"
+        <<     "\"no-pci\": true,"
+        <<     "\"in-memory\": true,"
+        <<     "\"memory\": " << opts.memory_mb << ","
+        <<     "\"file-prefix\": \"pipeline_benchmark\""
+        << "},"
+        << "\"worker_cores\": {"
+        <<     "\"packet_rx\": {"
+        <<         "\"core_name\": \"PacketRxCore\","
+        <<         "\"num_cores\": 1,"
+        <<         "\"pcie_device\": \"" << opts.device << "\","
+        <<         "\"rx_ports\": [" << rx_port << "],"
+        <<         "\"device_ip\": \"" << device_ip << "\","
+        <<         "\"dpdk_device\": {"
+        <<             "\"mbuf_pool_size\": 4095,"
+        <<             "\"mbuf_cache_size\": 128,"
+        <<             "\"mtu\": 9000,"
+        <<             "\"rx_num_desc\": 1024,"
+        <<             "\"tx_num_desc\": 1024"
+        <<         "}"
+        <<     "},"
+        <<     "\"packet_processor\": {"
+        <<         "\"core_name\": \"" << opts.processor_class << "\","
+        <<         "\"num_cores\": " << opts.processor_cores << ","
+        <<         "\"connect\": \"packet_rx\","
+        <<         "\"frame_timeout\": " << opts.frame_timeout_ms
+        <<     "},"
+        <<     "\"frame_builder\": {"
+        <<         "\"core_name\": \"FrameBuilderCore\","
+        <<         "\"num_cores\": " << opts.builder_cores << ","
+        <<         "\"connect\": \"packet_processor\""
+        <<     "},"
+        <<     "\"frame_wrapper\": {"
+        <<         "\"core_name\": \"FrameWrapperCore\","
+        <<         "\"dataset_name\": \"benchmark\","
+        <<         "\"num_cores\": 1,"
+        <<         "\"connect\": \"frame_builder\""
+        <<     "}"
+        << "}"
+        << "}";
+
+    return config.str();
+}
+
+//! Sum all status parameters with the given name below a status object
+static uint64_t sum_status(const rapidjson::Value& value, const char* name)
+{
+    uint64_t sum = 0;
+    if (value.IsObject())
+    {
+        for (rapidjson::Value::ConstMemberIterator itr = value.MemberBegin();
+            itr != value.MemberEnd(); ++itr)
+        {
+            if ((strcmp(itr->name.GetString(), name) == 0) && itr->value.IsUint64())
+            {
+                sum += itr->value.GetUint64();
+            }
+            else
+            {
+                sum += sum_status(itr->value, name);
+            }
+        }
+    }
+    return sum;
+}
+
+//! Print percentiles of a set of latencies in microseconds
+static void report_latency(const char* stage, std::vector<uint64_t>& cycles, double cycles_per_us)
+{
+    std::cout << "  " << std::left << std::setw(28) << stage << std::right;
+    if (cycles.empty())
+    {
+        std::cout << "no samples" << std::endl;
+        return;
+    }
+
+    std::sort(cycles.begin(), cycles.end());
+    const double percentiles[] = {50.0, 90.0, 99.0, 99.9};
+    for (double percentile : percentiles)
+    {
+        std::size_t idx = std::min(
+            cycles.size() - 1, static_cast<std::size_t>(percentile / 100.0 * cycles.size())
+        );
+        std::cout << " p" << percentile << " " << std::fixed << std::setprecision(1)
+                  << cycles[idx] / cycles_per_us;
+    }
+    std::cout << " max " << cycles.back() / cycles_per_us << " us" << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+    PipelineBenchmarkOptions opts;
+
+    po::options_description desc("Offline packet pipeline benchmark options");
+    desc.add_options()
+        ("help,h", "Print this help message")
+        ("frames,f", po::value<uint64_t>(&opts.num_frames)->default_value(1000),
+            "Number of frames to inject")
+        ("rate,r", po::value<double>(&opts.rate)->default_value(0.0),
+            "Injection rate in packets per second, 0 to inject as fast as possible")
+        ("loss", po::value<double>(&opts.loss)->default_value(0.0),
+            "Probability of dropping each packet before injection")
+        ("reorder", po::value<double>(&opts.reorder)->default_value(0.0),
+            "Probability of displacing each packet within its frame")
+        ("reorder-distance", po::value<unsigned int>(&opts.reorder_distance)->default_value(8),
+            "Maximum number of packets a displaced packet is moved by")
+        ("processor-cores", po::value<unsigned int>(&opts.processor_cores)->default_value(2),
+            "Number of packet processor cores")
+        ("builder-cores", po::value<unsigned int>(&opts.builder_cores)->default_value(1),
+            "Number of frame builder cores")
+        ("processor-class",
+            po::value<std::string>(&opts.processor_class)->default_value("PacketProcessorCore"),
+            "Packet processor core class, e.g. DummyDpdkPacketProcessorCore")
+        ("corelist,l", po::value<std::string>(&opts.corelist)->default_value(""),
+            "EAL lcore list, defaults to one lcore per worker core plus the main lcore")
+        ("device", po::value<std::string>(&opts.device)->default_value("net_ring0"),
+            "Name of the net_ring virtual device to receive on")
+        ("pcap", po::value<std::string>(&opts.pcap_file)->default_value(""),
+            "Replay the packets of a pcap file instead of synthetic packets")
+        ("frame-timeout", po::value<unsigned int>(&opts.frame_timeout_ms)->default_value(100),
+            "Packet processor frame timeout in ms")
+        ("memory", po::value<unsigned int>(&opts.memory_mb)->default_value(2048),
+            "EAL memory size in MB")
+        ("shared-buffer", po::value<unsigned int>(&opts.shared_buffer_mb)->default_value(512),
+            "Shared frame buffer size in MB")
+        ("seed", po::value<unsigned int>(&opts.seed)->default_value(1),
+            "Random seed for packet loss and reordering")
+        ("status", po::bool_switch(&opts.dump_status),
+            "Print the full worker core status after the run")
+        ("verbose,v", "Enable INFO level logging from the worker cores");
+
+    po::variables_map vm;
+    try
+    {
+        po::store(po::parse_command_line(argc, argv, desc), vm);
+        po::notify(vm);
+    }
+    catch (const po::error& ex)
+    {
+        std::cerr << ex.what() << std::endl << desc << std::endl;
+        return 1;
+    }
+    if (vm.count("help"))
+    {
+        std::cout << desc << std::endl;
+        return 0;
+    }
+    if (opts.num_frames == 0)
+    {
+        std::cerr << "The number of frames must be greater than zero" << std::endl;
+        return 1;
+    }
+
+    BasicConfigurator::configure();
+    Logger::getRootLogger()->setLevel(vm.count("verbose") ? Level::getInfo() : Level::getWarn());
+    LoggerPtr logger = Logger::getLogger("FP.PipelineBenchmark");
+
+    DummyDpdkDecoder decoder;
+    const uint32_t packets_per_frame = decoder.get_packets_per_frame();
+    const std::size_t pkt_hdr_offset =
+        decoder.get_packet_payload_offset() - decoder.get_packet_header_size();
+
+    // Load the packets to replay, or build the template of the synthetic packets
+    std::vector<std::vector<char> > records;
+    if (!opts.pcap_file.empty())
+    {
+        if (!read_pcap(opts.pcap_file, records) || records.empty())
+        {
+            return 1;
+        }
+    }
+    std::vector<char> packet_template = build_packet_template(decoder);
+
+    uint64_t lost_packets = 0;
+    std::vector<ScheduledPacket> schedule = build_schedule(opts, decoder, records, lost_packets);
+
+    FrameTimes times;
+    times.first_inject.assign(opts.num_frames, 0);
+    times.processor_start.assign(opts.num_frames, 0);
+    times.delivered.assign(opts.num_frames, 0);
+    times.packets_received.assign(opts.num_frames, 0);
+    std::atomic<uint64_t> frames_delivered(0);
+    std::atomic<uint64_t> frames_incomplete(0);
+
+    // Record the delivery of each frame. Super frame headers precede the image data in the
+    // shared buffer, giving access to the timestamps set by the packet processor
+    const std::size_t image_data_offset = decoder.get_image_data_offset();
+    FrameCallback frame_callback = [&](boost::shared_ptr<Frame> frame)
+    {
+        uint64_t now = rte_get_tsc_cycles();
+        uint64_t frame_number = frame->get_frame_number();
+        SuperFrameHeader* super_frame = reinterpret_cast<SuperFrameHeader*>(
+            static_cast<char*>(frame->get_data_ptr()) - image_data_offset
+        );
+
+        if (frame_number < opts.num_frames)
+        {
+            uint32_t received = 0;
+            for (uint32_t idx = 0; idx < decoder.get_frame_outer_chunk_size(); idx++)
+            {
+                received += decoder.get_packets_received(
+                    decoder.get_frame_header(super_frame, idx)
+                );
+            }
+            times.processor_start[frame_number] = decoder.get_super_frame_start_time(super_frame);
+            times.delivered[frame_number] = now;
+            times.packets_received[frame_number] = received;
+        }
+        if (decoder.get_super_frame_frames_received(super_frame) <
+            decoder.get_frame_outer_chunk_size())
+        {
+            frames_incomplete++;
+        }
+        frames_delivered++;
+    };
+
+    // Start the pipeline
+    std::string config_str = build_config(opts);
+    rapidjson::Document config_doc;
+    config_doc.Parse(config_str.c_str());
+
+    OdinData::IpcMessage config(OdinData::IpcMessage::MsgTypeCmd,
+        OdinData::IpcMessage::MsgValCmdConfigure);
+    config.update(config_doc);
+    OdinData::IpcMessage reply;
+
+    boost::scoped_ptr<DpdkCoreManager> core_manager;
+    try
+    {
+        core_manager.reset(
+            new DpdkCoreManager(config, reply, plugin_name, &decoder, frame_callback)
+        );
+    }
+    catch (const std::exception& ex)
+    {
+        std::cerr << "Failed to create DPDK core manager: " << ex.what() << std::endl;
+        return 1;
+    }
+    if (!core_manager->start())
+    {
+        std::cerr << "Failed to start worker cores, check the lcore list" << std::endl;
+        return 1;
+    }
+
+    // The net_ring device receives from the ring it was created with, so packets enqueued on it
+    // are received by the RX core as if they had arrived from the wire
+    std::string rx_ring_name = "ETH_RXTX0_" + opts.device;
+    struct rte_ring* rx_ring = rte_ring_lookup(rx_ring_name.c_str());
+    if (rx_ring == NULL)
+    {
+        std::cerr << "Unable to find receive ring " << rx_ring_name << " of device "
+                  << opts.device << std::endl;
+        core_manager->stop();
+        return 1;
+    }
+
+    struct rte_mempool* pkt_pool = rte_pktmbuf_pool_create(
+        "bench_pkt_pool", mbuf_pool_size, 256, 0,
+        RTE_PKTMBUF_HEADROOM + packet_template.size(), rte_socket_id()
+    );
+    if (pkt_pool == NULL)
+    {
+        std::cerr << "Unable to create packet mbuf pool: " << rte_strerror(rte_errno) << std::endl;
+        core_manager->stop();
+        return 1;
+    }
+
+    // Enable receive for the number of frames to be injected
+    OdinData::IpcMessage rx_frames_config;
+    rx_frames_config.set_param("rx_enable", false);
+    rx_frames_config.set_param("rx_frames", opts.num_frames);
+    core_manager->configure(rx_frames_config);
+    OdinData::IpcMessage rx_enable_config;
+    rx_enable_config.set_param("rx_enable", true);
+    core_manager->configure(rx_enable_config);
+
+    const uint64_t tsc_hz = rte_get_tsc_hz();
+    const double cycles_per_us = tsc_hz / 1e6;
+    const uint64_t burst_cycles = (opts.rate > 0.0) ?
+        static_cast<uint64_t>(tsc_hz * inject_burst_size / opts.rate) : 0;
+
+    LOG4CXX_INFO(logger, "Injecting " << schedule.size() << " packets for " << opts.num_frames
+        << " frames into " << opts.device);
+
+    // Inject the schedule in bursts, pacing each burst to the requested rate
+    struct rte_mbuf* burst[inject_burst_size];
+    uint64_t injected_packets = 0;
+    uint64_t ring_full_retries = 0;
+    uint64_t inject_start = rte_get_tsc_cycles();
+    uint64_t next_burst = inject_start;
+
+    for (std::size_t sched_idx = 0; sched_idx < schedule.size(); )
+    {
+        unsigned int burst_size = std::min<std::size_t>(
+            inject_burst_size, schedule.size() - sched_idx
+        );
+        while (rte_pktmbuf_alloc_bulk(pkt_pool, burst, burst_size) != 0)
+        {
+            rte_pause();
+        }
+
+        for (unsigned int idx = 0; idx < burst_size; idx++)
+        {
+            const ScheduledPacket& entry = schedule[sched_idx + idx];
+            const std::vector<char>& source =
+                records.empty() ? packet_template : records[entry.source];
+
+            char* data = rte_pktmbuf_append(burst[idx], source.size());
+            rte_memcpy(data, source.data(), source.size());
+
+            if (records.empty())
+            {
+                X10GPacketHeader* hdr = reinterpret_cast<X10GPacketHeader*>(data + pkt_hdr_offset);
+                hdr->frame_number = entry.frame;
+                hdr->packet_number = rte_cpu_to_be_32(entry.source);
+            }
+        }
+
+        if (burst_cycles)
+        {
+            while (rte_get_tsc_cycles() < next_burst)
+            {
+                rte_pause();
+            }
+            next_burst += burst_cycles;
+        }
+
+        uint64_t now = rte_get_tsc_cycles();
+        for (unsigned int idx = 0; idx < burst_size; idx++)
+        {
+            uint32_t frame = schedule[sched_idx + idx].frame;
+            if (times.first_inject[frame] == 0)
+            {
+                times.first_inject[frame] = now;
+            }
+        }
+
+        unsigned int enqueued = 0;
+        while (enqueued < burst_size)
+        {
+            enqueued += rte_ring_enqueue_burst(
+                rx_ring, (void**)&burst[enqueued], burst_size - enqueued, NULL
+            );
+            if (enqueued < burst_size)
+            {
+                ring_full_retries++;
+                rte_pause();
+            }
+        }
+
+        injected_packets += burst_size;
+        sched_idx += burst_size;
+    }
+    uint64_t inject_cycles = rte_get_tsc_cycles() - inject_start;
+
+    // Wait for every frame with an injected packet to be delivered, allowing incomplete frames
+    // to time out in the packet processors
+    uint64_t expected_frames = 0;
+    for (uint64_t frame = 0; frame < opts.num_frames; frame++)
+    {
+        expected_frames += (times.first_inject[frame] != 0);
+    }
+    uint64_t drain_deadline = rte_get_tsc_cycles() +
+        ((2 * opts.frame_timeout_ms + 2000) * (tsc_hz / 1000));
+    while ((frames_delivered.load() < expected_frames) && (rte_get_tsc_cycles() < drain_deadline))
+    {
+        rte_delay_us_block(1000);
+    }
+    uint64_t last_delivery = *std::max_element(times.delivered.begin(), times.delivered.end());
+    uint64_t pipeline_cycles = std::max(last_delivery, inject_start + 1) - inject_start;
+
+    OdinData::IpcMessage status;
+    core_manager->status(status);
+    rapidjson::Document status_doc;
+    status_doc.Parse(status.encode());
+    const rapidjson::Value& status_params =
+        status_doc.HasMember("params") ? status_doc["params"] : status_doc;
+    uint64_t rx_dropped = sum_status(status_params, "dropped_packets");
+
+    core_manager->stop();
+
+    // Collate per-stage latencies and packet counts of the delivered frames
+    std::vector<uint64_t> rx_to_processor, processor_to_delivery, end_to_end;
+    uint64_t packets_in_frames = 0;
+    for (uint64_t frame = 0; frame < opts.num_frames; frame++)
+    {
+        if ((times.delivered[frame] == 0) || (times.first_inject[frame] == 0))
+        {
+            continue;
+        }
+        packets_in_frames += times.packets_received[frame];
+        end_to_end.push_back(times.delivered[frame] - times.first_inject[frame]);
+        if (times.processor_start[frame] >= times.first_inject[frame])
+        {
+            rx_to_processor.push_back(times.processor_start[frame] - times.first_inject[frame]);
+            processor_to_delivery.push_back(times.delivered[frame] - times.processor_start[frame]);
+        }
+    }
+
+    double inject_secs = inject_cycles / (double)tsc_hz;
+    double pipeline_secs = pipeline_cycles / (double)tsc_hz;
+
+    std::cout << std::fixed << std::setprecision(1)
+        << "Pipeline benchmark: " << opts.num_frames << " frames of " << packets_per_frame
+        << " packets via " << opts.device
+        << (records.empty() ? " (synthetic)" : " (pcap " + opts.pcap_file + ")") << std::endl
+        << "  processor class:            " << opts.processor_class
+        << " x " << opts.processor_cores << ", builders x " << opts.builder_cores << std::endl
+        << "  packets injected:           " << injected_packets
+        << " (" << lost_packets << " lost by injection)" << std::endl
+        << "  injection rate:             " << injected_packets / inject_secs << " packets/sec"
+        << " (" << ring_full_retries << " ring full retries)" << std::endl
+        << "  pipeline packet rate:       " << packets_in_frames / pipeline_secs
+        << " packets/sec" << std::endl
+        << "  pipeline frame rate:        " << frames_delivered.load() / pipeline_secs
+        << " frames/sec" << std::endl
+        << "  frames delivered:           " << frames_delivered.load() << " of " << expected_frames
+        << " (" << frames_incomplete.load() << " incomplete)" << std::endl
+        << "  packets dropped in pipeline: " << (injected_packets - packets_in_frames)
+        << " (" << rx_dropped << " reported by cores)" << std::endl
+        << "Latency (us):" << std::endl;
+    report_latency("inject -> processor start", rx_to_processor, cycles_per_us);
+    report_latency("processor start -> delivery", processor_to_delivery, cycles_per_us);
+    report_latency("end to end", end_to_end, cycles_per_us);
+
+    if (opts.dump_status)
+    {
+        std::cout << "Worker core status:" << std::endl << status.encode() << std::endl;
+    }
+
+    return (frames_delivered.load() == expected_frames) ? 0 : 2;
+}
@@ -0,0 +1,111 @@
+/*
+ * TraceLoggerBenchmark.cpp - per-frame cost of hot path logging in the packet processor.
+ *
+ * Emulates the logging done by PacketProcessorCore::run for each new and completed super frame,
+ * first with LOG4CXX_INFO enabled as previously done on the hot path, then with the same
+ * messages emitted with LOG4CXX_TRACE_LEVEL at the build trace level. Log output is sent to
+ * /dev/null so the figures reflect message formatting and appender dispatch on the lcore rather
+ * than terminal output. The mean TSC cycles per frame of each variant, and the cycles saved per
+ * frame, are reported.
+ *
+ * Usage: trace_logger_benchmark [num_frames]
+ */
+
+#include <cstdlib>
+#include <iostream>
+
+#include <log4cxx/logger.h>
+#include <log4cxx/propertyconfigurator.h>
+#include <log4cxx/helpers/properties.h>
+
+#include <rte_cycles.h>
+
+#include "DpdkTraceLogger.h"
+
+using namespace log4cxx;
+
+static const uint64_t default_num_frames = 100000;
+
+//! Emit the per-frame messages previously logged at INFO level by the packet processor
+static uint64_t run_info_logging(LoggerPtr logger, uint64_t num_frames, char* buffer)
+{
+    uint64_t start = rte_rdtsc_precise();
+    for (uint64_t frame = 0; frame < num_frames; frame++)
+    {
+        LOG4CXX_INFO(logger, "Starting histogram: " << frame);
+        LOG4CXX_INFO(logger, "Dequeued buffer at: " << (void*)buffer
+            << " frame_buffer_size: " << 2001024 << " ring_count: " << (frame & 1023));
+        LOG4CXX_INFO(logger, "memset current_super_frame_buffer_ to zero buffer location "
+            << (void*)buffer << " size " << 2001024);
+        LOG4CXX_INFO(logger, "Setting super frame number and start time");
+        LOG4CXX_INFO(logger, "Finish setting super frame number and start time");
+        LOG4CXX_INFO(logger, "Histogram complete: " << frame);
+        LOG4CXX_INFO(logger, "Core " << 2 << " with " << 1 << " complete sub frames"
+            << " with " << 250 << " complete Packets");
+    }
+    return rte_rdtsc_precise() - start;
+}
+
+//! Emit the same messages through the compile-time trace facility
+static uint64_t run_trace_logging(LoggerPtr logger, uint64_t num_frames, char* buffer)
+{
+    uint64_t start = rte_rdtsc_precise();
+    for (uint64_t frame = 0; frame < num_frames; frame++)
+    {
+        LOG4CXX_TRACE_LEVEL(1, logger, "Starting histogram: " << frame);
+        LOG4CXX_TRACE_LEVEL(2, logger, "Dequeued buffer at: " << (void*)buffer
+            << " frame_buffer_size: " << 2001024 << " ring_count: " << (frame & 1023));
+        LOG4CXX_TRACE_LEVEL(2, logger, "memset current_super_frame_buffer_ to zero buffer location "
+            << (void*)buffer << " size " << 2001024);
+        LOG4CXX_TRACE_LEVEL(2, logger, "Setting super frame number and start time");
+        LOG4CXX_TRACE_LEVEL(2, logger, "Finish setting super frame number and start time");
+        LOG4CXX_TRACE_LEVEL(1, logger, "Histogram complete: " << frame);
+        LOG4CXX_TRACE_LEVEL(2, logger, "Core " << 2 << " with " << 1 << " complete sub frames"
+            << " with " << 250 << " complete Packets");
+        // Prevent the compiler discarding the loop when all messages are compiled out
+        asm volatile("" : : "r"(frame) : "memory");
+    }
+    return rte_rdtsc_precise() - start;
+}
+
+int main(int argc, char** argv)
+{
+    uint64_t num_frames = (argc > 1) ? strtoull(argv[1], NULL, 0) : default_num_frames;
+    if (num_frames == 0)
+    {
+        num_frames = default_num_frames;
+    }
+
+    // Send all log output to /dev/null at INFO level
+    helpers::Properties props;
+    props.setProperty(LOG4CXX_STR("log4j.rootLogger"), LOG4CXX_STR("INFO, null"));
+    props.setProperty(LOG4CXX_STR("log4j.appender.null"),
+        LOG4CXX_STR("org.apache.log4j.FileAppender"));
+    props.setProperty(LOG4CXX_STR("log4j.appender.null.File"), LOG4CXX_STR("/dev/null"));
+    props.setProperty(LOG4CXX_STR("log4j.appender.null.layout"),
+        LOG4CXX_STR("org.apache.log4j.PatternLayout"));
+    props.setProperty(LOG4CXX_STR("log4j.appender.null.layout.ConversionPattern"),
+        LOG4CXX_STR("%d %-5p %c - %m%n"));
+    PropertyConfigurator::configure(props);
+
+    LoggerPtr logger = Logger::getLogger("FP.PacketProcCore");
+    char buffer[64];
+
+    // Warm up the logger and caches before timing
+    run_info_logging(logger, num_frames / 10 + 1, buffer);
+    run_trace_logging(logger, num_frames / 10 + 1, buffer);
+
+    uint64_t info_cycles = run_info_logging(logger, num_frames, buffer);
+    uint64_t trace_cycles = run_trace_logging(logger, num_frames, buffer);
+
+    double info_per_frame = (double)info_cycles / num_frames;
+    double trace_per_frame = (double)trace_cycles / num_frames;
+
+    std::cout << "Frames:                     " << num_frames << std::endl
+              << "Trace level:                " << FrameProcessor::dpdk_trace_level << std::endl
+              << "INFO logging cycles/frame:  " << info_per_frame << std::endl
+              << "Trace logging cycles/frame: " << trace_per_frame << std::endl
+              << "Cycles saved per frame:     " << info_per_frame - trace_per_frame << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,239 @@
+/*
+ * CoreMetrics.h - per-lcore worker core metrics, reported in status and through rte_telemetry.
+ *
+ * Each worker core owns a CoreMetrics block holding the frame rate, core usage and frame timing
+ * accounting common to all worker cores, plus any counters, gauges, per-frame timers and latency
+ * histograms the core adds. The owning lcore updates its own cache lines with plain loads and
+ * stores, and publishes a copy of the values into a separate block once a second, under a
+ * sequence lock. Readers, such as the status thread and the telemetry socket thread, only touch
+ * the published block and always see a consistent set of values from one publication.
+ *
+ * Every CoreMetrics block is held in a process-wide registry, which backs the /odin_data/cores
+ * and /odin_data/core telemetry commands, so that the metrics can be queried with
+ * dpdk-telemetry.py as well as through the plugin status.
+ *
+ * When profiling is enabled, the block also opens hardware performance counters on the owning
+ * lcore. The counts between begin_work() and the following busy() or frame() call are
+ * attributed to the frames processed, and the rest of each second to the idle loops. The
+ * results are reported as counts per frame and per idle loop, instructions per cycle and
+ * misses per thousand instructions, and can also be written to a CSV file once a second.
+ */
+
+#ifndef INCLUDE_COREMETRICS_H_
+#define INCLUDE_COREMETRICS_H_
+
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <rte_branch_prediction.h>
+#include <rte_common.h>
+#include <rte_cycles.h>
+
+#include <IpcMessage.h>
+
+#include "LatencyHistogram.h"
+#include "PerfCounters.h"
+
+struct rte_tel_data;
+
+namespace FrameProcessor
+{
+    class CoreMetrics
+    {
+    public:
+
+        //! Maximum number of counters, gauges and timers a core can add
+        static const unsigned int max_metrics = 24;
+
+        //! Kinds of metric a core can add
+        enum MetricKind
+        {
+            counter,    //!< Running total, incremented by the owning lcore
+            gauge,      //!< Value set by the owning lcore
+            timer       //!< Mean microseconds per frame over the last second, from added cycles
+        };
+
+        CoreMetrics(const std::string& name);
+        ~CoreMetrics();
+
+        unsigned int add_counter(const std::string& path);
+        unsigned int add_gauge(const std::string& path);
+        unsigned int add_timer(const std::string& path);
+        void add_histogram(const std::string& path, const LatencyHistogram* histogram);
+
+        void start(void);
+        void flush(void);
+
+        static void set_profiling(const bool enable, const std::string& csv_dir);
+
+        //! Publish the metrics if a second has elapsed since they were last published
+        //!
+        //! \param[in] now - current TSC cycle count
+        //!
+        inline void update(const uint64_t now)
+        {
+            if (unlikely((now - local_.period_start) >= local_.period_cycles))
+            {
+                roll_over(now);
+            }
+        }
+
+        //! Mark the start of a unit of work, for the hardware counters when profiling
+        inline void begin_work(void)
+        {
+            if (unlikely(perf_ != NULL))
+            {
+                perf_->read(local_.perf_work_start);
+            }
+        }
+
+        //! Count a loop iteration which found no work to do
+        inline void idle(void)
+        {
+            local_.period_idle_loops++;
+        }
+
+        //! Count a processed frame and the cycles spent on it
+        //!
+        //! \param[in] cycles - TSC cycles spent processing the frame
+        //!
+        inline void frame(const uint64_t cycles)
+        {
+            frames(1);
+            busy(cycles);
+        }
+
+        //! Count processed frames without any cycles spent on them
+        //!
+        //! \param[in] count - number of frames processed
+        //!
+        inline void frames(const uint64_t count)
+        {
+            local_.frames_processed += count;
+            local_.period_frames += count;
+        }
+
+        //! Count the cycles spent on a unit of work, which may complete any number of frames
+        //!
+        //! \param[in] cycles - TSC cycles spent on the work
+        //!
+        inline void busy(const uint64_t cycles)
+        {
+            local_.period_busy_cycles += cycles;
+            if (cycles > local_.max_busy_cycles)
+            {
+                local_.max_busy_cycles = cycles;
+            }
+            if (unlikely(perf_ != NULL))
+            {
+                end_work();
+            }
+        }
+
+        //! Add to a counter, or add cycles to a timer
+        //!
+        //! \param[in] id - ID of the counter or timer
+        //! \param[in] value - value to add
+        //!
+        inline void add(const unsigned int id, const uint64_t value)
+        {
+            local_.values[id] += value;
+        }
+
+        //! Set the value of a gauge
+        //!
+        //! \param[in] id - ID of the gauge
+        //! \param[in] value - value to set
+        //!
+        inline void set(const unsigned int id, const uint64_t value)
+        {
+            local_.values[id] = value;
+        }
+
+        //! A consistent copy of the published metric values
+        struct Snapshot
+        {
+            uint64_t frames_processed;      //!< Total frames processed
+            uint64_t frames_per_second;     //!< Frames processed in the last second
+            uint64_t idle_loops;            //!< Idle loop iterations in the last second
+            uint64_t core_usage;            //!< Busy fraction of the last second, scaled to 255
+            uint64_t mean_frame_us;         //!< Mean time spent per frame in the last second
+            uint64_t max_frame_us;          //!< Longest time spent on a unit of work
+            uint64_t values[max_metrics];   //!< Values of the counters, gauges and timers
+            uint64_t period_frames;         //!< Frames processed in the last period
+            uint64_t perf_counters;         //!< Number of hardware counters open when profiling
+            uint64_t perf_busy[PerfCounters::num_events];   //!< Counts for the last period's work
+            uint64_t perf_idle[PerfCounters::num_events];   //!< Counts for the last period's idling
+        };
+
+        void snapshot(Snapshot& snapshot) const;
+        void status(OdinData::IpcMessage& status, const std::string& path) const;
+        void telemetry(struct rte_tel_data* data) const;
+        const std::string& name(void) const { return name_; }
+
+    private:
+
+        //! Number of values in a published snapshot
+        static const unsigned int num_values = sizeof(Snapshot) / sizeof(uint64_t);
+
+        //! A metric added by the core
+        struct Metric
+        {
+            std::string path;   //!< Path the metric is reported under
+            MetricKind kind;    //!< Kind of metric
+        };
+
+        //! A latency histogram added by the core
+        struct Histogram
+        {
+            std::string path;                   //!< Path the histogram is reported under
+            const LatencyHistogram* histogram;  //!< Histogram, owned and recorded by the core
+        };
+
+        //! Values only accessed by the owning lcore
+        struct alignas(RTE_CACHE_LINE_SIZE) LocalValues
+        {
+            uint64_t period_start;          //!< TSC cycle count at the start of the period
+            uint64_t period_cycles;         //!< Length of a publication period in TSC cycles
+            uint64_t period_frames;         //!< Frames processed in the current period
+            uint64_t period_idle_loops;     //!< Idle loop iterations in the current period
+            uint64_t period_busy_cycles;    //!< Busy cycles in the current period
+            uint64_t max_busy_cycles;       //!< Longest unit of work in TSC cycles
+            uint64_t frames_processed;      //!< Total frames processed
+            uint64_t values[max_metrics + 1];   //!< Counter, gauge and timer values, plus spare
+            uint64_t perf_work_start[PerfCounters::num_events];   //!< Counts at begin_work()
+            uint64_t perf_period_start[PerfCounters::num_events]; //!< Counts at period start
+            uint64_t perf_period_busy[PerfCounters::num_events];  //!< Work counts in the period
+        };
+
+        //! Values published by the owning lcore for readers
+        struct alignas(RTE_CACHE_LINE_SIZE) PublishedValues
+        {
+            std::atomic<uint32_t> sequence;             //!< Sequence lock, odd while writing
+            std::atomic<uint64_t> values[num_values];   //!< Published snapshot values
+        };
+
+        unsigned int add_metric(const std::string& path, const MetricKind kind);
+        void roll_over(const uint64_t now);
+        void publish(const Snapshot& snapshot);
+        void end_work(void);
+        void start_profiling(void);
+        void stop_profiling(void);
+        void write_csv_row(const Snapshot& snapshot);
+
+        std::string name_;                      //!< Name of the metrics block, from the core
+        std::vector<Metric> metrics_;           //!< Counters, gauges and timers added by the core
+        std::vector<Histogram> histograms_;     //!< Latency histograms added by the core
+        Snapshot last_published_;               //!< Last published values, owned by the lcore
+        PerfCounters* perf_;                    //!< Hardware counters, NULL unless profiling
+        std::ofstream csv_file_;                //!< Profiling CSV file, if one is written
+
+        LocalValues local_;                     //!< Values only accessed by the owning lcore
+        PublishedValues published_;             //!< Values published for readers
+    };
+}
+
+#endif // INCLUDE_COREMETRICS_H_
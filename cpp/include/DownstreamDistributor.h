@@ -0,0 +1,108 @@
+/*
+ * DownstreamDistributor.h - distribution of frames from a worker core to its downstream cores.
+ *
+ * The distributor owns the downstream rings of a worker core and selects which ring each frame
+ * is enqueued on according to a configurable policy:
+ *
+ *   static         - ring frame_number % num_rings, as the worker cores have always done
+ *   least_occupied - the ring with the fewest queued frames, ties broken from the static ring
+ *   shared         - a single multi-consumer ring shared by all downstream cores, so an idle
+ *                    downstream core takes the next frame while a sibling is still busy
+ *
+ * Only the static policy keeps the frames handled by each downstream core in a fixed order.
+ */
+
+#ifndef INCLUDE_DOWNSTREAMDISTRIBUTOR_H_
+#define INCLUDE_DOWNSTREAMDISTRIBUTOR_H_
+
+#include <string>
+#include <vector>
+
+#include <rte_branch_prediction.h>
+#include <rte_ring.h>
+
+#include <log4cxx/logger.h>
+using namespace log4cxx;
+using namespace log4cxx::helpers;
+#include <DebugLevelLogger.h>
+#include <IpcMessage.h>
+
+namespace FrameProcessor
+{
+    class DownstreamDistributor
+    {
+    public:
+
+        //! Policies for selecting the downstream ring for each frame
+        enum DistributionPolicy
+        {
+            distribute_static,
+            distribute_least_occupied,
+            distribute_shared
+        };
+
+        DownstreamDistributor();
+
+        bool create_rings(
+            const std::string& core_name, const std::string& policy, const int num_downstream_cores,
+            const unsigned int ring_size, const int socket_id
+        );
+        void free_rings(void);
+
+        static struct rte_ring* lookup_upstream_ring(
+            const std::string& upstream_core, const int socket_id, const int proc_idx
+        );
+
+        //! Enqueue a frame on a downstream ring selected by the distribution policy
+        //!
+        //! \param[in] frame - pointer to the frame to enqueue
+        //! \param[in] frame_number - number of the frame, used by the static policy
+        //!
+        //! \return 0 on success, or the negative error returned by rte_ring_enqueue
+        //!
+        inline int enqueue(void* frame, const uint64_t frame_number)
+        {
+            unsigned int num_rings = rings_.size();
+            unsigned int ring_idx = frame_number % num_rings;
+
+            if (policy_ == distribute_least_occupied)
+            {
+                unsigned int min_count = rte_ring_count(rings_[ring_idx]);
+                for (unsigned int offset = 1; (offset < num_rings) && (min_count > 0); offset++)
+                {
+                    unsigned int idx = (ring_idx + offset) % num_rings;
+                    unsigned int count = rte_ring_count(rings_[idx]);
+                    if (count < min_count)
+                    {
+                        min_count = count;
+                        ring_idx = idx;
+                    }
+                }
+            }
+
+            int rc = rte_ring_enqueue(rings_[ring_idx], frame);
+            if (likely(rc == 0))
+            {
+                ring_enqueued_[ring_idx]++;
+            }
+            else
+            {
+                enqueue_failures_++;
+            }
+            return rc;
+        }
+
+        inline bool empty(void) const { return rings_.empty(); }
+        inline DistributionPolicy policy(void) const { return policy_; }
+        void status(OdinData::IpcMessage& status, const std::string& path) const;
+
+    private:
+        DistributionPolicy policy_;             //!< Downstream ring selection policy
+        std::vector<struct rte_ring*> rings_;   //!< Downstream rings
+        std::vector<uint64_t> ring_enqueued_;   //!< Frames enqueued on each ring by this core
+        uint64_t enqueue_failures_;             //!< Frames which could not be enqueued
+        LoggerPtr logger_;                      //!< Message logger instance
+    };
+}
+
+#endif // INCLUDE_DOWNSTREAMDISTRIBUTOR_H_
@@ -0,0 +1,136 @@
+/*
+ * DpdkBufferPool.h - a pool of free frame buffers from a DPDK shared buffer.
+ *
+ * Free buffers are held on an rte_stack, so the most recently released buffer, the one most
+ * likely to still be warm in the last level cache, is the next to be acquired. Each lcore keeps a
+ * small cache of buffers in front of the stack, in the same manner as an rte_mempool per-lcore
+ * cache, so that lcores acquiring and releasing frames only touch the shared stack once per
+ * cache refill or flush.
+ */
+
+#ifndef INCLUDE_DPDKBUFFERPOOL_H_
+#define INCLUDE_DPDKBUFFERPOOL_H_
+
+#include <atomic>
+#include <string>
+
+#include <rte_branch_prediction.h>
+#include <rte_lcore.h>
+#include <rte_memcpy.h>
+#include <rte_stack.h>
+
+#include <log4cxx/logger.h>
+using namespace log4cxx;
+using namespace log4cxx::helpers;
+#include <DebugLevelLogger.h>
+#include <IpcMessage.h>
+
+#include "DpdkSharedBuffer.h"
+
+namespace FrameProcessor
+{
+    class DpdkBufferPool
+    {
+    public:
+        //! Maximum number of buffers held in each lcore cache
+        static const unsigned int max_cache_size = 64;
+
+        DpdkBufferPool(
+            const DpdkSharedBuffer& shared_buf, const unsigned int cache_size,
+            const int socket_id=SOCKET_ID_ANY
+        );
+        ~DpdkBufferPool();
+
+        //! Acquire a free buffer from the pool
+        //!
+        //! \return pointer to the buffer, or NULL if no buffers are free
+        //!
+        inline void* acquire(void)
+        {
+            void* buffer = NULL;
+            unsigned int lcore_id = rte_lcore_id();
+
+            if ((cache_size_ == 0) || (lcore_id >= RTE_MAX_LCORE))
+            {
+                if (unlikely(rte_stack_pop(stack_, &buffer, 1) == 0))
+                {
+                    acquire_failures_.fetch_add(1, std::memory_order_relaxed);
+                    return NULL;
+                }
+                return buffer;
+            }
+
+            LcoreCache& cache = caches_[lcore_id];
+            if (unlikely(cache.len == 0))
+            {
+                // Refill the cache, falling back to a single buffer if the stack is running low
+                cache.len = rte_stack_pop(stack_, cache.objs, cache_size_);
+                if (cache.len == 0)
+                {
+                    cache.len = rte_stack_pop(stack_, cache.objs, 1);
+                }
+                if (unlikely(cache.len == 0))
+                {
+                    cache.failures++;
+                    return NULL;
+                }
+            }
+            return cache.objs[--cache.len];
+        }
+
+        //! Release a buffer back to the pool
+        //!
+        //! \param[in] buffer - pointer to the buffer to release
+        //!
+        inline void release(void* buffer)
+        {
+            unsigned int lcore_id = rte_lcore_id();
+
+            if ((cache_size_ == 0) || (lcore_id >= RTE_MAX_LCORE))
+            {
+                rte_stack_push(stack_, &buffer, 1);
+                return;
+            }
+
+            LcoreCache& cache = caches_[lcore_id];
+            cache.objs[cache.len++] = buffer;
+            if (unlikely(cache.len >= (2 * cache_size_)))
+            {
+                // Flush the least recently released half of the cache to the stack, keeping the
+                // warmest buffers on this lcore
+                rte_stack_push(stack_, cache.objs, cache_size_);
+                cache.len -= cache_size_;
+                rte_memcpy(cache.objs, &cache.objs[cache_size_], cache.len * sizeof(void*));
+            }
+        }
+
+        void flush(void);
+        const std::size_t get_num_buffers(void) const;
+        const std::size_t get_available(void) const;
+        const std::size_t get_cached(void) const;
+        const uint64_t get_acquire_failures(void) const;
+        void status(OdinData::IpcMessage& status, const std::string& path) const;
+
+    private:
+
+        struct LcoreCache
+        {
+            unsigned int len;                       //!< Number of buffers in the cache
+            uint64_t failures;                      //!< Failed acquires on this lcore
+            void* objs[2 * max_cache_size];         //!< Cached buffers, most recent last
+        } __rte_cache_aligned;
+
+        std::size_t num_buffers_;   //!< Number of buffers managed by the pool
+        unsigned int cache_size_;   //!< Number of buffers moved per lcore cache refill or flush
+        int socket_id_;             //!< DPDK NUMA socket ID for the pool
+        std::string name_;          //!< Pool name (used for DPDK lookups)
+        bool lock_free_;            //!< Pool stack is lock-free
+        bool created_;              //!< Pool stack was created, rather than found, by this instance
+        struct rte_stack* stack_;   //!< Stack of free buffers
+        LcoreCache* caches_;        //!< Per-lcore buffer caches
+        std::atomic<uint64_t> acquire_failures_; //!< Failed acquires from non-EAL threads
+        LoggerPtr logger_;          //!< Message logger instance
+    };
+}
+
+#endif // INCLUDE_DPDKBUFFERPOOL_H_
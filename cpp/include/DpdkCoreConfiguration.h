@@ -23,6 +23,17 @@ namespace FrameProcessor
         const unsigned int default_blosc_compcode = 1;
         const unsigned int default_blosc_blocksize = 0;
         const unsigned int default_blosc_num_threads = 1;
+        const unsigned int default_buffer_pool_cache_size = 8;
+        const std::size_t default_shared_buffer_segment_size = 1073741824;
+        const bool default_nic_socket_placement = true;
+        const bool default_smt_exclusive_placement = true;
+        const std::string default_distribution = "static";
+        const bool default_zero_fill_dropped = true;
+        const bool default_perf_profiling = false;
+        const std::string default_perf_csv_dir = "";
+        const bool default_flight_recorder = false;
+        const unsigned int default_flight_recorder_size = 65536;
+        const std::string default_flight_recorder_loss_dump = "";
     }
 
     class DpdkCoreConfiguration : public OdinData::ParamContainer
@@ -39,6 +50,15 @@ namespace FrameProcessor
                 ParamContainer(),
                 socket_(Defaults::default_socket),
                 shared_buffer_size_(Defaults::default_shared_buffer_size),
+                shared_buffer_segment_size_(Defaults::default_shared_buffer_segment_size),
+                buffer_pool_cache_size_(Defaults::default_buffer_pool_cache_size),
+                nic_socket_placement_(Defaults::default_nic_socket_placement),
+                smt_exclusive_placement_(Defaults::default_smt_exclusive_placement),
+                perf_profiling_(Defaults::default_perf_profiling),
+                perf_csv_dir_(Defaults::default_perf_csv_dir),
+                flight_recorder_(Defaults::default_flight_recorder),
+                flight_recorder_size_(Defaults::default_flight_recorder_size),
+                flight_recorder_loss_dump_(Defaults::default_flight_recorder_loss_dump),
                 num_processor_cores_(Defaults::default_num_processor_cores),
                 num_framebuilder_cores_(Defaults::default_num_framebuilder_cores),
                 num_framecompression_cores_(Defaults::default_num_framecompression_cores),
@@ -148,6 +168,8 @@ namespace FrameProcessor
             virtual void bind_params(void)
             {
                 bind_param<std::size_t>(shared_buffer_size_, "shared_buffer_size");
+                bind_param<std::size_t>(shared_buffer_segment_size_, "shared_buffer_segment_size");
+                bind_param<unsigned int>(buffer_pool_cache_size_, "buffer_pool_cache_size");
                 bind_param<unsigned int>(num_processor_cores_, "num_processor_cores");
                 bind_param<unsigned int>(num_framebuilder_cores_, "num_framebuilder_cores");
                 bind_param<unsigned int>(num_framecompression_cores_, "num_framecompression_cores");
@@ -162,10 +184,26 @@ namespace FrameProcessor
                 bind_param<ParamContainer::Document>(worker_core_params_, "worker_cores");
                 bind_param<ParamContainer::Document>(tensorstore_params_, "tensorstore_core");
                 bind_param<unsigned int>(socket_, "socket");
+                bind_param<bool>(nic_socket_placement_, "nic_socket_placement");
+                bind_param<bool>(smt_exclusive_placement_, "smt_exclusive_placement");
+                bind_param<bool>(perf_profiling_, "perf_profiling");
+                bind_param<std::string>(perf_csv_dir_, "perf_csv_dir");
+                bind_param<bool>(flight_recorder_, "flight_recorder");
+                bind_param<unsigned int>(flight_recorder_size_, "flight_recorder_size");
+                bind_param<std::string>(flight_recorder_loss_dump_, "flight_recorder_loss_dump");
             }
 
             std::size_t shared_buffer_size_;
+            std::size_t shared_buffer_segment_size_;      //!< Maximum shared buffer memzone size
+            unsigned int buffer_pool_cache_size_; //!< Buffers per lcore buffer pool cache refill
             unsigned int socket_;      //!< DPDK memzone shared buffer size
+            bool nic_socket_placement_;    //!< Place buffers, rings and cores on the NIC socket
+            bool smt_exclusive_placement_; //!< Avoid running worker cores on SMT siblings
+            bool perf_profiling_;          //!< Profile worker cores with hardware counters
+            std::string perf_csv_dir_;     //!< Directory for profiling CSV files, empty for none
+            bool flight_recorder_;         //!< Record frame events in the flight recorders
+            unsigned int flight_recorder_size_;    //!< Events held by each flight recorder
+            std::string flight_recorder_loss_dump_; //!< Prefix of dumps on frame loss, or none
             unsigned int num_processor_cores_;    //!< Number of packet processor cores to run
             unsigned int num_framebuilder_cores_; //!< Number of frame builder cores to run
             unsigned int num_framecompression_cores_; //!< Number of frame compression cores to run
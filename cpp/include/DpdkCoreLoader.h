@@ -19,6 +19,7 @@ namespace FrameProcessor
         ProtocolDecoder* decoder;
         FrameCallback& frame_callback;
         DpdkSharedBuffer* shared_buf;
+        DpdkBufferPool* buffer_pool;
 
     };
 
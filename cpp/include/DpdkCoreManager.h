@@ -23,6 +23,9 @@ using namespace log4cxx::helpers;
 #include "DpdkWorkerCore.h"
 
 #include "DpdkSharedBuffer.h"
+#include "DpdkBufferPool.h"
+#include "DpdkTopology.h"
+#include "DpdkServiceHost.h"
 #include "DpdkCoreConfiguration.h"
 #include "ProtocolDecoder.h"
 namespace FrameProcessor
@@ -55,6 +58,7 @@ namespace FrameProcessor
         char* param_value(const rapidjson::Value& param);
 
         static int start_worker(void* worker_ptr);
+        void resolve_placement_socket(void);
 
         boost::bimap<std::string, std::string> core_chain_order_;
 
@@ -69,12 +73,19 @@ namespace FrameProcessor
         typedef std::map<std::string, const char*> DpdkEalParamMap;
         static DpdkEalParamMap dpdk_eal_param_map_;
 
-        std::vector<std::vector<int> > available_core_ids_;
+        DpdkTopology* topology_;
+        int nic_socket_;
+        std::map<DpdkWorkerCore*, int> pinned_lcore_ids_;
         std::vector<int> used_core_ids_;
         std::vector<boost::shared_ptr<DpdkWorkerCore>> registered_cores_;
         std::vector<boost::shared_ptr<DpdkWorkerCore>> running_cores_;
 
+        DpdkServiceHost* service_host_;
+        std::map<DpdkWorkerCore*, std::pair<std::string, unsigned int>> service_core_params_;
+        std::vector<boost::shared_ptr<DpdkWorkerCore>> service_cores_;
+
         std::vector<DpdkSharedBuffer *> shared_buffers_;
+        std::vector<DpdkBufferPool *> buffer_pools_;
 
     };
 }
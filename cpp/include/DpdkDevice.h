@@ -2,6 +2,7 @@
 #define INCLUDE_DPDKDEVICE_H_
 
 #include <string>
+#include <vector>
 
 #include <log4cxx/logger.h>
 using namespace log4cxx;
@@ -12,6 +13,7 @@ using namespace log4cxx::helpers;
 #include <rte_debug.h>
 #include <rte_errno.h>
 #include <rte_ethdev.h>
+#include <rte_flow.h>
 
 #include "network/DpdkDeviceConfiguration.h"
 
@@ -21,19 +23,33 @@ namespace FrameProcessor
     {
     public:
 
-        DpdkDevice(uint16_t port_id, const DpdkDeviceConfiguration& config);
+        DpdkDevice(
+            uint16_t port_id, const DpdkDeviceConfiguration& config,
+            uint16_t split_header_size = 0
+        );
         ~DpdkDevice();
 
         bool start(void);
         bool stop(void);
+        bool configure_steering(const std::vector<uint16_t>& rx_ports);
 
         inline uint16_t port_id(void) const { return port_id_; }
         inline int socket_id(void) const { return socket_id_; }
+        inline uint16_t rx_rings(void) const { return rx_rings_; }
+        inline uint16_t tx_rings(void) const { return tx_rings_; }
+        inline const std::string& rx_steering(void) const { return rx_steering_; }
+        inline bool hw_steering(void) const { return hw_steering_; }
+        inline bool buffer_split(void) const { return buffer_split_; }
+        inline bool single_segment(void) const { return rx_single_segment_; }
+        inline uint16_t mbuf_data_room(void) const { return mbuf_data_room_; }
 
     private:
 
         bool init_mbuf_pool(void);
+        bool init_header_pool(void);
         bool init_port(void);
+        struct rte_flow* create_queue_flow(const struct rte_flow_item* pattern, uint16_t queue);
+        void flush_flows(void);
 
         uint16_t port_id_;
         int      socket_id_;
@@ -44,6 +60,7 @@ namespace FrameProcessor
         unsigned int mbuf_pool_size_;
         unsigned int mbuf_cache_size_;
         struct rte_mempool* mbuf_pool_;
+        struct rte_mempool* header_pool_;
 
         uint32_t mtu_;
         uint16_t rx_rings_;
@@ -51,6 +68,17 @@ namespace FrameProcessor
         uint16_t tx_rings_;
         uint16_t tx_num_desc_;
 
+        std::string rx_steering_;
+        uint16_t steering_field_offset_;
+        bool rss_enabled_;
+        bool hw_steering_;
+        bool rx_buffer_split_;
+        bool rx_single_segment_;
+        uint16_t mbuf_data_room_;
+        uint16_t split_header_size_;
+        bool buffer_split_;
+        std::vector<struct rte_flow*> flows_;
+
         LoggerPtr logger_;
     };
 }
@@ -0,0 +1,82 @@
+/*
+ * DpdkServiceHost.h - hosting of low-rate worker cores as rte_service components.
+ *
+ * Worker cores which spend most of their time polling empty rings or control channels can be
+ * registered as DPDK service components and multiplexed onto a small number of shared service
+ * lcores, rather than each burning a dedicated lcore. Each hosted core is mapped to one service
+ * lcore, which calls its service_poll() method in turn with the other cores mapped to it.
+ *
+ * The service_start() and service_stop() methods of the hosted cores are called on their service
+ * lcore, before it starts and after it stops running services, so that any per-lcore state, for
+ * instance buffer pool caches, belongs to the lcore polling the core.
+ */
+
+#ifndef INCLUDE_DPDKSERVICEHOST_H_
+#define INCLUDE_DPDKSERVICEHOST_H_
+
+#include <string>
+#include <vector>
+
+#include <log4cxx/logger.h>
+using namespace log4cxx;
+using namespace log4cxx::helpers;
+#include <DebugLevelLogger.h>
+#include <IpcMessage.h>
+
+#include "DpdkWorkerCore.h"
+
+namespace FrameProcessor
+{
+    class DpdkServiceHost
+    {
+    public:
+
+        DpdkServiceHost();
+        ~DpdkServiceHost();
+
+        void add_core(
+            DpdkWorkerCore* core, const std::string& name, const unsigned int lcore_index
+        );
+        bool start(const std::vector<int>& lcore_ids);
+        void stop(void);
+
+        unsigned int get_num_lcores(void) const;
+        const std::vector<int>& get_lcore_ids(void) const;
+        bool empty(void) const;
+        void status(OdinData::IpcMessage& status, const std::string& path) const;
+
+    private:
+
+        //! A worker core hosted as a service component
+        struct HostedService
+        {
+            DpdkWorkerCore* core;       //!< Worker core polled by the service
+            std::string name;           //!< Service component name
+            unsigned int lcore_index;   //!< Index of the service lcore the core is mapped to
+            uint32_t service_id;        //!< Service ID assigned on registration
+            bool started;               //!< Core has been started on its service lcore
+            bool registered;            //!< Service component has been registered
+            uint64_t idle_calls;        //!< Calls which found no work to do
+        };
+
+        //! Arguments to the functions launched on a service lcore
+        struct LcoreLaunch
+        {
+            DpdkServiceHost* host;      //!< Service host
+            unsigned int lcore_index;   //!< Index of the service lcore
+            bool ok;                    //!< All the hosted cores started successfully
+        };
+
+        static int32_t run_service(void* service_ptr);
+        static int start_lcore_services(void* launch_ptr);
+        static int stop_lcore_services(void* launch_ptr);
+
+        std::vector<HostedService*> services_;  //!< Hosted services
+        std::vector<int> lcore_ids_;            //!< Service lcore IDs, by service lcore index
+        uint64_t start_cycles_;                 //!< TSC cycle count when the services started
+        bool running_;                          //!< Services are running on the service lcores
+        LoggerPtr logger_;                      //!< Message logger instance
+    };
+}
+
+#endif // INCLUDE_DPDKSERVICEHOST_H_
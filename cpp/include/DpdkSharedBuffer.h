@@ -8,12 +8,16 @@
 #ifndef INCLUDE_DPDKSHAREDBUFFER_H_
 #define INCLUDE_DPDKSHAREDBUFFER_H_
 
+#include <string>
+#include <vector>
+
 #include <rte_memzone.h>
 
 #include <log4cxx/logger.h>
 using namespace log4cxx;
 using namespace log4cxx::helpers;
 #include <DebugLevelLogger.h>
+#include <IpcMessage.h>
 
 namespace FrameProcessor
 {
@@ -22,23 +26,30 @@ namespace FrameProcessor
     public:
         DpdkSharedBuffer(
             const std::size_t mem_size, const std::size_t buffer_size,
-            const int socket_id=SOCKET_ID_ANY
+            const int socket_id=SOCKET_ID_ANY, const std::size_t segment_size=0
         );
         ~DpdkSharedBuffer();
         void* get_buffer_address(const unsigned int buffer) const;
         const std::size_t get_num_buffers(void) const;
         const std::size_t get_buffer_size(void) const;
         const std::size_t get_mem_size(void) const;
+        const std::size_t get_num_segments(void) const;
+        void status(OdinData::IpcMessage& status, const std::string& path) const;
 
     private:
-        std::size_t mem_size_;    //!< total size of the shared buffer memory zone
+        const struct rte_memzone* reserve_segment(const unsigned int segment, int& error) const;
+        void free_segments(void);
+
+        std::size_t mem_size_;    //!< total size of the shared buffer memory zones
         std::size_t buffer_size_; //!< size of each buffer in the shared buffer object
         std::size_t num_buffers_; //!< number of buffers in the shared buffer object
-        int socket_id_;           //!< DPDK NUMA socket ID for shared buffer memzone
+        std::size_t buffers_per_segment_; //!< number of buffers in each full memzone segment
+        int socket_id_;           //!< DPDK NUMA socket ID for shared buffer memzones
         std::string name_;        //!< Shared buffer name (used for DPDK lookups)
-        const struct rte_memzone *memzone_; //!< Pointer to DPDK memzone structure
+        std::vector<const struct rte_memzone*> memzones_; //!< DPDK memzone of each segment
+        std::vector<char*> segment_addrs_;                //!< Base address of each segment
         LoggerPtr logger_;        //!< Message logger instance
     };
 }
 
-#endif // INCLUDE_DPDKSHAREDBUFFER_H_
\ No newline at end of file
+#endif // INCLUDE_DPDKSHAREDBUFFER_H_
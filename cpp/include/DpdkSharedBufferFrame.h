@@ -1,7 +1,7 @@
 #ifndef INCLUDE_DPDKSHAREDBUFFERFRAME_H_
 #define INCLUDE_DPDKSHAREDBUFFERFRAME_H_
 
-#include "rte_ring.h"
+#include "DpdkBufferPool.h"
 #include "Frame.h"
 namespace FrameProcessor {
 
@@ -14,13 +14,13 @@ class DpdkSharedBufferFrame : public Frame {
      * @param meta_data 
      * @param data_src 
      * @param nbytes 
-     * @param frame_processed 
+     * @param buffer_pool pool to release the buffer to on destruction
      * @param image_offset 
      */
     DpdkSharedBufferFrame(const FrameMetaData & meta_data,
                             void *data_src,
                             size_t nbytes,
-                            rte_ring *frame_processed,
+                            DpdkBufferPool *buffer_pool,
                             const int& image_offset = 0);
 
     /**
@@ -41,7 +41,7 @@ class DpdkSharedBufferFrame : public Frame {
   void *image_ptr_;
   void *data_ptr_;
 
-  rte_ring *frame_processed_;  
+  DpdkBufferPool *buffer_pool_;
 
 };
 
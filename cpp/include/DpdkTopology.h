@@ -0,0 +1,69 @@
+/*
+ * DpdkTopology.h - NUMA and CPU topology used to place worker cores and their resources.
+ *
+ * The topology maps each DPDK worker lcore to the CPU it runs on, that CPU's socket, physical
+ * core and L3 cache domain, as read from sysfs. It is used by the core manager to place the
+ * shared buffer, rings and worker cores on the socket local to the NIC, and to select lcores so
+ * that worker cores do not share a physical core through SMT siblings while free physical cores
+ * remain on the socket.
+ */
+
+#ifndef INCLUDE_DPDKTOPOLOGY_H_
+#define INCLUDE_DPDKTOPOLOGY_H_
+
+#include <string>
+#include <vector>
+
+#include <rte_lcore.h>
+#include <rte_memory.h>
+
+#include <log4cxx/logger.h>
+using namespace log4cxx;
+using namespace log4cxx::helpers;
+#include <DebugLevelLogger.h>
+#include <IpcMessage.h>
+
+namespace FrameProcessor
+{
+    class DpdkTopology
+    {
+    public:
+        DpdkTopology();
+
+        static int device_socket(const std::string& device_name);
+
+        unsigned int get_num_sockets(void) const;
+        bool is_worker_lcore(const int lcore_id) const;
+        int lcore_socket(const int lcore_id) const;
+        int select_lcore(
+            const int socket_id, const std::vector<int>& used_lcores, const bool smt_exclusive
+        ) const;
+        void status(
+            OdinData::IpcMessage& status, const std::string& path,
+            const std::vector<int>& used_lcores
+        ) const;
+
+    private:
+
+        struct LcoreTopology
+        {
+            int lcore_id;       //!< DPDK lcore ID
+            int cpu_id;         //!< Operating system CPU ID the lcore runs on
+            int socket_id;      //!< NUMA socket of the CPU
+            int core_id;        //!< Physical core ID of the CPU within its package
+            int package_id;     //!< Physical package ID of the CPU
+            int l3_id;          //!< L3 cache domain ID of the CPU, -1 if unknown
+        };
+
+        const LcoreTopology* find_lcore(const int lcore_id) const;
+        bool shares_physical_core(
+            const LcoreTopology& lcore, const std::vector<int>& used_lcores
+        ) const;
+
+        std::vector<LcoreTopology> lcores_; //!< Worker lcores ordered by socket, L3 and core
+        unsigned int num_sockets_;          //!< Number of NUMA sockets detected by DPDK
+        LoggerPtr logger_;                  //!< Message logger instance
+    };
+}
+
+#endif // INCLUDE_DPDKTOPOLOGY_H_
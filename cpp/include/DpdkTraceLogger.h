@@ -0,0 +1,34 @@
+/*
+ * DpdkTraceLogger.h - compile-time trace logging for worker core hot paths.
+ *
+ * Trace messages on the per-frame and per-packet paths of the worker cores are emitted with
+ * LOG4CXX_TRACE_LEVEL. Messages with a level above DPDK_TRACE_LEVEL, set at build time with the
+ * CMake DPDK_TRACE_LEVEL cache variable, are compiled out entirely, so release builds pay no
+ * cost for formatting messages on the packet lcores. Messages at or below the trace level are
+ * logged at INFO level, subject to the usual runtime logger configuration.
+ */
+
+#ifndef INCLUDE_DPDKTRACELOGGER_H_
+#define INCLUDE_DPDKTRACELOGGER_H_
+
+#include <log4cxx/logger.h>
+
+#ifndef DPDK_TRACE_LEVEL
+#define DPDK_TRACE_LEVEL 0
+#endif
+
+namespace FrameProcessor
+{
+    //! Compile-time trace level, messages above this level are compiled out
+    static const int dpdk_trace_level = DPDK_TRACE_LEVEL;
+}
+
+#define LOG4CXX_TRACE_LEVEL(level, logger, message) \
+    do { \
+        if ((level) <= FrameProcessor::dpdk_trace_level) \
+        { \
+            LOG4CXX_INFO(logger, message); \
+        } \
+    } while (0)
+
+#endif // INCLUDE_DPDKTRACELOGGER_H_
@@ -26,10 +26,14 @@ namespace FrameProcessor
 
 
     std::string mbuf_pool_name_str(unsigned int socket_idx);
+    std::string mbuf_header_pool_name_str(unsigned int socket_idx);
     std::string ring_name_str(std::string UpStreamCore, unsigned int socket_idx, unsigned int core_idx=0);
+    std::string shared_ring_name_str(std::string core_name, unsigned int socket_idx);
     std::string ring_name_pkt_release(unsigned int socket_idx);
-    std::string ring_name_clear_frames(unsigned int socket_idx);
+    std::string buffer_pool_name_str(unsigned int socket_idx);
     std::string shared_mem_name_str(unsigned int socket_idx);
+    std::string shared_mem_segment_name_str(unsigned int socket_idx, unsigned int segment_idx);
+    std::string rx_frame_latch_name_str(unsigned int socket_idx);
 
     std::vector<uint16_t> tokenize_port_list(const std::string& port_list_str);
     std::string port_list_str(std::vector<uint16_t>& items);
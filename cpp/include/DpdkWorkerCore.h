@@ -16,6 +16,7 @@
 #include "DataBlockFrame.h"
 #include "ProtocolDecoder.h"
 #include "DpdkSharedBuffer.h"
+#include "DpdkBufferPool.h"
 #include "DpdkCoreConfiguration.h"
 #include "DpdkCoreLoader.h"
 
@@ -40,6 +41,26 @@ namespace FrameProcessor
         virtual bool connect(void) = 0;
         virtual void configure(OdinData::IpcMessage& config) = 0;
 
+        //! Check if the core can be run as an rte_service on a shared service lcore
+        virtual bool supports_service(void) const { return false; }
+
+        //! Prepare the core to be polled as a service, called on the service lcore
+        //!
+        //! \param[in] lcore_id - ID of the service lcore the core will be polled on
+        //!
+        //! \return true if the core is ready to be polled
+        //!
+        virtual bool service_start(unsigned int lcore_id) { return false; }
+
+        //! Run a single iteration of the core loop as a service
+        //!
+        //! \return 0 if the core did some work, -EAGAIN if it was idle
+        //!
+        virtual int32_t service_poll(void) { return -ENOTSUP; }
+
+        //! Clean up after the core has been polled as a service, called on the service lcore
+        virtual void service_stop(void) {}
+
         inline unsigned int lcore_id(void) const { return lcore_id_; }
         inline unsigned int socket_id(void) const { return socket_id_; }
 
@@ -0,0 +1,180 @@
+/*
+ * FlightRecorder.h - per-lcore record of the path each frame takes through the worker cores.
+ *
+ * Each worker core owns a FlightRecorder, a fixed-size ring of binary events, each holding the
+ * TSC cycle count, the super frame number, the stage and the event. Only the owning lcore writes
+ * to its ring, with plain stores, and the oldest events are overwritten once the ring is full, so
+ * the recorders always hold the most recent history of every lcore. Frames released back to the
+ * buffer pool by the plugin chain are recorded in a single shared recorder, under a lock, as they
+ * are released from threads outside the worker lcores.
+ *
+ * Recording is switched on and off for every recorder at once, and costs a single relaxed load
+ * and a predicted branch per event when off. The recorders can be dumped on demand, or
+ * automatically when a core drops or passes on an incomplete frame, to a Chrome trace event JSON
+ * file, which can be opened in Perfetto or chrome://tracing. Recording is paused while a dump
+ * reads the rings.
+ *
+ * In the trace, each lcore is a thread, the processing of a frame by a stage is a slice on the
+ * thread of the lcore running the stage, and the assembly of a frame from its packets is an
+ * asynchronous slice, as a packet processor assembles several frames at once. Flow arrows join
+ * the hand over of each frame between lcores, from the first packet received by a packet RX core,
+ * through each ring, to the release of the frame by the plugin chain, so that the time a frame
+ * waits in each ring can be read from the trace.
+ */
+
+#ifndef INCLUDE_FLIGHTRECORDER_H_
+#define INCLUDE_FLIGHTRECORDER_H_
+
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+#include <rte_branch_prediction.h>
+#include <rte_cycles.h>
+
+#include <IpcMessage.h>
+
+namespace FrameProcessor
+{
+    class FlightRecorder
+    {
+    public:
+
+        //! Pipeline stages a frame passes through
+        enum Stage
+        {
+            rx,         //!< Packet reception
+            process,    //!< Frame assembly from packets
+            build,      //!< Frame building
+            compress,   //!< Frame compression
+            wrap,       //!< Wrapping into a shared buffer frame for the plugin chain
+            access,     //!< Python access
+            release,    //!< Release back to the buffer pool by the plugin chain
+            num_stages
+        };
+
+        //! Events recorded for a frame in a stage
+        enum Event
+        {
+            first_packet,   //!< First packet of the frame received
+            dequeued,       //!< Frame dequeued from an upstream ring
+            begin,          //!< Stage started processing the frame
+            enqueued,       //!< Frame passed on to the next stage
+            end,            //!< Stage finished processing the frame
+            incomplete,     //!< Frame passed on with missing packets
+            dropped,        //!< Frame dropped
+            released,       //!< Frame released to the buffer pool
+            num_events
+        };
+
+        //! A recorded event
+        struct Record
+        {
+            uint64_t tsc;           //!< TSC cycle count of the event
+            uint32_t frame_number;  //!< Low 32 bits of the super frame number
+            uint16_t stage;         //!< Stage the event occurred in
+            uint16_t event;         //!< Event recorded
+        };
+
+        FlightRecorder(const std::string& name, const int socket_id);
+        ~FlightRecorder();
+
+        void start(void);
+
+        //! Record an event, if recording is enabled
+        //!
+        //! \param[in] frame_number - super frame number of the frame
+        //! \param[in] stage - stage the event occurred in
+        //! \param[in] event - event to record
+        //!
+        inline void record(const uint64_t frame_number, const Stage stage, const Event event)
+        {
+            if (unlikely(enabled_.load(std::memory_order_relaxed)))
+            {
+                write(rte_get_tsc_cycles(), frame_number, stage, event);
+            }
+        }
+
+        //! Record a lost or incomplete frame, dumping the recorders if a drop dump is armed
+        //!
+        //! \param[in] frame_number - super frame number of the frame
+        //! \param[in] stage - stage the frame was lost in
+        //! \param[in] event - dropped or incomplete
+        //!
+        inline void record_loss(const uint64_t frame_number, const Stage stage, const Event event)
+        {
+            if (unlikely(enabled_.load(std::memory_order_relaxed)))
+            {
+                write(rte_get_tsc_cycles(), frame_number, stage, event);
+                dump_on_loss();
+            }
+        }
+
+        //! Record the release of a frame by the plugin chain, from any thread
+        //!
+        //! \param[in] frame_number - super frame number of the frame
+        //!
+        static inline void record_release(const uint64_t frame_number)
+        {
+            if (unlikely(enabled_.load(std::memory_order_relaxed)))
+            {
+                write_release(rte_get_tsc_cycles(), frame_number);
+            }
+        }
+
+        static void configure(
+            const bool enable, const unsigned int size, const std::string& loss_dump_file
+        );
+        static void enable(const bool enable);
+        static bool enabled(void);
+        static void set_loss_dump_file(const std::string& loss_dump_file);
+        static bool dump(const std::string& file_name);
+        static void status(OdinData::IpcMessage& status, const std::string& path);
+
+        static const char* stage_name(const unsigned int stage);
+        static const char* event_name(const unsigned int event);
+
+    private:
+
+        //! Write an event into the ring, only called by the owning lcore
+        //!
+        //! \param[in] tsc - TSC cycle count of the event
+        //! \param[in] frame_number - super frame number of the frame
+        //! \param[in] stage - stage the event occurred in
+        //! \param[in] event - event to record
+        //!
+        inline void write(
+            const uint64_t tsc, const uint64_t frame_number, const Stage stage, const Event event
+        )
+        {
+            if (likely(records_ != NULL))
+            {
+                uint64_t head = head_.load(std::memory_order_relaxed);
+                Record& record = records_[head & mask_];
+                record.tsc = tsc;
+                record.frame_number = static_cast<uint32_t>(frame_number);
+                record.stage = static_cast<uint16_t>(stage);
+                record.event = static_cast<uint16_t>(event);
+                head_.store(head + 1, std::memory_order_release);
+            }
+        }
+
+        static void write_release(const uint64_t tsc, const uint64_t frame_number);
+        static void dump_on_loss(void);
+        static void dump_loss_thread(void);
+
+        uint64_t first_tsc(void) const;
+        void write_trace(std::ostream& trace, const uint64_t base_tsc) const;
+
+        std::string name_;              //!< Name of the recorder, from the core
+        unsigned int lcore_id_;         //!< ID of the lcore writing the recorder
+        Record* records_;               //!< Ring of recorded events, NULL if not allocated
+        uint64_t mask_;                 //!< Mask of the ring size
+        std::atomic<uint64_t> head_;    //!< Total number of events written
+
+        static std::atomic<bool> enabled_;  //!< Record events in every recorder
+    };
+}
+
+#endif // INCLUDE_FLIGHTRECORDER_H_
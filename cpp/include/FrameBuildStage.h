@@ -0,0 +1,51 @@
+/*
+ * FrameBuildStage.h - frame stage building a super frame from its received packets.
+ *
+ * The payload of any dropped packets is optionally cleared, as frame buffers are reused, and the
+ * decoder reorders the packets into a spare frame buffer held by the stage. The buffer the frame
+ * was not built into becomes the spare for the next frame. The frame headers, holding the packet
+ * state of each frame, are carried over to the built frame so that the packets missing from it
+ * can be reported downstream, whether or not their payload was cleared.
+ */
+
+#ifndef INCLUDE_FRAMEBUILDSTAGE_H_
+#define INCLUDE_FRAMEBUILDSTAGE_H_
+
+#include "FrameStage.h"
+#include "DpdkBufferPool.h"
+#include "LatencyHistogram.h"
+#include "network/PacketProtocolDecoder.h"
+
+namespace FrameProcessor
+{
+    class FrameBuildStage : public FrameStage
+    {
+    public:
+
+        FrameBuildStage(PacketProtocolDecoder* decoder, DpdkBufferPool* buffer_pool);
+
+        void set_zero_fill(const bool zero_fill) { zero_fill_ = zero_fill; }
+
+        bool start(void);
+        SuperFrameHeader* process(SuperFrameHeader* frame, const uint64_t frame_number);
+        void stop(void);
+        void add_metrics(CoreMetrics& metrics, const std::string& path) const;
+        const char* name(void) const { return "build"; }
+        FlightRecorder::Stage trace_stage(void) const { return FlightRecorder::build; }
+
+    private:
+
+        void clear_dropped_packets(SuperFrameHeader* frame);
+
+        PacketProtocolDecoder* decoder_;        //!< Decoder for the super frame layout
+        DpdkBufferPool* buffer_pool_;           //!< Pool to acquire the spare buffer from
+        SuperFrameHeader* reordered_frame_;     //!< Spare buffer for the next frame to build into
+        std::size_t frame_size_;                //!< Image size of each frame in bytes
+        std::size_t payload_size_;              //!< Packet payload size in bytes
+        bool zero_fill_;                        //!< Clear the payload of dropped packets
+
+        LatencyHistogram complete_to_built_;    //!< Super frame complete to built latency
+    };
+}
+
+#endif // INCLUDE_FRAMEBUILDSTAGE_H_
@@ -11,7 +11,9 @@ namespace FrameProcessor
         public:
 
             FrameBuilderConfiguration() :
-                ParamContainer()
+                ParamContainer(),
+                distribution_(Defaults::default_distribution),
+                zero_fill_dropped_(Defaults::default_zero_fill_dropped)
             {
                 bind_params();
             }
@@ -37,6 +39,8 @@ namespace FrameProcessor
                 bind_param<std::string>(upstream_core, "upstream_core");
                 bind_param<unsigned int>(num_cores, "num_cores");
                 bind_param<unsigned int>(num_downstream_cores, "num_downstream_cores");
+                bind_param<std::string>(distribution_, "distribution");
+                bind_param<bool>(zero_fill_dropped_, "zero_fill_dropped");
             }
 
             // Specfic config
@@ -45,6 +49,8 @@ namespace FrameProcessor
             std::string upstream_core;
             unsigned int num_cores;
             unsigned int num_downstream_cores;
+            std::string distribution_;  //!< Policy for distributing frames to downstream cores
+            bool zero_fill_dropped_;    //!< Clear the payload of dropped packets when building
 
             friend class FrameBuilderCore;
     };
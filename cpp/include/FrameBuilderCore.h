@@ -7,10 +7,14 @@ using namespace log4cxx::helpers;
 #include <DebugLevelLogger.h>
 
 #include "DpdkWorkerCore.h"
+#include "CoreMetrics.h"
+#include "FlightRecorder.h"
+#include "DownstreamDistributor.h"
 #include "DpdkSharedBuffer.h"
 #include "DpdkCoreConfiguration.h"
 #include "FrameBuilderConfiguration.h"
 #include "network/PacketProtocolDecoder.h"
+#include "FrameBuildStage.h"
 #include <rte_ring.h>
 #include <blosc.h>
 
@@ -40,18 +44,13 @@ namespace FrameProcessor
 
         LoggerPtr logger_;
 
-        // Status reporting variables
-        uint64_t built_frames_;
-        uint64_t built_frames_hz_;
-        uint64_t idle_loops_;
-        uint64_t mean_us_on_frame_;
-        uint64_t maximum_us_on_frame_;
-        uint8_t core_usage_;
-
+        CoreMetrics metrics_;           //!< Frame rate, core usage and timing metrics
+        FlightRecorder recorder_;       //!< Frame flight recorder
 
         struct rte_ring* upstream_ring_;
-        struct rte_ring* clear_frames_ring_;
-        std::vector<struct rte_ring*> downstream_rings_;
+        DpdkBufferPool* buffer_pool_;
+        DownstreamDistributor downstream_;
+        FrameBuildStage build_stage_;  //!< Stage building each super frame
     };
 }
 
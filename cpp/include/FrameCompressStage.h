@@ -0,0 +1,43 @@
+/*
+ * FrameCompressStage.h - frame stage compressing the image data of a super frame with blosc.
+ *
+ * The frame is compressed into a spare frame buffer held by the stage, along with a copy of the
+ * super frame and first frame headers. The uncompressed buffer becomes the spare for the next
+ * frame.
+ */
+
+#ifndef INCLUDE_FRAMECOMPRESSSTAGE_H_
+#define INCLUDE_FRAMECOMPRESSSTAGE_H_
+
+#include "FrameStage.h"
+#include "DpdkBufferPool.h"
+#include "LatencyHistogram.h"
+
+namespace FrameProcessor
+{
+    class FrameCompressStage : public FrameStage
+    {
+    public:
+
+        FrameCompressStage(ProtocolDecoder* decoder, DpdkBufferPool* buffer_pool);
+
+        bool start(void);
+        SuperFrameHeader* process(SuperFrameHeader* frame, const uint64_t frame_number);
+        void stop(void);
+        void add_metrics(CoreMetrics& metrics, const std::string& path) const;
+        const char* name(void) const { return "compress"; }
+        FlightRecorder::Stage trace_stage(void) const { return FlightRecorder::compress; }
+
+    private:
+        ProtocolDecoder* decoder_;              //!< Decoder for the super frame layout
+        DpdkBufferPool* buffer_pool_;           //!< Pool to acquire the spare buffer from
+        SuperFrameHeader* compressed_frame_;    //!< Spare buffer for the next frame to compress into
+        const char* compressor_name_;           //!< Name of the blosc compressor
+        std::size_t frame_size_;                //!< Uncompressed image size in bytes
+        std::size_t dest_data_size_;            //!< Space available for the compressed image
+
+        LatencyHistogram built_to_compressed_;  //!< Super frame built to compressed latency
+    };
+}
+
+#endif // INCLUDE_FRAMECOMPRESSSTAGE_H_
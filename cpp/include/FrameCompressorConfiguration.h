@@ -15,7 +15,8 @@ namespace FrameProcessor
                 blosc_doshuffle_(Defaults::default_blosc_doshuffle),
                 blosc_compcode_(Defaults::default_blosc_compcode),
                 blosc_blocksize_(Defaults::default_blosc_blocksize),
-                blosc_num_threads_(Defaults::default_blosc_num_threads)
+                blosc_num_threads_(Defaults::default_blosc_num_threads),
+                distribution_(Defaults::default_distribution)
             {
                 bind_params();
             }
@@ -40,6 +41,7 @@ namespace FrameProcessor
                 bind_param<std::string>(upstream_core, "upstream_core");
                 bind_param<unsigned int>(num_cores, "num_cores");
                 bind_param<unsigned int>(num_downstream_cores, "num_downstream_cores");
+                bind_param<std::string>(distribution_, "distribution");
                 
                 bind_param<std::string>(dataset_name_, "dataset_name");
                 bind_param<unsigned int>(blosc_clevel_, "blosc_clevel");
@@ -64,6 +66,7 @@ namespace FrameProcessor
             std::string upstream_core;
             unsigned int num_cores;
             unsigned int num_downstream_cores;
+            std::string distribution_;  //!< Policy for distributing frames to downstream cores
 
             friend class FrameCompressorCore;
     };
@@ -7,10 +7,14 @@ using namespace log4cxx::helpers;
 #include <DebugLevelLogger.h>
 
 #include "DpdkWorkerCore.h"
+#include "CoreMetrics.h"
+#include "FlightRecorder.h"
+#include "DownstreamDistributor.h"
 #include "DpdkCoreConfiguration.h"
 #include "FrameCompressorConfiguration.h"
 #include "ProtocolDecoder.h"
 #include "DpdkSharedBuffer.h"
+#include "FrameCompressStage.h"
 #include <rte_ring.h>
 #include <blosc.h>
 
@@ -40,19 +44,15 @@ namespace FrameProcessor
 
         LoggerPtr logger_;
 
-        // Status reporting variables
-        uint64_t last_frame_;
-        uint64_t processed_frames_;
-        uint64_t processed_frames_hz_;
-        uint64_t idle_loops_;
-        uint64_t mean_us_on_frame_;
-        uint64_t maximum_us_on_frame_;
-        uint8_t core_usage_;
+        CoreMetrics metrics_;           //!< Frame rate, core usage and timing metrics
+        FlightRecorder recorder_;       //!< Frame flight recorder
+        unsigned int last_frame_id_;    //!< Metric ID of the last frame number gauge
 
         struct rte_ring* frame_ready_ring_;
-        struct rte_ring* clear_frames_ring_;
+        DpdkBufferPool* buffer_pool_;
         struct rte_ring* upstream_ring_;
-        std::vector<struct rte_ring*> downstream_rings_;
+        DownstreamDistributor downstream_;
+        FrameCompressStage compress_stage_;  //!< Stage compressing each super frame
     };
 }
 
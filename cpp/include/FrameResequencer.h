@@ -0,0 +1,228 @@
+/*
+ * FrameResequencer.h - a bounded reorder window releasing super frames in frame number order.
+ *
+ * Frames arriving out of order are held in a window of slots indexed by super frame number
+ * modulo the window size, and released strictly in order as the next expected frame arrives.
+ * If the next expected frame has not arrived within the timeout while later frames are held,
+ * it is declared lost and skipped, along with any other missing frames before the earliest held
+ * frame. A frame too far ahead to fit in the window forces the window forward in the same way.
+ * A frame arriving after it was skipped is released immediately and counted as late, so no frame
+ * buffer is ever discarded by the resequencer.
+ *
+ * The resequencer is owned by a single worker core and is not thread safe; the status counters
+ * are read by the status thread without synchronisation, as for the other worker core counters.
+ */
+
+#ifndef INCLUDE_FRAMERESEQUENCER_H_
+#define INCLUDE_FRAMERESEQUENCER_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <rte_branch_prediction.h>
+
+#include <IpcMessage.h>
+
+#include "ProtocolDecoder.h"
+
+namespace FrameProcessor
+{
+    class FrameResequencer
+    {
+    public:
+
+        //! Constructor for the FrameResequencer class
+        //!
+        //! \param[in] window_size - maximum number of frames held in the reorder window
+        //! \param[in] timeout_cycles - TSC cycles to wait for a missing frame before skipping it
+        //!
+        FrameResequencer(const unsigned int window_size, const uint64_t timeout_cycles) :
+            window_size_(window_size),
+            timeout_cycles_(timeout_cycles),
+            slots_(window_size, NULL),
+            started_(false),
+            next_frame_(0),
+            blocked_since_(0),
+            occupancy_(0),
+            max_occupancy_(0),
+            released_frames_(0),
+            skipped_frames_(0),
+            late_frames_(0),
+            timeouts_(0)
+        {
+        }
+
+        //! Add a frame to the window and release any frames that are now in order
+        //!
+        //! \param[in] frame - pointer to the super frame
+        //! \param[in] frame_number - super frame number of the frame
+        //! \param[in] now - current TSC cycle count
+        //! \param[in] release - callable invoked with each frame released, in order
+        //!
+        template <typename ReleaseT>
+        inline void insert(
+            SuperFrameHeader* frame, const uint64_t frame_number, const uint64_t now,
+            ReleaseT& release
+        )
+        {
+            if (unlikely(!started_))
+            {
+                next_frame_ = frame_number;
+                started_ = true;
+            }
+
+            // Release a frame which has already been skipped straight away
+            if (unlikely(frame_number < next_frame_))
+            {
+                late_frames_++;
+                released_frames_++;
+                release(frame);
+                return;
+            }
+
+            // Advance the window, skipping missing frames, until this frame fits
+            while (unlikely(frame_number >= (next_frame_ + window_size_)))
+            {
+                if (occupancy_ == 0)
+                {
+                    skipped_frames_ += frame_number - next_frame_;
+                    next_frame_ = frame_number;
+                    break;
+                }
+                advance_head(release);
+            }
+
+            // Release a duplicate of a frame already held straight away
+            SuperFrameHeader*& slot = slots_[frame_number % window_size_];
+            if (unlikely(slot != NULL))
+            {
+                late_frames_++;
+                released_frames_++;
+                release(frame);
+                return;
+            }
+
+            if ((frame_number != next_frame_) && (occupancy_ == 0))
+            {
+                blocked_since_ = now;
+            }
+            slot = frame;
+            occupancy_++;
+            if (occupancy_ > max_occupancy_)
+            {
+                max_occupancy_ = occupancy_;
+            }
+
+            release_in_order(now, release);
+        }
+
+        //! Skip missing frames that have timed out and release the frames held behind them
+        //!
+        //! \param[in] now - current TSC cycle count
+        //! \param[in] release - callable invoked with each frame released, in order
+        //!
+        template <typename ReleaseT>
+        inline void poll(const uint64_t now, ReleaseT& release)
+        {
+            if (likely(occupancy_ == 0) || ((now - blocked_since_) < timeout_cycles_))
+            {
+                return;
+            }
+            timeouts_++;
+            skip_to_first_held();
+            release_in_order(now, release);
+        }
+
+        //! Release all held frames in order, skipping any missing frames between them
+        //!
+        //! \param[in] release - callable invoked with each frame released, in order
+        //!
+        template <typename ReleaseT>
+        void flush(ReleaseT& release)
+        {
+            while (occupancy_ > 0)
+            {
+                advance_head(release);
+            }
+        }
+
+        //! Report the window occupancy and frame counts into a status message
+        //!
+        //! \param[in] status - status message to populate
+        //! \param[in] path - parameter path to report the resequencer under, ending with "/"
+        //!
+        void status(OdinData::IpcMessage& status, const std::string& path) const
+        {
+            status.set_param(path + "window_size", window_size_);
+            status.set_param(path + "occupancy", occupancy_);
+            status.set_param(path + "max_occupancy", max_occupancy_);
+            status.set_param(path + "next_frame", next_frame_);
+            status.set_param(path + "released_frames", released_frames_);
+            status.set_param(path + "skipped_frames", skipped_frames_);
+            status.set_param(path + "late_frames", late_frames_);
+            status.set_param(path + "timeouts", timeouts_);
+        }
+
+    private:
+
+        //! Release frames from the head of the window for as long as they are present
+        template <typename ReleaseT>
+        inline void release_in_order(const uint64_t now, ReleaseT& release)
+        {
+            if (slots_[next_frame_ % window_size_] == NULL)
+            {
+                return;
+            }
+            while ((occupancy_ > 0) && (slots_[next_frame_ % window_size_] != NULL))
+            {
+                advance_head(release);
+            }
+            blocked_since_ = now;
+        }
+
+        //! Release the head frame if present, otherwise skip it, and move the window on by one
+        template <typename ReleaseT>
+        inline void advance_head(ReleaseT& release)
+        {
+            SuperFrameHeader*& head = slots_[next_frame_ % window_size_];
+            if (head != NULL)
+            {
+                release(head);
+                head = NULL;
+                occupancy_--;
+                released_frames_++;
+            }
+            else
+            {
+                skipped_frames_++;
+            }
+            next_frame_++;
+        }
+
+        //! Skip missing frames at the head of the window up to the first held frame
+        inline void skip_to_first_held(void)
+        {
+            while ((occupancy_ > 0) && (slots_[next_frame_ % window_size_] == NULL))
+            {
+                skipped_frames_++;
+                next_frame_++;
+            }
+        }
+
+        unsigned int window_size_;              //!< Maximum number of frames held
+        uint64_t timeout_cycles_;               //!< Cycles to wait for a missing frame
+        std::vector<SuperFrameHeader*> slots_;  //!< Held frames indexed by frame number
+        bool started_;                          //!< Next frame has been set from the first frame
+        uint64_t next_frame_;                   //!< Number of the next frame to release
+        uint64_t blocked_since_;                //!< Cycle count since the head has been missing
+        unsigned int occupancy_;                //!< Number of frames held in the window
+        unsigned int max_occupancy_;            //!< Most frames held in the window
+        uint64_t released_frames_;              //!< Frames released
+        uint64_t skipped_frames_;               //!< Frames declared lost and skipped
+        uint64_t late_frames_;                  //!< Frames released after being skipped
+        uint64_t timeouts_;                     //!< Times the window timed out on a missing frame
+    };
+}
+
+#endif // INCLUDE_FRAMERESEQUENCER_H_
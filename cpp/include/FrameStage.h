@@ -0,0 +1,66 @@
+/*
+ * FrameStage.h - a processing stage applied to each super frame by a worker core.
+ *
+ * The frame builder, compressor and wrapper cores each apply a single stage to every frame they
+ * dequeue. The FusedFrameCore applies a configured sequence of the same stages to each frame on
+ * one lcore, so a frame stays in the cache of that lcore rather than crossing a ring and an lcore
+ * for every stage.
+ *
+ * A stage is owned by a single worker core and is only called from the lcore running it. Any
+ * latency histograms a stage records are added to the metrics of its core, which report them.
+ */
+
+#ifndef INCLUDE_FRAMESTAGE_H_
+#define INCLUDE_FRAMESTAGE_H_
+
+#include <cstdint>
+#include <string>
+
+#include "CoreMetrics.h"
+#include "DataBlockFrame.h"
+#include "FlightRecorder.h"
+#include "ProtocolDecoder.h"
+
+namespace FrameProcessor
+{
+    class FrameStage
+    {
+    public:
+
+        virtual ~FrameStage() {};
+
+        //! Prepare the stage to process frames on the calling lcore
+        //!
+        //! \return true if the stage is ready, false if it should be retried
+        //!
+        virtual bool start(void) { return true; }
+
+        //! Process a frame
+        //!
+        //! \param[in] frame - pointer to the super frame
+        //! \param[in] frame_number - super frame number of the frame
+        //!
+        //! \return the frame to pass to the next stage, or NULL if the stage consumed the frame
+        //!
+        virtual SuperFrameHeader* process(SuperFrameHeader* frame, const uint64_t frame_number) = 0;
+
+        //! Release any resources held by the stage on the calling lcore
+        virtual void stop(void) {};
+
+        //! Add the stage metrics to the metrics of the core running it
+        //!
+        //! \param[in] metrics - metrics of the core running the stage
+        //! \param[in] path - path to report the stage under, relative to the core status path
+        //!                   and ending with "/"
+        //!
+        virtual void add_metrics(CoreMetrics& metrics, const std::string& path) const = 0;
+
+        //! Get the name of the stage, as used in the fused core stage list
+        virtual const char* name(void) const = 0;
+
+        //! Get the stage the frame events of this stage are recorded under
+        virtual FlightRecorder::Stage trace_stage(void) const = 0;
+    };
+}
+
+#endif // INCLUDE_FRAMESTAGE_H_
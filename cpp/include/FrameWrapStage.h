@@ -0,0 +1,67 @@
+/*
+ * FrameWrapStage.h - frame stage wrapping a super frame and passing it to the plugin chain.
+ *
+ * The frame buffer is wrapped in a DpdkSharedBufferFrame, which returns the buffer to the pool
+ * when the plugin chain releases the frame, so the stage consumes every frame it processes and
+ * must be the last stage applied to a frame.
+ *
+ * For frames from a packet protocol decoder, the number of packets lost from the super frame is
+ * set in the frame metadata as the packets_lost parameter. If any were lost, the packet state
+ * bitmap of every frame is also set, as the packet_mask parameter, with packet_state_words words
+ * for each frame in turn and a bit set for each packet received, so that the data of lost packets
+ * can be told apart from real data whether or not it was cleared when the frame was built.
+ */
+
+#ifndef INCLUDE_FRAMEWRAPSTAGE_H_
+#define INCLUDE_FRAMEWRAPSTAGE_H_
+
+#include <boost/function.hpp>
+
+#include <log4cxx/logger.h>
+using namespace log4cxx;
+using namespace log4cxx::helpers;
+#include <DebugLevelLogger.h>
+
+#include "FrameStage.h"
+#include "DpdkBufferPool.h"
+#include "DpdkCoreConfiguration.h"
+#include "DpdkCoreLoader.h"
+#include "LatencyHistogram.h"
+#include "network/PacketProtocolDecoder.h"
+
+namespace FrameProcessor
+{
+    class FrameWrapStage : public FrameStage
+    {
+    public:
+
+        FrameWrapStage(
+            ProtocolDecoder* decoder, DpdkBufferPool* buffer_pool, FrameCallback& frame_callback,
+            const std::string& dataset_name
+        );
+
+        SuperFrameHeader* process(SuperFrameHeader* frame, const uint64_t frame_number);
+        void add_metrics(CoreMetrics& metrics, const std::string& path) const;
+        const char* name(void) const { return "wrap"; }
+        FlightRecorder::Stage trace_stage(void) const { return FlightRecorder::wrap; }
+
+    private:
+
+        void set_packet_loss(SuperFrameHeader* frame, FrameMetaData& frame_meta);
+
+        ProtocolDecoder* decoder_;          //!< Decoder for the super frame layout
+        PacketProtocolDecoder* packet_decoder_; //!< Packet decoder for the packet state, or NULL
+        DpdkBufferPool* buffer_pool_;       //!< Pool the wrapped frames return their buffers to
+        FrameCallback& frame_callback_;     //!< Callback passing frames to the plugin chain
+        std::string dataset_name_;          //!< Dataset name set in the frame metadata
+        dimensions_t dims_;                 //!< Frame dimensions set in the frame metadata
+        std::size_t frame_size_;            //!< Uncompressed image size of the super frame
+        uint64_t data_pointer_offset_;      //!< Offset of the image data in the frame buffer
+
+        LatencyHistogram built_to_wrapped_; //!< Super frame built to wrapped latency
+
+        LoggerPtr logger_;                  //!< Message logger instance
+    };
+}
+
+#endif // INCLUDE_FRAMEWRAPSTAGE_H_
@@ -7,9 +7,13 @@ using namespace log4cxx::helpers;
 #include <DebugLevelLogger.h>
 
 #include "DpdkWorkerCore.h"
+#include "CoreMetrics.h"
+#include "FlightRecorder.h"
 #include "DpdkCoreConfiguration.h"
 #include "FrameWrapperCoreConfiguration.h"
 #include "ProtocolDecoder.h"
+#include "FrameWrapStage.h"
+#include "FrameResequencer.h"
 #include <rte_ring.h>
 #include <blosc.h>
 
@@ -31,7 +35,16 @@ namespace FrameProcessor
         bool connect(void);
         void configure(OdinData::IpcMessage& config);
 
+        bool supports_service(void) const { return true; }
+        bool service_start(unsigned int lcore_id);
+        int32_t service_poll(void);
+        void service_stop(void);
+
     private:
+        bool poll_frame(void);
+        void wrap_frame(struct SuperFrameHeader* frame);
+        void drain(void);
+
         int proc_idx_;
         ProtocolDecoder* decoder_;
         FrameWrapperConfiguration config_;
@@ -39,17 +52,15 @@ namespace FrameProcessor
         LoggerPtr logger_;
         FrameCallback& frame_callback_;
 
-        // Status reporting variables
-        uint64_t last_frame_;
-        uint64_t processed_frames_;
-        uint64_t processed_frames_hz_;
-        uint64_t idle_loops_;
-        uint64_t mean_us_on_frame_;
-        uint64_t maximum_us_on_frame_;
-        uint8_t core_usage_;
+        CoreMetrics metrics_;           //!< Frame rate, core usage and timing metrics
+        FlightRecorder recorder_;       //!< Frame flight recorder
+        unsigned int last_frame_id_;    //!< Metric ID of the last frame number gauge
+
+        FrameWrapStage* wrap_stage_;         //!< Stage wrapping frames for the plugin chain
+        FrameResequencer* resequencer_;      //!< Reorder window, NULL if frames are not reordered
 
         struct rte_ring* frame_ready_ring_;
-        struct rte_ring* clear_frames_ring_;
+        DpdkBufferPool* buffer_pool_;
         struct rte_ring* upstream_ring_;
     };
 }
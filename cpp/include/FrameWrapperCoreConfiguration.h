@@ -4,6 +4,12 @@
 
 namespace FrameProcessor
 {
+    namespace Defaults
+    {
+        const unsigned int default_resequence_window = 0;
+        const unsigned int default_resequence_timeout_ms = 100;
+    }
+
     class FrameWrapperConfiguration : public OdinData::ParamContainer
     {
         public:
@@ -15,7 +21,9 @@ namespace FrameProcessor
                 blosc_doshuffle_(Defaults::default_blosc_doshuffle),
                 blosc_compcode_(Defaults::default_blosc_compcode),
                 blosc_blocksize_(Defaults::default_blosc_blocksize),
-                blosc_num_threads_(Defaults::default_blosc_num_threads)
+                blosc_num_threads_(Defaults::default_blosc_num_threads),
+                resequence_window_(Defaults::default_resequence_window),
+                resequence_timeout_ms_(Defaults::default_resequence_timeout_ms)
             {
                 bind_params();
             }
@@ -47,6 +55,8 @@ namespace FrameProcessor
                 bind_param<unsigned int>(blosc_compcode_, "blosc_compcode");
                 bind_param<unsigned int>(blosc_blocksize_, "blosc_blocksize");
                 bind_param<unsigned int>(blosc_num_threads_, "blosc_num_threads");    
+                bind_param<unsigned int>(resequence_window_, "resequence_window");
+                bind_param<unsigned int>(resequence_timeout_ms_, "resequence_timeout_ms");
                 
 
             }
@@ -64,6 +74,8 @@ namespace FrameProcessor
             unsigned int blosc_compcode_;
             unsigned int blosc_blocksize_;
             unsigned int blosc_num_threads_;
+            unsigned int resequence_window_;     //!< Frames held to release in order, 0 to disable
+            unsigned int resequence_timeout_ms_; //!< Time to wait for a missing frame
 
 
             friend class FrameWrapperCore;
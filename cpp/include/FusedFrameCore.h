@@ -0,0 +1,72 @@
+/*
+ * FusedFrameCore.h - worker core running a sequence of frame stages on one lcore.
+ *
+ * The core applies the configured stages, e.g. build, compress and wrap, to each frame in turn
+ * on a single lcore, in place of a chain of worker cores connected by rings. This trades the
+ * pipeline parallelism of separate cores for locality, as a frame is not handed between lcores
+ * between stages, and the fused core is replicated with num_cores to scale instead. If the last
+ * stage is not wrap, frames are passed on to the downstream cores as by the other worker cores.
+ */
+
+#ifndef INCLUDE_FUSEDFRAMECORE_H_
+#define INCLUDE_FUSEDFRAMECORE_H_
+
+#include <vector>
+
+#include <log4cxx/logger.h>
+using namespace log4cxx;
+using namespace log4cxx::helpers;
+#include <DebugLevelLogger.h>
+
+#include "DpdkWorkerCore.h"
+#include "CoreMetrics.h"
+#include "FlightRecorder.h"
+#include "DownstreamDistributor.h"
+#include "DpdkCoreConfiguration.h"
+#include "FusedFrameCoreConfiguration.h"
+#include "FrameStage.h"
+#include "ProtocolDecoder.h"
+#include <rte_ring.h>
+
+namespace FrameProcessor
+{
+
+    class FusedFrameCore : public DpdkWorkerCore
+    {
+    public:
+
+        FusedFrameCore(
+            int fb_idx, int socket_id, DpdkWorkCoreReferences &dpdkWorkCoreReferences
+        );
+        ~FusedFrameCore();
+
+        bool run(unsigned int lcore_id);
+        void stop(void);
+        void status(OdinData::IpcMessage& status, const std::string& path);
+        bool connect(void);
+        void configure(OdinData::IpcMessage& config);
+
+    private:
+        bool create_stages(DpdkWorkCoreReferences &dpdkWorkCoreReferences);
+
+        int proc_idx_;
+        ProtocolDecoder* decoder_;
+        DpdkSharedBuffer* shared_buf_;
+        FusedFrameCoreConfiguration config_;
+
+        LoggerPtr logger_;
+
+        CoreMetrics metrics_;           //!< Frame rate, core usage and timing metrics
+        FlightRecorder recorder_;       //!< Frame flight recorder
+        unsigned int last_frame_id_;    //!< Metric ID of the last frame number gauge
+
+        std::vector<FrameStage*> stages_;           //!< Stages applied to each frame, in order
+        std::vector<unsigned int> stage_timer_ids_; //!< Metric IDs of the per-stage frame timers
+
+        DpdkBufferPool* buffer_pool_;
+        struct rte_ring* upstream_ring_;
+        DownstreamDistributor downstream_;
+    };
+}
+
+#endif // INCLUDE_FUSEDFRAMECORE_H_
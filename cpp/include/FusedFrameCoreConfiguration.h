@@ -0,0 +1,74 @@
+#ifndef INCLUDE_FUSEDFRAMECORECONFIGURATION_H_
+#define INCLUDE_FUSEDFRAMECORECONFIGURATION_H_
+
+#include "ParamContainer.h"
+#include "DpdkCoreConfiguration.h"
+#include <sstream>
+#include <vector>
+
+namespace FrameProcessor
+{
+    namespace Defaults
+    {
+        const std::vector<std::string> default_fused_stages = { "build", "wrap" };
+    }
+
+    class FusedFrameCoreConfiguration : public OdinData::ParamContainer
+    {
+        public:
+
+            FusedFrameCoreConfiguration() :
+                ParamContainer(),
+                num_downstream_cores(0),
+                distribution_(Defaults::default_distribution),
+                stages_(Defaults::default_fused_stages),
+                dataset_name_(Defaults::default_dataset_name),
+                zero_fill_dropped_(Defaults::default_zero_fill_dropped)
+            {
+                bind_params();
+            }
+
+            void resolve(DpdkCoreConfiguration& core_config_)
+            {
+                const ParamContainer::Value* value_ptr =
+                    core_config_.get_worker_core_config("fused_frame");
+
+                if (value_ptr != nullptr)
+                {
+                    update(*value_ptr);
+                }
+            }
+
+        private:
+
+            virtual void bind_params(void)
+            {
+                bind_param<std::string>(core_name, "core_name");
+                bind_param<std::string>(connect, "connect");
+                bind_param<std::string>(upstream_core, "upstream_core");
+                bind_param<unsigned int>(num_cores, "num_cores");
+                bind_param<unsigned int>(num_downstream_cores, "num_downstream_cores");
+                bind_param<std::string>(distribution_, "distribution");
+
+                bind_vector_param<std::string>(stages_, "stages");
+                bind_param<std::string>(dataset_name_, "dataset_name");
+                bind_param<bool>(zero_fill_dropped_, "zero_fill_dropped");
+            }
+
+            std::string core_name;
+            std::string connect;
+            std::string upstream_core;
+            unsigned int num_cores;
+            unsigned int num_downstream_cores;
+            std::string distribution_;  //!< Policy for distributing frames to downstream cores
+
+            // Specfic config
+            std::vector<std::string> stages_;   //!< Stages applied to each frame, in order
+            std::string dataset_name_;          //!< Dataset name of wrapped frames
+            bool zero_fill_dropped_;            //!< Clear the payload of dropped packets when building
+
+            friend class FusedFrameCore;
+    };
+}
+
+#endif // INCLUDE_FUSEDFRAMECORECONFIGURATION_H_
@@ -0,0 +1,176 @@
+/*
+ * LatencyHistogram.h - a log-linear histogram of TSC cycle latencies for worker core status.
+ *
+ * Latencies are counted into HDR-style buckets: values below the sub-bucket count are recorded
+ * exactly, and each power of two above that is split into half the sub-bucket count of linear
+ * buckets, bounding the relative error of any reported value to a few percent over the full
+ * 64-bit range with a fixed, preallocated bucket array. Each histogram has a single writer, the
+ * lcore that owns it, so recording is a handful of relaxed loads and stores with no atomic
+ * read-modify-write operations; the status thread reads the counters concurrently and may see
+ * a snapshot that is a few records out of step between buckets, which is harmless for reporting.
+ */
+
+#ifndef INCLUDE_LATENCYHISTOGRAM_H_
+#define INCLUDE_LATENCYHISTOGRAM_H_
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+#include <rte_cycles.h>
+
+#include <IpcMessage.h>
+
+namespace FrameProcessor
+{
+    class LatencyHistogram
+    {
+    public:
+
+        //! Constructor for the LatencyHistogram class
+        LatencyHistogram()
+        {
+            reset();
+        }
+
+        //! Record a latency into the histogram, must only be called from the owning lcore
+        //!
+        //! \param[in] cycles - latency in TSC cycles
+        //!
+        inline void record(uint64_t cycles)
+        {
+            increment(buckets_[bucket_index(cycles)]);
+            increment(count_);
+            total_.store(total_.load(std::memory_order_relaxed) + cycles, std::memory_order_relaxed);
+            if (cycles > max_.load(std::memory_order_relaxed))
+            {
+                max_.store(cycles, std::memory_order_relaxed);
+            }
+        }
+
+        //! Clear all recorded latencies
+        void reset(void)
+        {
+            for (unsigned int idx = 0; idx < num_buckets; idx++)
+            {
+                buckets_[idx].store(0, std::memory_order_relaxed);
+            }
+            count_.store(0, std::memory_order_relaxed);
+            total_.store(0, std::memory_order_relaxed);
+            max_.store(0, std::memory_order_relaxed);
+        }
+
+        //! Get the number of latencies recorded
+        inline uint64_t count(void) const { return count_.load(std::memory_order_relaxed); }
+
+        //! Get the largest latency recorded, in TSC cycles
+        inline uint64_t max(void) const { return max_.load(std::memory_order_relaxed); }
+
+        //! Get the latency at a percentile of the recorded values
+        //!
+        //! \param[in] percentile - percentile to report, from 0 to 100
+        //!
+        //! \return latency in TSC cycles at the midpoint of the bucket holding the percentile,
+        //!         or 0 if nothing has been recorded
+        //!
+        uint64_t percentile(double percentile) const
+        {
+            uint64_t total_count = count();
+            if (total_count == 0)
+            {
+                return 0;
+            }
+
+            uint64_t target = static_cast<uint64_t>((percentile / 100.0) * total_count + 0.5);
+            if (target < 1)
+            {
+                target = 1;
+            }
+
+            uint64_t cumulative = 0;
+            for (unsigned int idx = 0; idx < num_buckets; idx++)
+            {
+                cumulative += buckets_[idx].load(std::memory_order_relaxed);
+                if (cumulative >= target)
+                {
+                    uint64_t value = bucket_lower(idx) + (bucket_width(idx) / 2);
+                    uint64_t max_value = max();
+                    return (value < max_value) ? value : max_value;
+                }
+            }
+            return max();
+        }
+
+        //! Report the histogram summary into a status message
+        //!
+        //! \param[in] status - status message to populate
+        //! \param[in] path - parameter path to report the histogram under, ending with "/"
+        //!
+        void status(OdinData::IpcMessage& status, const std::string& path) const
+        {
+            double cycles_per_us = rte_get_tsc_hz() / 1000000.0;
+            uint64_t total_count = count();
+
+            status.set_param(path + "count", total_count);
+            status.set_param(path + "mean_us", total_count ?
+                (total_.load(std::memory_order_relaxed) / cycles_per_us) / total_count : 0.0);
+            status.set_param(path + "p50_us", percentile(50.0) / cycles_per_us);
+            status.set_param(path + "p90_us", percentile(90.0) / cycles_per_us);
+            status.set_param(path + "p99_us", percentile(99.0) / cycles_per_us);
+            status.set_param(path + "p999_us", percentile(99.9) / cycles_per_us);
+            status.set_param(path + "max_us", max() / cycles_per_us);
+        }
+
+    private:
+
+        static const unsigned int sub_bucket_bits = 5;
+        static const unsigned int sub_bucket_count = 1 << sub_bucket_bits;
+        static const unsigned int sub_bucket_half = sub_bucket_count / 2;
+        static const unsigned int num_buckets =
+            sub_bucket_count + ((64 - sub_bucket_bits) * sub_bucket_half);
+
+        static inline void increment(std::atomic<uint64_t>& counter)
+        {
+            counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        }
+
+        static inline unsigned int bucket_index(uint64_t value)
+        {
+            if (value < sub_bucket_count)
+            {
+                return static_cast<unsigned int>(value);
+            }
+            unsigned int msb = 63 - __builtin_clzll(value);
+            unsigned int shift = msb - sub_bucket_bits + 1;
+            return sub_bucket_count + ((msb - sub_bucket_bits) * sub_bucket_half) +
+                static_cast<unsigned int>((value >> shift) - sub_bucket_half);
+        }
+
+        static inline uint64_t bucket_lower(unsigned int idx)
+        {
+            if (idx < sub_bucket_count)
+            {
+                return idx;
+            }
+            unsigned int group = (idx - sub_bucket_count) / sub_bucket_half;
+            unsigned int offset = (idx - sub_bucket_count) % sub_bucket_half;
+            return static_cast<uint64_t>(sub_bucket_half + offset) << (group + 1);
+        }
+
+        static inline uint64_t bucket_width(unsigned int idx)
+        {
+            if (idx < sub_bucket_count)
+            {
+                return 1;
+            }
+            return static_cast<uint64_t>(1) << (((idx - sub_bucket_count) / sub_bucket_half) + 1);
+        }
+
+        std::atomic<uint64_t> buckets_[num_buckets];    //!< Count of latencies in each bucket
+        std::atomic<uint64_t> count_;                   //!< Number of latencies recorded
+        std::atomic<uint64_t> total_;                   //!< Sum of latencies recorded in cycles
+        std::atomic<uint64_t> max_;                     //!< Largest latency recorded in cycles
+    };
+}
+
+#endif // INCLUDE_LATENCYHISTOGRAM_H_
@@ -0,0 +1,71 @@
+/*
+ * PerfCounters.h - hardware performance counters for the calling worker lcore.
+ *
+ * The counters are opened with perf_event_open on the thread running a worker lcore, counting
+ * user space events only, so they can be opened with the default perf_event_paranoid setting.
+ * Where the kernel allows it, the counters are read from user space with rdpmc through the
+ * mmapped perf event page, which costs tens of cycles per counter; otherwise each read falls
+ * back to a read() system call. Counters the PMU or the kernel do not allow are left closed and
+ * read as zero, so profiling degrades to the events that are available.
+ */
+
+#ifndef INCLUDE_PERFCOUNTERS_H_
+#define INCLUDE_PERFCOUNTERS_H_
+
+#include <cstdint>
+
+#include <log4cxx/logger.h>
+using namespace log4cxx;
+using namespace log4cxx::helpers;
+#include <DebugLevelLogger.h>
+
+struct perf_event_mmap_page;
+
+namespace FrameProcessor
+{
+    class PerfCounters
+    {
+    public:
+
+        //! Hardware events counted
+        enum Event
+        {
+            cycles,
+            instructions,
+            llc_misses,
+            dtlb_misses,
+            branch_misses,
+            num_events
+        };
+
+        PerfCounters();
+        ~PerfCounters();
+
+        unsigned int open(void);
+        void close(void);
+
+        //! Read the current value of every counter, with zero for counters that are not open
+        //!
+        //! \param[out] values - counter values, indexed by event
+        //!
+        inline void read(uint64_t* values) const
+        {
+            for (unsigned int event = 0; event < num_events; event++)
+            {
+                values[event] = (fds_[event] >= 0) ? read_counter(event) : 0;
+            }
+        }
+
+        static const char* event_name(const unsigned int event);
+
+    private:
+
+        uint64_t read_counter(const unsigned int event) const;
+
+        int fds_[num_events];                           //!< Perf event file descriptors
+        struct perf_event_mmap_page* pages_[num_events];  //!< Mmapped perf event pages
+        LoggerPtr logger_;                              //!< Message logger instance
+    };
+}
+
+#endif // INCLUDE_PERFCOUNTERS_H_
@@ -3,6 +3,7 @@
 
 #include <cstdint>
 #include <cstddef>
+#include <cstring>
 #include <vector>
 #include "dpdk_version_compatibiliy.h"
 
@@ -13,6 +14,7 @@ struct __rte_packed_begin SuperFrameHeader
     uint64_t super_frame_number; // Chunk number
     uint64_t super_frame_start_time; // counter for timing out super frame
     uint64_t super_frame_complete_time;
+    uint64_t super_frame_built_time; // counter for when the super frame was built
     uint64_t super_frame_image_size;
     uint32_t frames_received; // Counter for number of frames copied into the super frame
     uint8_t frame_state[];   //!< Flexible array member - length depends on number of frames
@@ -85,6 +87,16 @@ public:
     {
         super_frame_hdr->super_frame_complete_time = complete_time;
     }
+
+    virtual const uint64_t get_super_frame_built_time(SuperFrameHeader* super_frame_hdr) const
+    {
+        return super_frame_hdr->super_frame_built_time;
+    }
+
+    virtual void set_super_frame_built_time(SuperFrameHeader* super_frame_hdr, uint64_t built_time)
+    {
+        super_frame_hdr->super_frame_built_time = built_time;
+    }
     
     virtual const uint64_t get_super_frame_image_size(SuperFrameHeader* super_frame_hdr) const
     {
@@ -169,6 +181,13 @@ public:
         return get_super_frame_header_size() + (get_frame_header_size() * frames_per_super_frame_);
     }
 
+    // Clear the super frame and frame headers of a buffer ready for reuse. The image data is
+    // not cleared, any payload not overwritten by received data is zeroed when the frame is built
+    virtual void reset_super_frame(SuperFrameHeader* super_frame_hdr)
+    {
+        memset(super_frame_hdr, 0, get_image_data_offset());
+    }
+
 
     // Abstract frame methods that must be implemented by application-specific decoders
     virtual const std::size_t get_frame_header_size(void) const = 0;
@@ -7,6 +7,8 @@ using namespace log4cxx::helpers;
 #include <DebugLevelLogger.h>
 
 #include "DpdkWorkerCore.h"
+#include "CoreMetrics.h"
+#include "FlightRecorder.h"
 #include "DpdkCoreConfiguration.h"
 #include "PythonAccessCoreConfiguration.h"
 #include "ProtocolDecoder.h"
@@ -32,7 +34,14 @@ namespace FrameProcessor
         bool connect(void);
         void configure(OdinData::IpcMessage& config);
 
+        bool supports_service(void) const { return true; }
+        bool service_start(unsigned int lcore_id);
+        int32_t service_poll(void);
+        void service_stop(void);
+
     private:
+        bool poll_frame(void);
+
         int proc_idx_;
         ProtocolDecoder* decoder_;
         DpdkSharedBuffer* shared_buf_;
@@ -40,17 +49,12 @@ namespace FrameProcessor
 
         LoggerPtr logger_;
 
-        // Status reporting variables
-        uint64_t last_frame_;
-        uint64_t processed_frames_;
-        uint64_t processed_frames_hz_;
-        uint64_t idle_loops_;
-        uint64_t mean_us_on_frame_;
-        uint64_t maximum_us_on_frame_;
-        uint8_t core_usage_;
+        CoreMetrics metrics_;           //!< Frame rate, core usage and timing metrics
+        FlightRecorder recorder_;       //!< Frame flight recorder
+        unsigned int last_frame_id_;    //!< Metric ID of the last frame number gauge
 
         struct rte_ring* frame_ready_ring_;
-        struct rte_ring* clear_frames_ring_;
+        DpdkBufferPool* buffer_pool_;
         struct rte_ring* upstream_ring_;
         std::vector<struct rte_ring*> downstream_rings_;
         std::vector<struct rte_ring*> python_access_rings_;
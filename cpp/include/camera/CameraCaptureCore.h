@@ -10,6 +10,7 @@ using namespace log4cxx::helpers;
 
 
 #include "DpdkWorkerCore.h"
+#include "DownstreamDistributor.h"
 #include "DpdkSharedBuffer.h"
 #include "DpdkCoreConfiguration.h"
 #include "camera/CameraCaptureCoreConfiguration.h"
@@ -44,6 +45,7 @@ namespace FrameProcessor
         int proc_idx_;
         ProtocolDecoder* decoder_;
         DpdkSharedBuffer* shared_buf_;
+        DpdkBufferPool* buffer_pool_;
 
         CameraCaptureCoreConfiguration config_;
         LoggerPtr logger_;
@@ -54,8 +56,7 @@ namespace FrameProcessor
         bool in_capture_;
 
 
-        struct rte_ring* clear_frames_ring_;
-        std::vector<struct rte_ring*> downstream_rings_;
+        DownstreamDistributor downstream_;
     };
 }
 #endif // INCLUDE_cameraCAPTURECORE_H_
\ No newline at end of file
@@ -24,7 +24,8 @@ namespace FrameProcessor
             CameraCaptureCoreConfiguration() :
                 ParamContainer(),
                 frame_timeout_(Defaults::default_frame_timeout),
-                camera_class_name_(Defaults::default_camera_class_name)
+                camera_class_name_(Defaults::default_camera_class_name),
+                distribution_(Defaults::default_distribution)
             {
                 bind_params();
             }
@@ -49,6 +50,7 @@ namespace FrameProcessor
                 bind_param<std::string>(upstream_core, "upstream_core");
                 bind_param<unsigned int>(num_cores, "num_cores");
                 bind_param<unsigned int>(num_downstream_cores, "num_downstream_cores");
+                bind_param<std::string>(distribution_, "distribution");
                 bind_param<unsigned int>(frame_timeout_, "frame_timeout");
                 bind_param<std::string>(camera_class_name_, "camera_name");
 
@@ -62,6 +64,7 @@ namespace FrameProcessor
             // Specfic config
             unsigned int frame_timeout_;
             std::string camera_class_name_;
+            std::string distribution_;  //!< Policy for distributing frames to downstream cores
 
             friend class CameraCaptureCore;
     };
@@ -38,7 +38,13 @@ namespace FrameProcessor
         bool connect(void);
         void configure(OdinData::IpcMessage& config);
 
+        bool supports_service(void) const { return true; }
+        bool service_start(unsigned int lcore_id);
+        int32_t service_poll(void);
+
     private:
+        void bind_channel(void);
+        void handle_ctrl_request(void);
 
         int proc_idx_;
         ProtocolDecoder* decoder_;
@@ -52,7 +58,6 @@ namespace FrameProcessor
         
         CameraController* CameraController_;
 
-        struct rte_ring* clear_frames_ring_;
         std::vector<struct rte_ring*> downstream_rings_;
     };
 }
@@ -10,6 +10,7 @@
 #define DPDK_VERSION_COMPATIBILITY_H
 
 #include <rte_common.h>
+#include <rte_version.h>
 
 /*
  * Packed structure compatibility macros
@@ -52,6 +53,12 @@
 #endif
 #endif
 
+#ifndef RTE_ETH_RX_OFFLOAD_BUFFER_SPLIT
+#ifdef DEV_RX_OFFLOAD_BUFFER_SPLIT
+#define RTE_ETH_RX_OFFLOAD_BUFFER_SPLIT DEV_RX_OFFLOAD_BUFFER_SPLIT
+#endif
+#endif
+
 #ifndef RTE_ICMP_TYPE_ECHO_REQUEST
 #define RTE_ICMP_TYPE_ECHO_REQUEST 8
 #endif
@@ -60,4 +67,31 @@
 #define RTE_ICMP_TYPE_ECHO_REPLY 0
 #endif
 
+/*
+ * IP fragmentation compatibility
+ *
+ * DPDK 22.03 added the RTE_ prefix to the IP fragmentation death row sizes. Expired entries can
+ * only be removed from a reassembly table with the stable API from DPDK 22.11, before which
+ * they are reclaimed when their table slot is reused.
+ */
+#ifndef RTE_IP_FRAG_DEATH_ROW_MBUF_LEN
+#ifdef IP_FRAG_DEATH_ROW_MBUF_LEN
+#define RTE_IP_FRAG_DEATH_ROW_MBUF_LEN IP_FRAG_DEATH_ROW_MBUF_LEN
+#endif
+#endif
+
+#if RTE_VERSION >= RTE_VERSION_NUM(22, 11, 0, 0)
+#define DPDK_IP_FRAG_DEL_EXPIRED_ENTRIES
+#endif
+
+/*
+ * Telemetry unsigned value compatibility
+ *
+ * DPDK 23.03 replaced rte_tel_data_add_dict_u64() with rte_tel_data_add_dict_uint(), and
+ * deprecated the old name. Map the new name onto the old one for older DPDK versions.
+ */
+#if RTE_VERSION < RTE_VERSION_NUM(23, 3, 0, 0)
+#define rte_tel_data_add_dict_uint rte_tel_data_add_dict_u64
+#endif
+
 #endif /* DPDK_VERSION_COMPATIBILITY_H */
@@ -1,6 +1,8 @@
 #ifndef DPDKDEVICECONFIGURATION_H_
 #define DPDKDEVICECONFIGURATION_H_
 
+#include <string>
+
 #include "ParamContainer.h"
 
 namespace FrameProcessor
@@ -14,6 +16,10 @@ namespace FrameProcessor
         const uint16_t default_rx_num_desc = 16384;
         const uint16_t default_tx_rings = 1;
         const uint16_t default_tx_num_desc = 8192;
+        const std::string default_rx_steering = "none";
+        const uint16_t default_steering_field_offset = 7;
+        const bool default_rx_buffer_split = false;
+        const bool default_rx_single_segment = false;
     }
 
     class DpdkDeviceConfiguration : public OdinData::ParamContainer
@@ -28,7 +34,11 @@ namespace FrameProcessor
                 rx_rings_(Defaults::default_rx_rings),
                 rx_num_desc_(Defaults::default_rx_num_desc),
                 tx_rings_(Defaults::default_tx_rings),
-                tx_num_desc_(Defaults::default_tx_num_desc)
+                tx_num_desc_(Defaults::default_tx_num_desc),
+                rx_steering_(Defaults::default_rx_steering),
+                steering_field_offset_(Defaults::default_steering_field_offset),
+                rx_buffer_split_(Defaults::default_rx_buffer_split),
+                rx_single_segment_(Defaults::default_rx_single_segment)
             {
                 bind_params();
             }
@@ -40,6 +50,10 @@ namespace FrameProcessor
             uint16_t rx_num_desc(void) const { return rx_num_desc_; }
             uint16_t tx_rings(void) const { return tx_rings_; }
             uint16_t tx_num_desc(void) const { return tx_num_desc_; }
+            const std::string& rx_steering(void) const { return rx_steering_; }
+            uint16_t steering_field_offset(void) const { return steering_field_offset_; }
+            bool rx_buffer_split(void) const { return rx_buffer_split_; }
+            bool rx_single_segment(void) const { return rx_single_segment_; }
 
         private:
 
@@ -52,6 +66,10 @@ namespace FrameProcessor
                 bind_param<uint16_t>(rx_num_desc_, "rx_num_desc");
                 bind_param<uint16_t>(tx_rings_, "tx_rings");
                 bind_param<uint16_t>(tx_num_desc_, "tx_num_desc");
+                bind_param<std::string>(rx_steering_, "rx_steering");
+                bind_param<uint16_t>(steering_field_offset_, "steering_field_offset");
+                bind_param<bool>(rx_buffer_split_, "rx_buffer_split");
+                bind_param<bool>(rx_single_segment_, "rx_single_segment");
             }
 
             unsigned int mbuf_pool_size_;   //!< Size of the mbuf pool
@@ -61,6 +79,10 @@ namespace FrameProcessor
             uint16_t rx_num_desc_;          //!< Number of RX ring descriptors
             uint16_t tx_rings_;             //!< Number of TX rings
             uint16_t tx_num_desc_;          //!< Number of TX ring descriptors
+            std::string rx_steering_;       //!< RX queue steering mode (none, rss, flow_udp_port, flow_frame_number)
+            uint16_t steering_field_offset_; //!< Offset in UDP payload of frame number steering byte
+            bool rx_buffer_split_;          //!< Split packet headers and payloads on receive
+            bool rx_single_segment_;        //!< Size mbufs from the MTU to receive unscattered
     };
 }
 
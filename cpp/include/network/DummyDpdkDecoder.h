@@ -35,7 +35,7 @@ struct __rte_packed_begin X10GRawFrameHeader : RawFrameHeader
 	uint64_t frame_complete_time;
 	uint32_t frame_time_delta;
     uint64_t image_size;
-    uint8_t packet_state[1];  // One for each packet in the frame
+    uint8_t packet_state[sizeof(uint64_t)];  // Bitmap with one bit for each packet in the frame
 } __rte_packed_end;
 
 namespace Defaults
@@ -44,7 +44,7 @@ namespace Defaults
     const std::size_t default_payload_size = PACKET_PAYLOAD_SIZE;
 }
 
-class DummyDpdkDecoder : public PacketProtocolDecoder
+class DummyDpdkDecoder final : public PacketProtocolDecoder
 {
 
 public:
@@ -64,21 +64,27 @@ public:
     {
         std::size_t packet_marker_size = sizeof(X10GRawFrameHeader().packet_state);
         std::size_t packet_header_size = sizeof(X10GRawFrameHeader) +
-            (packet_marker_size * packets_per_frame_ - 1);
+            (packet_marker_size * (get_packet_state_words() - 1));
 
         return packet_header_size;
     }
 
+    // Packet layout is fixed at compile time, allowing the offsets to be folded into the
+    // packet loop of cores specialised for this decoder
+    static constexpr std::size_t packet_header_size = sizeof(X10GPacketHeader);
+
+    // Headers are always before payload in dummy decoder
+    static constexpr std::size_t packet_payload_offset = sizeof(struct rte_ether_hdr) +
+        sizeof(struct rte_ipv4_hdr) + sizeof(struct rte_udp_hdr) + packet_header_size;
+
     virtual const std::size_t get_packet_header_size(void) const
     {
-        return sizeof(X10GPacketHeader);
+        return packet_header_size;
     }
 
     virtual const std::size_t get_packet_payload_offset(void) const
     {
-        // Headers are always before payload in dummy decoder
-        return sizeof(struct rte_ether_hdr) + sizeof(struct rte_ipv4_hdr) + 
-                sizeof(struct rte_udp_hdr) + get_packet_header_size();
+        return packet_payload_offset;
     }
 
     void set_frame_number(RawFrameHeader* frame_hdr, uint64_t frame_number)
@@ -132,7 +138,7 @@ public:
         else
         {
             X10GRawFrameHeader* x10g_hdr = reinterpret_cast<X10GRawFrameHeader *>(frame_hdr);
-            x10g_hdr->packet_state[packet_number] = 1;
+            set_packet_state_bit(x10g_hdr->packet_state, packet_number);
             x10g_hdr->packets_received++;
 
             return true;
@@ -150,9 +156,9 @@ public:
             (reinterpret_cast<X10GRawFrameHeader *>(frame_hdr))->packets_received;
     }
 
-    const uint8_t get_packet_state(RawFrameHeader* frame_hdr, uint32_t packet_number) const
+    uint8_t* get_packet_state_bitmap(RawFrameHeader* frame_hdr) const
     {
-        return (reinterpret_cast<X10GRawFrameHeader *>(frame_hdr))->packet_state[packet_number];
+        return (reinterpret_cast<X10GRawFrameHeader *>(frame_hdr))->packet_state;
     }
 
     const uint64_t get_frame_number(PacketHeader* packet_hdr) const
@@ -0,0 +1,150 @@
+/*
+ * FrameReleasePolicy.h - the policy a packet processor uses to release partially received frames.
+ *
+ * A packet processor always releases a super frame as soon as all of its packets are received.
+ * The release policy decides what happens to a frame still missing packets:
+ *
+ *   complete     - the frame is only released once complete, or when its window slot is needed
+ *                  for a newer frame. Frame timeouts are not applied.
+ *   timeout      - the frame is released incomplete at its timeout. This is the default.
+ *   percentage   - when a frame a set number of frames newer starts, the frame is released
+ *                  early if at least a set percentage of its packets have been received, and
+ *                  otherwise at its timeout.
+ *   sequence_gap - when a frame a set number of frames newer starts, the frame is released
+ *                  early however many of its packets have been received.
+ *
+ * The policies that release frames early assume packets for older frames are not received
+ * after newer frames start, so any later packets for a frame released early are dropped rather
+ * than starting a new frame. Frame numbers here are the super frame numbers seen by one core,
+ * which advance by the stride of the number of packet processor cores.
+ */
+
+#ifndef INCLUDE_FRAMERELEASEPOLICY_H_
+#define INCLUDE_FRAMERELEASEPOLICY_H_
+
+#include <cstdint>
+#include <string>
+
+namespace FrameProcessor
+{
+    class FrameReleasePolicy
+    {
+    public:
+
+        //! Release policies for partially received frames
+        enum Policy
+        {
+            complete_only,  //!< Release complete frames only
+            timeout,        //!< Release incomplete frames at their timeout
+            percentage,     //!< Release frames early once a percentage complete
+            sequence_gap,   //!< Release frames early once a sequence gap behind
+            num_policies
+        };
+
+        //! Constructor for the FrameReleasePolicy class.
+        //!
+        //! \param[in] policy - release policy
+        //! \param[in] min_complete_percent - percentage of packets for the percentage policy
+        //! \param[in] lookahead - number of frames newer that triggers an early release
+        //! \param[in] stride - difference between consecutive frame numbers seen by this core
+        //!
+        FrameReleasePolicy(
+            Policy policy, unsigned int min_complete_percent, unsigned int lookahead,
+            unsigned int stride
+        ) :
+            policy_(policy),
+            min_complete_percent_(min_complete_percent < 100 ? min_complete_percent : 100),
+            lookahead_frames_(
+                static_cast<uint64_t>(lookahead > 0 ? lookahead : 1) * (stride > 0 ? stride : 1)
+            )
+        {
+        }
+
+        //! Parse the name of a release policy
+        //!
+        //! \param[in] name - name of the policy
+        //! \param[out] policy - policy named
+        //!
+        //! \return true if the name is a valid policy name
+        //!
+        static bool parse(const std::string& name, Policy& policy)
+        {
+            for (unsigned int idx = 0; idx < num_policies; idx++)
+            {
+                if (name == policy_name(static_cast<Policy>(idx)))
+                {
+                    policy = static_cast<Policy>(idx);
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        //! Get the name of a release policy
+        //!
+        //! \param[in] policy - release policy
+        //!
+        //! \return the name of the policy, as used in the configuration and status
+        //!
+        static const char* policy_name(Policy policy)
+        {
+            static const char* names[num_policies] = {
+                "complete", "timeout", "percentage", "sequence_gap"
+            };
+            return (policy < num_policies) ? names[policy] : "unknown";
+        }
+
+        //! Get the release policy
+        inline Policy policy(void) const { return policy_; }
+
+        //! Check if incomplete frames are released at their timeout
+        inline bool timeouts(void) const { return policy_ != complete_only; }
+
+        //! Check if the policy releases frames early
+        inline bool early(void) const { return policy_ >= percentage; }
+
+        //! Get the frame to check for early release when a frame starts
+        //!
+        //! \param[in] started_frame_number - number of the frame started
+        //! \param[out] candidate_frame_number - number of the frame to check
+        //!
+        //! \return true if there is a frame to check
+        //!
+        inline bool candidate(uint64_t started_frame_number, uint64_t& candidate_frame_number) const
+        {
+            if (!early() || (started_frame_number < lookahead_frames_))
+            {
+                return false;
+            }
+            candidate_frame_number = started_frame_number - lookahead_frames_;
+            return true;
+        }
+
+        //! Check if a candidate frame should be released early
+        //!
+        //! \param[in] packets_received - number of packets received for the frame
+        //! \param[in] packets_expected - number of packets in a complete frame
+        //!
+        //! \return true if the frame should be released
+        //!
+        inline bool release(uint64_t packets_received, uint64_t packets_expected) const
+        {
+            if (policy_ == sequence_gap)
+            {
+                return true;
+            }
+            return (packets_received * 100) >= (packets_expected * min_complete_percent_);
+        }
+
+        //! Check if the percentage of packets received must be counted for release
+        inline bool needs_packet_count(void) const { return policy_ == percentage; }
+
+    private:
+
+        Policy policy_;                     //!< Release policy
+        uint64_t min_complete_percent_;     //!< Percentage of packets for an early release
+        uint64_t lookahead_frames_;         //!< Frame number difference triggering a release
+    };
+}
+
+#endif // INCLUDE_FRAMERELEASEPOLICY_H_
@@ -0,0 +1,259 @@
+/*
+ * FrameTimeoutWheel.h - a hierarchical timer wheel for the timeouts of in-flight super frames.
+ *
+ * Each entry is identified by a small integer ID, the slot of the frame in its SuperFrameWindow,
+ * and scheduled with a deadline in TSC cycles. Deadlines are rounded up to a whole number of
+ * ticks and held in doubly linked lists threaded through a preallocated node array, so that
+ * scheduling and cancelling an entry are constant time with no allocation.
+ *
+ * The inner wheel has a slot for each of the next 256 ticks, and the outer wheel a slot for each
+ * of the next 64 rotations of the inner wheel. Each time the inner wheel completes a rotation the
+ * next outer slot is cascaded down into it. Deadlines further away than the outer wheel covers
+ * are held in its last slot and cascaded again until they fall within range. The wheel is
+ * advanced a bounded number of ticks per call, so an entry expires no earlier than its deadline
+ * and no later than one tick after it, plus any time the caller takes to catch up.
+ */
+
+#ifndef INCLUDE_FRAMETIMEOUTWHEEL_H_
+#define INCLUDE_FRAMETIMEOUTWHEEL_H_
+
+#include <cstdint>
+#include <stdexcept>
+
+#include <rte_malloc.h>
+#include <rte_branch_prediction.h>
+
+namespace FrameProcessor
+{
+    class FrameTimeoutWheel
+    {
+    public:
+
+        //! ID returned when no entry has expired
+        static const uint32_t none = UINT32_MAX;
+
+        //! Constructor for the FrameTimeoutWheel class.
+        //!
+        //! \param[in] capacity - number of entry IDs, from zero
+        //! \param[in] tick_cycles - length of a tick in TSC cycles
+        //! \param[in] now - current TSC cycle count
+        //! \param[in] socket_id - NUMA socket to allocate the nodes on
+        //!
+        FrameTimeoutWheel(uint32_t capacity, uint64_t tick_cycles, uint64_t now, int socket_id) :
+            tick_cycles_(tick_cycles > 0 ? tick_cycles : 1),
+            size_(0)
+        {
+            current_tick_ = now / tick_cycles_;
+            for (unsigned int bucket = 0; bucket < num_buckets; bucket++)
+            {
+                buckets_[bucket] = none;
+            }
+
+            nodes_ = static_cast<Node*>(rte_zmalloc_socket(
+                "frame_timeout_wheel", sizeof(Node) * capacity, RTE_CACHE_LINE_SIZE, socket_id
+            ));
+            if (nodes_ == NULL)
+            {
+                throw std::runtime_error("Failed to allocate frame timeout wheel");
+            }
+            for (uint32_t id = 0; id < capacity; id++)
+            {
+                nodes_[id].bucket = none;
+            }
+        }
+
+        ~FrameTimeoutWheel()
+        {
+            rte_free(nodes_);
+        }
+
+        //! Schedule an entry, replacing any deadline it was already scheduled with
+        //!
+        //! \param[in] id - ID of the entry
+        //! \param[in] deadline - TSC cycle count the entry expires at
+        //!
+        inline void schedule(uint32_t id, uint64_t deadline)
+        {
+            if (nodes_[id].bucket != none)
+            {
+                cancel(id);
+            }
+            nodes_[id].deadline = deadline;
+            nodes_[id].deadline_tick = (deadline + tick_cycles_ - 1) / tick_cycles_;
+            place(id);
+            size_++;
+        }
+
+        //! Cancel a scheduled entry, which has no effect if the entry is not scheduled
+        //!
+        //! \param[in] id - ID of the entry
+        //!
+        inline void cancel(uint32_t id)
+        {
+            if (nodes_[id].bucket != none)
+            {
+                unlink(id);
+                size_--;
+            }
+        }
+
+        //! Advance the wheel and return an expired entry, if any
+        //!
+        //! The wheel is advanced up to the specified number of ticks towards the current time,
+        //! stopping early once an entry has expired. Expired entries are returned one per call.
+        //!
+        //! \param[in] now - current TSC cycle count
+        //! \param[in] max_ticks - maximum number of ticks to advance
+        //!
+        //! \return ID of an expired entry, which is no longer scheduled, or none
+        //!
+        inline uint32_t expire(uint64_t now, unsigned int max_ticks)
+        {
+            uint64_t now_tick = now / tick_cycles_;
+
+            // With nothing scheduled there is nothing to cascade, so jump straight to now
+            if (size_ == 0)
+            {
+                current_tick_ = (now_tick > current_tick_) ? now_tick : current_tick_;
+                return none;
+            }
+
+            for (unsigned int ticks = 0; (buckets_[expired_bucket] == none) &&
+                (ticks < max_ticks) && (current_tick_ < now_tick); ticks++)
+            {
+                advance();
+            }
+
+            uint32_t id = buckets_[expired_bucket];
+            if (id != none)
+            {
+                unlink(id);
+                size_--;
+            }
+            return id;
+        }
+
+        //! Get the deadline an entry was last scheduled with
+        //!
+        //! \param[in] id - ID of the entry
+        //!
+        //! \return TSC cycle count of the deadline
+        //!
+        inline uint64_t deadline(uint32_t id) const { return nodes_[id].deadline; }
+
+        //! Get the number of scheduled entries
+        inline uint64_t size(void) const { return size_; }
+
+        //! Get the length of a tick in TSC cycles
+        inline uint64_t tick_cycles(void) const { return tick_cycles_; }
+
+    private:
+
+        static const unsigned int inner_bits = 8;                   //!< Log2 of inner slots
+        static const unsigned int inner_slots = 1 << inner_bits;    //!< Ticks in the inner wheel
+        static const unsigned int outer_slots = 64;                 //!< Rotations in the outer wheel
+        static const unsigned int outer_bucket = inner_slots;       //!< First outer wheel bucket
+        static const unsigned int expired_bucket = inner_slots + outer_slots;  //!< Expired list
+        static const unsigned int num_buckets = expired_bucket + 1;
+
+        struct Node
+        {
+            uint64_t deadline;          //!< Deadline in TSC cycles
+            uint64_t deadline_tick;     //!< Deadline rounded up to a tick
+            uint32_t next;              //!< Next entry in the bucket
+            uint32_t prev;              //!< Previous entry in the bucket
+            uint32_t bucket;            //!< Bucket holding the entry, none if not scheduled
+        };
+
+        //! Place an entry in the bucket for its deadline
+        inline void place(uint32_t id)
+        {
+            uint64_t tick = nodes_[id].deadline_tick;
+            uint64_t current_rotation = current_tick_ >> inner_bits;
+            uint32_t bucket;
+
+            if (tick <= current_tick_)
+            {
+                bucket = expired_bucket;
+            }
+            else if (tick - current_tick_ < inner_slots)
+            {
+                bucket = tick & (inner_slots - 1);
+            }
+            else if ((tick >> inner_bits) - current_rotation < outer_slots)
+            {
+                bucket = outer_bucket + ((tick >> inner_bits) % outer_slots);
+            }
+            else
+            {
+                bucket = outer_bucket + ((current_rotation + outer_slots - 1) % outer_slots);
+            }
+            link(id, bucket);
+        }
+
+        //! Advance the wheel by one tick, moving the entries due at it to the expired list
+        inline void advance(void)
+        {
+            current_tick_++;
+
+            // At the start of each inner rotation, cascade the next outer slot down
+            if ((current_tick_ & (inner_slots - 1)) == 0)
+            {
+                relink(outer_bucket + ((current_tick_ >> inner_bits) % outer_slots));
+            }
+            relink(current_tick_ & (inner_slots - 1));
+        }
+
+        //! Place every entry in a bucket again for the current tick
+        inline void relink(uint32_t bucket)
+        {
+            uint32_t id = buckets_[bucket];
+            buckets_[bucket] = none;
+            while (id != none)
+            {
+                uint32_t next = nodes_[id].next;
+                place(id);
+                id = next;
+            }
+        }
+
+        inline void link(uint32_t id, uint32_t bucket)
+        {
+            Node& node = nodes_[id];
+            node.bucket = bucket;
+            node.prev = none;
+            node.next = buckets_[bucket];
+            if (node.next != none)
+            {
+                nodes_[node.next].prev = id;
+            }
+            buckets_[bucket] = id;
+        }
+
+        inline void unlink(uint32_t id)
+        {
+            Node& node = nodes_[id];
+            if (node.prev != none)
+            {
+                nodes_[node.prev].next = node.next;
+            }
+            else
+            {
+                buckets_[node.bucket] = node.next;
+            }
+            if (node.next != none)
+            {
+                nodes_[node.next].prev = node.prev;
+            }
+            node.bucket = none;
+        }
+
+        Node* nodes_;                       //!< Preallocated entry nodes, indexed by ID
+        uint64_t tick_cycles_;              //!< Length of a tick in TSC cycles
+        uint64_t current_tick_;             //!< Last tick the wheel was advanced to
+        uint64_t size_;                     //!< Number of scheduled entries
+        uint32_t buckets_[num_buckets];     //!< First entry in each bucket, none if empty
+    };
+}
+
+#endif // INCLUDE_FRAMETIMEOUTWHEEL_H_
@@ -8,6 +8,10 @@ namespace FrameProcessor
     {
         // Place all default values here
         const unsigned int default_frame_timeout = 1000;
+        const unsigned int default_frame_timeout_tick_us = 100;
+        const std::string default_release_policy = "timeout";
+        const unsigned int default_release_min_complete = 90;
+        const unsigned int default_release_lookahead = 1;
     }
 
 
@@ -18,7 +22,11 @@ namespace FrameProcessor
 
             PacketProcessorConfiguration() :
                 ParamContainer(),
-                frame_timeout_(Defaults::default_frame_timeout)
+                frame_timeout_(Defaults::default_frame_timeout),
+                frame_timeout_tick_us_(Defaults::default_frame_timeout_tick_us),
+                release_policy_(Defaults::default_release_policy),
+                release_min_complete_(Defaults::default_release_min_complete),
+                release_lookahead_(Defaults::default_release_lookahead)
             {
                 bind_params();
             }
@@ -45,6 +53,10 @@ namespace FrameProcessor
                 bind_param<unsigned int>(num_cores, "num_cores");
                 bind_param<unsigned int>(num_downstream_cores, "num_downstream_cores");
                 bind_param<unsigned int>(frame_timeout_, "frame_timeout");
+                bind_param<unsigned int>(frame_timeout_tick_us_, "frame_timeout_tick_us");
+                bind_param<std::string>(release_policy_, "release_policy");
+                bind_param<unsigned int>(release_min_complete_, "release_min_complete");
+                bind_param<unsigned int>(release_lookahead_, "release_lookahead");
 
             }
 
@@ -56,9 +68,13 @@ namespace FrameProcessor
             unsigned int num_downstream_cores;
             // Specfic config
             unsigned int frame_timeout_;
+            unsigned int frame_timeout_tick_us_;    //!< Resolution of the frame timeouts in us
+            std::string release_policy_;            //!< Policy for releasing incomplete frames
+            unsigned int release_min_complete_;     //!< Percentage complete for early release
+            unsigned int release_lookahead_;        //!< Newer frames started for early release
 
 
 
-            friend class PacketProcessorCore;
+            template <typename DecoderT> friend class PacketProcessorCoreT;
     };
 }
\ No newline at end of file
@@ -7,24 +7,36 @@
 using namespace log4cxx;
 using namespace log4cxx::helpers;
 #include <DebugLevelLogger.h>
+#include "DpdkTraceLogger.h"
 
 #include "DpdkWorkerCore.h"
+#include "CoreMetrics.h"
+#include "FlightRecorder.h"
 #include "DpdkSharedBuffer.h"
 #include "DpdkCoreConfiguration.h"
 #include "network/PacketProcessorConfiguration.h"
 #include "network/PacketProtocolDecoder.h"
+#include "network/SuperFrameWindow.h"
+#include "network/FrameReleasePolicy.h"
+#include "LatencyHistogram.h"
 #include <rte_ring.h>
 
 
 namespace FrameProcessor
 {
-    class PacketProcessorCore : public DpdkWorkerCore
+    //! Packet processor core, templated on the decoder class used on the per-packet path.
+    //!
+    //! Instantiated with PacketProtocolDecoder, all decoder calls are dispatched virtually and
+    //! the core works with any packet decoder. Instantiated with a concrete final decoder class,
+    //! the decoder calls are resolved at compile time and inlined into the packet loop.
+    template <typename DecoderT>
+    class PacketProcessorCoreT : public DpdkWorkerCore
     {
     public:
-        PacketProcessorCore(
+        PacketProcessorCoreT(
             int proc_idx, int socket_id, DpdkWorkCoreReferences dpdkWorkCoreReferences
         );
-        ~PacketProcessorCore();
+        ~PacketProcessorCoreT();
 
         bool run(unsigned int lcore_id);
         void stop(void);
@@ -34,9 +46,16 @@ namespace FrameProcessor
 
     private:
 
+        //! Maximum number of frame timeout ticks advanced on each polling loop
+        static const unsigned int FRAME_TIMEOUT_TICKS = 4;
+
+        //! Count the packets received for every frame in a super frame
+        uint64_t count_packets_received(SuperFrameHeader* super_frame_buffer);
+
         int proc_idx_;
-        PacketProtocolDecoder* decoder_;
+        DecoderT* decoder_;
         DpdkSharedBuffer* shared_buf_;
+        DpdkBufferPool* buffer_pool_;
 
         PacketProcessorConfiguration config_;
 
@@ -46,32 +65,40 @@ namespace FrameProcessor
         
         int64_t current_frame_;
         
-        uint64_t total_packets_;
-        uint64_t packets_hz_;
-        uint64_t dropped_packets_;
-        uint64_t last_frame_;
-        uint64_t processed_frames_;
-        uint64_t processed_frames_hz_;
-        uint64_t dropped_frames_;
-        uint64_t incomplete_frames_;
-        uint64_t idle_loops_;
-        uint64_t mean_us_on_frame_;
-        uint64_t maximum_us_on_frame_;
-        uint8_t  core_usage_;
-
-
-        uint64_t frame_buffer_size_;
+        CoreMetrics metrics_;                   //!< Frame rate, core usage and timing metrics
+        FlightRecorder recorder_;               //!< Frame flight recorder
+        unsigned int dropped_frames_id_;        //!< Metric ID of the dropped frame counter
+        unsigned int dropped_packets_id_;       //!< Metric ID of the dropped packet counter
+        unsigned int incomplete_frames_id_;     //!< Metric ID of the incomplete frame counter
+        unsigned int evicted_frames_id_;        //!< Metric ID of the evicted frame counter
+        unsigned int late_packets_id_;          //!< Metric ID of the late packet counter
+        unsigned int multi_segment_packets_id_; //!< Metric ID of the multi-segment packet counter
+        unsigned int chained_segments_id_;      //!< Metric ID of the multi-segment mbuf counter
+        unsigned int truncated_packets_id_;     //!< Metric ID of the truncated packet counter
+        unsigned int total_packets_id_;         //!< Metric ID of the packet counter
+        unsigned int frame_buffer_size_id_;     //!< Metric ID of the frame window size gauge
+
+        //! Metric IDs of the counters of frames released by each release policy
+        unsigned int released_frames_ids_[FrameReleasePolicy::num_policies];
+
+        LatencyHistogram first_packet_to_complete_;  //!< Super frame first packet to complete latency
+        LatencyHistogram timeout_lateness_;     //!< Time from a frame timeout to its release
 
         
         int64_t first_frame_number_;
 
+        FrameReleasePolicy::Policy release_policy_;     //!< Policy for releasing incomplete frames
+        int64_t release_horizon_;               //!< Newest frame released early, or -1
+
         bool debug_enabled_;
         bool trace_enabled_;
 
         struct rte_ring* packet_fwd_ring_;
         struct rte_ring* packet_release_ring_;
-        struct rte_ring* clear_frames_ring_;
         std::vector<struct rte_ring*> downstream_rings_;
     };
+
+    //! Packet processor core using virtual dispatch to any packet protocol decoder
+    typedef PacketProcessorCoreT<PacketProtocolDecoder> PacketProcessorCore;
 }
 #endif // INCLUDE_PACKETPROCESSORCORE_H_
\ No newline at end of file
@@ -0,0 +1,787 @@
+#ifndef INCLUDE_PACKETPROCESSORCOREIMPL_H_
+#define INCLUDE_PACKETPROCESSORCOREIMPL_H_
+
+//! Member definitions of the PacketProcessorCoreT template. Included by the translation units
+//! that register a packet processor core for a decoder class with PACKETPROCESSORREGISTER.
+
+#include "network/PacketProcessorCore.h"
+
+#include <algorithm>
+#include <iostream>
+
+#include <rte_ether.h>
+#include <rte_ip.h>
+#include <rte_udp.h>
+#include <rte_malloc.h>
+#include <rte_prefetch.h>
+#include "DpdkUtils.h"
+
+#define PACKETPROCESSORREGISTER(Class, Decoder, Name) FrameProcessor::DpdkCoreLoader<FrameProcessor::DpdkWorkerCore> cl##Class(Name, FrameProcessor::packet_processor_maker<Decoder>);
+
+namespace FrameProcessor
+{
+    //! Create a packet processor core for the decoder class DecoderT.
+    //!
+    //! A core specialised for a concrete decoder can only be used with that decoder. If the
+    //! plugin's decoder is of another class, the error is logged and an empty pointer returned,
+    //! leaving the core unregistered.
+    //!
+    //! \param[in] core_idx - index of the core
+    //! \param[in] socket_id - NUMA socket of the core
+    //! \param[in] dpdkWorkCoreReferences - references to the decoder, buffers and configuration
+    //! \return shared pointer to the new core, empty if the decoder class does not match
+    template <typename DecoderT>
+    boost::shared_ptr<DpdkWorkerCore> packet_processor_maker(
+        unsigned int core_idx, unsigned int socket_id, DpdkWorkCoreReferences& dpdkWorkCoreReferences
+    )
+    {
+        if (dynamic_cast<DecoderT *>(dpdkWorkCoreReferences.decoder) == NULL)
+        {
+            LOG4CXX_ERROR(Logger::getLogger("FP.PacketProcCore"),
+                "FP.PacketProcCore " << core_idx
+                << " Decoder type does not match the packet processor core class, core not created"
+            );
+            return boost::shared_ptr<DpdkWorkerCore>();
+        }
+        return maker<DpdkWorkerCore, PacketProcessorCoreT<DecoderT> >(
+            core_idx, socket_id, dpdkWorkCoreReferences
+        );
+    }
+
+    template <typename DecoderT>
+    PacketProcessorCoreT<DecoderT>::PacketProcessorCoreT(
+        int proc_idx, int socket_id, DpdkWorkCoreReferences dpdkWorkCoreReferences
+    ) :
+        DpdkWorkerCore(socket_id),
+        proc_idx_(proc_idx),
+        decoder_(dynamic_cast<DecoderT *>(dpdkWorkCoreReferences.decoder)),
+        shared_buf_(dpdkWorkCoreReferences.shared_buf),
+        buffer_pool_(dpdkWorkCoreReferences.buffer_pool),
+        logger_(Logger::getLogger("FP.PacketProcCore")),
+        current_frame_(-1),
+        metrics_("packetprocessorcore_" + std::to_string(proc_idx)),
+        recorder_(metrics_.name(), socket_id),
+        dropped_frames_id_(metrics_.add_counter("dropped_frames")),
+        dropped_packets_id_(metrics_.add_counter("dropped_packets")),
+        incomplete_frames_id_(metrics_.add_counter("frames_incomplete")),
+        evicted_frames_id_(metrics_.add_counter("release/evicted")),
+        late_packets_id_(metrics_.add_counter("release/late_packets")),
+        multi_segment_packets_id_(metrics_.add_counter("segments/multi_segment_packets")),
+        chained_segments_id_(metrics_.add_counter("segments/chained_segments")),
+        truncated_packets_id_(metrics_.add_counter("segments/truncated_packets")),
+        total_packets_id_(metrics_.add_counter("packets_total")),
+        frame_buffer_size_id_(metrics_.add_gauge("frame_buffer_size")),
+        first_frame_number_(-1),
+        release_policy_(FrameReleasePolicy::timeout),
+        release_horizon_(-1)
+    {
+
+        // Resolve configuration parameters for this core from the config object passed as an
+        // argument, and the current port ID
+        config_.resolve(dpdkWorkCoreReferences.core_config);
+
+        // Determine debug level for performance-critical logging
+        debug_enabled_ = false;
+        trace_enabled_ = false;
+
+        LOG4CXX_INFO(logger_, "FP.PacketProcCore " << proc_idx_ << " Created with config:"
+            << " | core_name" << config_.core_name
+            << " | num_cores: " << config_.num_cores
+            << " | connect: " << config_.connect
+            << " | upstream_core: " << config_.upstream_core
+            << " | num_downsteam_cores: " << config_.num_downstream_cores
+            << " | release_policy: " << config_.release_policy_
+        );
+
+        // Resolve the policy for releasing incomplete frames, and count the frames released
+        // under each policy
+        if (!FrameReleasePolicy::parse(config_.release_policy_, release_policy_))
+        {
+            LOG4CXX_ERROR(logger_, "Unknown frame release policy " << config_.release_policy_
+                << ", using " << FrameReleasePolicy::policy_name(release_policy_)
+            );
+        }
+        for (unsigned int policy = 0; policy < FrameReleasePolicy::num_policies; policy++)
+        {
+            released_frames_ids_[policy] = metrics_.add_counter(std::string("release/") +
+                FrameReleasePolicy::policy_name(static_cast<FrameReleasePolicy::Policy>(policy))
+            );
+        }
+
+        // Check if the downstream ring have already been created by another processing core,
+        // otherwise create it with the ring size rounded up to the next power of two
+        for (int ring_idx = 0; ring_idx < config_.num_downstream_cores; ring_idx++)
+        {
+            std::string downstream_ring_name = ring_name_str(config_.core_name, socket_id_, ring_idx);
+            struct rte_ring* downstream_ring = rte_ring_lookup(downstream_ring_name.c_str());
+            if (downstream_ring == NULL)
+            {
+                unsigned int downstream_ring_size = nearest_power_two(shared_buf_->get_num_buffers()*8);
+                LOG4CXX_INFO(logger_, "Creating ring name "
+                    << downstream_ring_name << " of size " << downstream_ring_size << " numa node: " << socket_id_
+                );
+                downstream_ring = rte_ring_create(
+                    downstream_ring_name.c_str(), downstream_ring_size, socket_id_, RING_F_SC_DEQ
+                );
+                if (downstream_ring == NULL)
+                {
+                    LOG4CXX_ERROR(logger_, "Error creating downstream ring " << downstream_ring_name
+                        << " : " << rte_strerror(rte_errno)
+                    );
+                    // TODO - this is fatal and should raise an exception
+                }
+            }
+            else
+            {
+                if (unlikely(debug_enabled_))
+                {
+                    LOG4CXX_DEBUG_LEVEL(2, logger_, "downstream ring with name "
+                        << downstream_ring_name << " has already been created"
+                    );
+                }
+            }
+            if (downstream_ring)
+            {
+                downstream_rings_.push_back(downstream_ring);
+            }
+
+        }
+
+        // Report the frame assembly latency with the core metrics
+        metrics_.add_histogram("timing/latency/first_packet_to_complete", &first_packet_to_complete_);
+        metrics_.add_histogram("timing/latency/frame_timeout_lateness", &timeout_lateness_);
+    }
+
+    template <typename DecoderT>
+    PacketProcessorCoreT<DecoderT>::~PacketProcessorCoreT()
+    {
+        if (unlikely(debug_enabled_))
+        {
+            LOG4CXX_DEBUG_LEVEL(2, logger_, "PacketProcessorCore destructor");
+        }
+
+        // Stop the core polling loop so the run method terminates
+        stop();
+    }
+
+    template <typename DecoderT>
+    bool PacketProcessorCoreT<DecoderT>::run(unsigned int lcore_id)
+    {
+
+        lcore_id_ = lcore_id;
+        run_lcore_ = true;
+
+        LOG4CXX_INFO(logger_, "Core " << lcore_id_ << " starting up");
+
+        // Track in-flight super frames in a window sized to hold every shared buffer, indexed by
+        // super frame number over the stride between the frames distributed to this core, with
+        // the timeout of each frame resolved to the configured tick
+        uint64_t frame_timeout_cycles = convert_ms_to_cycles(config_.frame_timeout_);
+        uint64_t frame_timeout_tick_cycles = std::max<uint64_t>(
+            (rte_get_tsc_hz() * config_.frame_timeout_tick_us_) / 1000000, 1
+        );
+        SuperFrameWindow frame_window(
+            shared_buf_->get_num_buffers(), config_.num_cores, socket_id_,
+            frame_timeout_cycles, frame_timeout_tick_cycles
+        );
+        SuperFrameHeader* retired_frame_buffer;
+
+        uint64_t frame_outer_chunk_size = decoder_->get_frame_outer_chunk_size();
+
+        // Release incomplete frames early, at their timeout or only once complete, as configured
+        FrameReleasePolicy release_policy(
+            release_policy_, config_.release_min_complete_, config_.release_lookahead_,
+            config_.num_cores
+        );
+
+        // Set up structs needed for the various layers of packets
+        struct RawFrameHeader *current_frame_header_;
+        struct SuperFrameHeader *current_super_frame_buffer_;
+        struct SuperFrameHeader *dropped_frame_buffer_;
+        
+        // Batch dequeue optimization - define burst size and packet array
+        constexpr uint32_t MAX_BURST_SIZE = 128;  // Process up to 32 packets at once
+        struct rte_mbuf* pkt_burst[MAX_BURST_SIZE];
+        struct rte_mbuf* pkt;
+        
+        struct rte_ether_hdr *pkt_ether_hdr;
+        struct rte_udp_hdr *pkt_udp_hdr;
+        PacketHeader* pkt_header;
+        uint8_t *pkt_payload;
+        
+
+        // Cache offsets for packet header and payload
+        const std::size_t super_frame_header_size = decoder_->get_super_frame_header_size();
+        const std::size_t frame_header_size = decoder_->get_frame_header_size();
+        const std::size_t udp_hdr_offset = sizeof(struct rte_ether_hdr) + 
+                                          sizeof(struct rte_ipv4_hdr);
+        const std::size_t pkt_hdr_offset = udp_hdr_offset + sizeof(struct rte_udp_hdr);
+        const std::size_t pkt_payload_offset = decoder_->get_packet_payload_offset();
+        
+        // Variable set from the decoder based on packet size
+        const std::size_t payload_size = decoder_->get_payload_size();
+        const std::size_t packets_per_frame = decoder_->get_packets_per_frame();
+        const uint64_t packets_per_super_frame = packets_per_frame * frame_outer_chunk_size;
+        uint64_t superframe_const = (decoder_->get_packets_per_frame() / frame_outer_chunk_size);
+
+        // Status reporting variables
+        uint64_t start_frame_cycles = 1;
+
+        // malloc a memory location for this core to use as it's dropped frame buffer
+        dropped_frame_buffer_ = 
+            reinterpret_cast<SuperFrameHeader *>(rte_malloc(NULL, decoder_->get_frame_buffer_size(), 0));
+
+        metrics_.start();
+        recorder_.start();
+
+        while (likely(run_lcore_))
+        {
+            rte_prefetch0(packet_fwd_ring_); 
+            
+            // Batch dequeue - get multiple packets from the forwarding ring
+            uint32_t nb_rx = rte_ring_dequeue_burst(packet_fwd_ring_, 
+                                                    (void **)pkt_burst, 
+                                                    MAX_BURST_SIZE, 
+                                                    NULL);
+
+            // Process the burst of packets if any were dequeued
+            if (likely(nb_rx > 0))
+            {
+                metrics_.begin_work();
+                start_frame_cycles = rte_get_tsc_cycles();
+                metrics_.add(total_packets_id_, nb_rx);
+                
+                // Process each packet in the burst
+                for (uint32_t i = 0; i < nb_rx; i++)
+                {
+                    pkt = pkt_burst[i];
+                    
+                    // Prefetch next packet for better cache utilization
+                    if (i + 1 < nb_rx)
+                    {
+                        rte_prefetch0(rte_pktmbuf_mtod(pkt_burst[i + 1], void *));
+                    }
+                    
+                    // Get pointers to the ethernet, UDP and packet headers, which are always
+                    // held in the first segment
+                    pkt_ether_hdr = rte_pktmbuf_mtod(pkt, rte_ether_hdr *);
+                    pkt_udp_hdr = (struct rte_udp_hdr *)((uint8_t *)pkt_ether_hdr + udp_hdr_offset);
+                    pkt_header = (PacketHeader *)((uint8_t *)pkt_ether_hdr + pkt_hdr_offset);
+
+                    // Get any frame/packet specific fields required for processing
+                    uint16_t rx_port = rte_bswap16(pkt_udp_hdr->dst_port);
+
+                    // This statement allows the code to reset the "starting" frame number in code
+                    // When first_frame_number_ is set to -1 the next first packet of a frame will be use
+                    // to create a variable to offset the frame number by, allow for frames to be
+                    // distributed as it the first frame has a frame number of 0
+
+                    if(unlikely(first_frame_number_ == -1))
+                    {
+                        first_frame_number_ = decoder_->get_frame_number(pkt_header) - (proc_idx_ * decoder_->get_frame_outer_chunk_size());
+                        release_horizon_ = -1;
+
+                        // LOG4CXX_INFO(logger_, config_.core_name << " : " << proc_idx_ << " Updated frame latch to: " << first_frame_number_ 
+                        //     << " Frame number will be: " << (decoder_->get_frame_number(pkt_header) - first_frame_number_) / frame_outer_chunk_size);
+                    }
+
+                    uint64_t current_frame_number = decoder_->get_frame_number(pkt_header) - first_frame_number_;
+
+                    uint64_t current_super_frame_number = (current_frame_number / frame_outer_chunk_size);
+
+                    uint64_t current_frame_index = current_frame_number - (current_super_frame_number * decoder_->get_frame_outer_chunk_size());
+
+
+                    // LOG4CXX_DEBUG_LEVEL(2, logger_, "Core " << lcore_id_
+                    //             << " current_frame_number: " << current_frame_number
+                    //             << " current_super_frame_number: " << current_super_frame_number
+                    //             << " current_frame_index: " << current_frame_index
+                    //             );
+
+                    // Get the packet offset for the super frame
+                    
+                    uint32_t packet_offset = decoder_->get_packet_number(pkt_header) + ((current_frame_number % frame_outer_chunk_size) * superframe_const);
+
+                    uint32_t packet_number = decoder_->get_packet_number(pkt_header);
+
+                    // Check if the packet frame number matches the frame currently being captured
+                    if (unlikely(current_frame_ != current_super_frame_number))
+                    {
+
+                        // If the packet frame number does not match the current frame, search the
+                        // frame window to see if it is currently being processed
+                        SuperFrameHeader* window_frame_buffer = frame_window.find(current_super_frame_number);
+
+                        // If a valid frame reference is found, swap to that frame
+                        if (window_frame_buffer != NULL)
+                        {
+                            current_super_frame_buffer_ = window_frame_buffer;
+                            // current_frame_ = current_frame_buffer_->current_frame_number;
+                            current_frame_ = decoder_->get_super_frame_number(current_super_frame_buffer_);
+                        }
+                        else if (unlikely(static_cast<int64_t>(current_super_frame_number) <= release_horizon_))
+                        {
+                            // The frame has already been released early, so drop the late packet
+                            // rather than starting the frame again
+                            metrics_.add(late_packets_id_, 1);
+                            continue;
+                        }
+                        else
+                        {
+                            // If a valid frame reference is not found for this packet, then obtain
+                            // and map a new buffer for it
+                            current_frame_ = current_super_frame_number;
+
+                            LOG4CXX_TRACE_LEVEL(1, logger_, "Starting histogram: " << current_frame_number);
+
+                            current_super_frame_buffer_ =
+                                static_cast<SuperFrameHeader*>(buffer_pool_->acquire());
+                            if (unlikely(current_super_frame_buffer_ == NULL))
+                            {
+                                current_super_frame_buffer_ = dropped_frame_buffer_;
+                                metrics_.add(dropped_frames_id_, 1);
+                                recorder_.record_loss(
+                                    current_super_frame_number, FlightRecorder::process,
+                                    FlightRecorder::dropped
+                                );
+                                LOG4CXX_WARN(logger_, "Using dropped_frame_buffer_");
+                            }
+                            else
+                            {
+                                LOG4CXX_TRACE_LEVEL(2, logger_, "Dequeued buffer at: " << (void*)current_super_frame_buffer_ 
+                                    << " frame_buffer_size: " << decoder_->get_frame_buffer_size()
+                                    << " buffers available: " << buffer_pool_->get_available());
+                                
+                                uint64_t frame_start_cycles = rte_get_tsc_cycles();
+                                retired_frame_buffer = frame_window.insert(
+                                    current_super_frame_number, current_super_frame_buffer_,
+                                    frame_start_cycles
+                                );
+
+                                // If the window slot still held a frame a whole window older,
+                                // pass it on as incomplete
+                                if (unlikely(retired_frame_buffer != NULL))
+                                {
+                                    uint64_t retired_frame_number =
+                                        decoder_->get_super_frame_number(retired_frame_buffer);
+                                    decoder_->set_super_frame_complete_time(
+                                        retired_frame_buffer, frame_start_cycles
+                                    );
+                                    rte_ring_enqueue(
+                                        downstream_rings_[
+                                            (retired_frame_number / frame_outer_chunk_size) %
+                                            config_.num_downstream_cores
+                                        ], retired_frame_buffer
+                                    );
+                                    metrics_.add(incomplete_frames_id_, 1);
+                                    metrics_.add(evicted_frames_id_, 1);
+                                    recorder_.record(
+                                        retired_frame_number, FlightRecorder::process,
+                                        FlightRecorder::enqueued
+                                    );
+                                    recorder_.record_loss(
+                                        retired_frame_number, FlightRecorder::process,
+                                        FlightRecorder::incomplete
+                                    );
+                                }
+
+                                LOG4CXX_TRACE_LEVEL(2, logger_, "Resetting headers of current_super_frame_buffer_ at buffer location " << (void*)current_super_frame_buffer_ << " size " << decoder_->get_image_data_offset());
+
+                                // Zero out the frame headers to clear old data, image data is
+                                // overwritten by received packets
+                                decoder_->reset_super_frame(current_super_frame_buffer_);
+
+                                LOG4CXX_TRACE_LEVEL(2, logger_, "Setting super frame number and start time");
+
+                                // Set the frame number and start time in the header
+                                decoder_->set_super_frame_number(current_super_frame_buffer_, current_super_frame_number);
+                                decoder_->set_super_frame_start_time(
+                                    current_super_frame_buffer_, frame_start_cycles
+                                );
+                                recorder_.record(
+                                    current_super_frame_number, FlightRecorder::process,
+                                    FlightRecorder::begin
+                                );
+
+                                // Starting a newer frame may trigger the early release of an
+                                // older incomplete one
+                                uint64_t candidate_frame_number;
+                                if (release_policy.candidate(
+                                        current_super_frame_number, candidate_frame_number))
+                                {
+                                    SuperFrameHeader* candidate_frame_buffer =
+                                        frame_window.find(candidate_frame_number);
+                                    if ((candidate_frame_buffer != NULL) && release_policy.release(
+                                            release_policy.needs_packet_count() ?
+                                                count_packets_received(candidate_frame_buffer) : 0,
+                                            packets_per_super_frame))
+                                    {
+                                        frame_window.erase(candidate_frame_number);
+                                        release_horizon_ = std::max<int64_t>(
+                                            release_horizon_, candidate_frame_number
+                                        );
+                                        decoder_->set_super_frame_complete_time(
+                                            candidate_frame_buffer, frame_start_cycles
+                                        );
+                                        rte_ring_enqueue(
+                                            downstream_rings_[
+                                                (candidate_frame_number / frame_outer_chunk_size) %
+                                                config_.num_downstream_cores
+                                            ], candidate_frame_buffer
+                                        );
+                                        metrics_.add(incomplete_frames_id_, 1);
+                                        metrics_.add(
+                                            released_frames_ids_[release_policy.policy()], 1
+                                        );
+                                        recorder_.record(
+                                            candidate_frame_number, FlightRecorder::process,
+                                            FlightRecorder::enqueued
+                                        );
+                                        recorder_.record(
+                                            candidate_frame_number, FlightRecorder::process,
+                                            FlightRecorder::incomplete
+                                        );
+                                    }
+                                }
+
+                                LOG4CXX_TRACE_LEVEL(2, logger_, "Finish setting super frame number and start time");
+                            }
+                        }
+                    }
+
+                    // calculating packet offset
+
+                    uint64_t packet_memory_offset = (current_frame_index * payload_size * packets_per_frame) + (packet_number * payload_size);
+
+                    current_frame_header_ = decoder_->get_frame_header(current_super_frame_buffer_, current_frame_index);
+
+                    // if (decoder_->get_packets_received(current_frame_header_) > 6399)
+                    // {
+                    //LOG4CXX_INFO(logger_, "Copying packet " << packet_number << " From frame: " << current_frame_number << " into memory at: " << packet_memory_offset);
+                    // }
+
+                    // Copy the packet payload into the appropriate location in the frame buffer
+                    char* payload_dest = decoder_->get_image_data_start(current_super_frame_buffer_) +
+                        (current_frame_index * payload_size * packets_per_frame) +
+                        (packet_number * payload_size);
+
+                    if (likely(pkt->nb_segs == 1))
+                    {
+                        pkt_payload = (uint8_t *)pkt_ether_hdr + pkt_payload_offset;
+                        rte_memcpy(payload_dest, pkt_payload, payload_size);
+                    }
+                    else
+                    {
+                        // The packet was scattered across a chain of mbufs on receive, or split
+                        // into header and payload mbufs, so gather the payload from the chain.
+                        // A payload held in a single segment is returned in place and copied,
+                        // otherwise it is gathered straight into the frame buffer
+                        metrics_.add(multi_segment_packets_id_, 1);
+                        metrics_.add(chained_segments_id_, pkt->nb_segs);
+
+                        const void* segment_payload = rte_pktmbuf_read(
+                            pkt, pkt_payload_offset, payload_size, payload_dest
+                        );
+                        if (unlikely(segment_payload == NULL))
+                        {
+                            // The packet is shorter than the payload, so is not marked received
+                            metrics_.add(truncated_packets_id_, 1);
+                            continue;
+                        }
+                        if (segment_payload != payload_dest)
+                        {
+                            rte_memcpy(payload_dest, segment_payload, payload_size);
+                        }
+                    }
+
+                    // LOG4CXX_TRACE(logger_,"Setting packet "<< packet_number << " as finished for frame " << current_frame_number);
+                    // // Set the current packet as received in the frame header
+                    if (decoder_->set_packet_received(current_frame_header_, packet_number))
+                    {
+                        // LOG4CXX_TRACE(logger_,"Checking frame " << current_frame_number << " with " << decoder_->get_packets_received(current_frame_header_) << " Packets");
+                        // Check to see if that frames has been completed in the superframe
+                        if(decoder_->get_packets_received(current_frame_header_) == packets_per_frame)
+                        {
+                            // LOG4CXX_DEBUG_LEVEL(2, logger_, "Core " << lcore_id_
+                            //     << " current_frame_number: " << current_frame_number
+                            //     << " current_super_frame_number: " << current_super_frame_number
+                            //     << " current_frame_index: " << current_frame_index
+                            //     << " Got all packets for sub frame"
+                            //     );
+                            
+                            // All packets for this sub-frame have been captured, mark it as complete
+                            if (!decoder_->set_super_frame_frames_received(current_super_frame_buffer_, current_frame_index))
+                            {
+                                // TODO handle illegal frame number here
+                                // LOG4CXX_ERROR(logger_, "Core " << lcore_id_
+                                //             << " Error:  illegal frame number: "
+                                //             << current_frame_number
+                                //         );
+                            }
+                        }
+                    }
+                    else
+                    {
+                        // TODO handle illegal frame number here - maybe too late since already
+                        // copied into buffer based on packet number? Swap order with rte_memcpy call
+                        // above??
+                        // LOG4CXX_ERROR(logger_, "Core " << lcore_id_
+                        //                     << " Error:  illegal frame packet number: "
+                        //                     << packet_number
+                        //                     << " in frame: "
+                        //                     << current_frame_number
+                        //                 );
+                    }
+
+                    // Look to check the SOF & EOF markers
+                    // check to see if the frame is complete
+
+                    if (decoder_->get_super_frame_frames_received(current_super_frame_buffer_) == decoder_->get_frame_outer_chunk_size())
+                    {
+                        // The frame is complete, so enqueue the frame reference for the
+                        // FrameBuilderCore to pick up. Check if the current frame is 'dropped' and
+                        // don't enqueue if that is the case
+
+                        LOG4CXX_TRACE_LEVEL(1, logger_, "Histogram complete: " << current_frame_number);
+
+                        LOG4CXX_TRACE_LEVEL(2, logger_, "Core " << lcore_id_
+                                << " with " << decoder_->get_super_frame_frames_received(current_super_frame_buffer_) << " complete sub frames"
+                                << " with " << decoder_->get_packets_received(current_frame_header_) << " complete Packets"
+                                );
+
+                        if (likely(current_super_frame_buffer_ != dropped_frame_buffer_))
+                        {
+                            // Stamp the completion time and record the frame assembly latency
+                            uint64_t complete_cycles = rte_get_tsc_cycles();
+                            decoder_->set_super_frame_complete_time(
+                                current_super_frame_buffer_, complete_cycles
+                            );
+                            first_packet_to_complete_.record(
+                                complete_cycles -
+                                decoder_->get_super_frame_start_time(current_super_frame_buffer_)
+                            );
+
+                            rte_ring_enqueue(
+                                downstream_rings_[
+                                    (decoder_->get_super_frame_number(current_super_frame_buffer_) / frame_outer_chunk_size) % 
+                                    config_.num_downstream_cores
+                                ], current_super_frame_buffer_
+                            );
+
+                            recorder_.record(
+                                current_frame_, FlightRecorder::process, FlightRecorder::enqueued
+                            );
+                            recorder_.record(
+                                current_frame_, FlightRecorder::process, FlightRecorder::end
+                            );
+
+                            // Remove the frame reference from the frame window
+                            frame_window.erase(current_frame_);
+                            
+                            metrics_.frames(1);
+                            metrics_.add(released_frames_ids_[FrameReleasePolicy::complete_only], 1);
+
+                            // LOG4CXX_DEBUG_LEVEL(2, logger_, config_.core_name << " : " << proc_idx_ << " Capture all packets for frame: " << current_frame_);
+
+                        }
+                        current_frame_ = -1;
+                    }
+                }
+                
+                // Batch enqueue all processed packets to be released
+                rte_ring_enqueue_bulk(packet_release_ring_, (void **)pkt_burst, nb_rx, NULL);
+
+                // Calculate status for the batch
+                metrics_.busy(rte_get_tsc_cycles() - start_frame_cycles);
+            }
+            else
+            {
+                // No packets received, increment idle counter
+                metrics_.idle();
+            }
+
+            uint64_t now = rte_get_tsc_cycles();
+
+            // Advance the frame timeouts a few ticks towards now, enqueueing any timed out frame
+            // as incomplete and recording how long after its timeout it was released
+            uint64_t lateness_cycles = 0;
+            retired_frame_buffer = likely(release_policy.timeouts()) ?
+                frame_window.expire(now, FRAME_TIMEOUT_TICKS, lateness_cycles) : NULL;
+            if (unlikely(retired_frame_buffer != NULL))
+            {
+                metrics_.add(released_frames_ids_[FrameReleasePolicy::timeout], 1);
+                timeout_lateness_.record(lateness_cycles);
+
+                LOG4CXX_INFO(logger_, "Core " << lcore_id_
+                    << " dropping super frame " << decoder_->get_super_frame_number(retired_frame_buffer)
+                    << " with " << decoder_->get_super_frame_frames_received(retired_frame_buffer)
+                    << " complete sub frames"
+                    );
+
+                // Enqueue the frame reference for the FrameBuilderCore to pick up
+                // there will always be space on this ring, so no retry checks are needed
+                uint64_t retired_frame_number = decoder_->get_super_frame_number(retired_frame_buffer);
+                decoder_->set_super_frame_complete_time(retired_frame_buffer, now);
+                rte_ring_enqueue(
+                    downstream_rings_[
+                        (retired_frame_number / frame_outer_chunk_size) %
+                        config_.num_downstream_cores
+                    ], retired_frame_buffer
+                );
+
+                // Stop any further packets being written into the frame now it has been passed on
+                if (current_frame_ == retired_frame_number)
+                {
+                    current_frame_ = -1;
+                }
+
+                // Increment the counter for incomplete frames
+                metrics_.add(incomplete_frames_id_, 1);
+                recorder_.record(
+                    retired_frame_number, FlightRecorder::process, FlightRecorder::enqueued
+                );
+                recorder_.record_loss(
+                    retired_frame_number, FlightRecorder::process, FlightRecorder::incomplete
+                );
+            }
+
+            // Publish the core metrics every second
+            metrics_.set(frame_buffer_size_id_, frame_window.size());
+            metrics_.update(now);
+            
+        }
+        rte_free(dropped_frame_buffer_);
+
+        // Return any frame buffers cached on this lcore to the pool
+        buffer_pool_->flush();
+        metrics_.flush();
+        return true;
+    }
+
+    template <typename DecoderT>
+    uint64_t PacketProcessorCoreT<DecoderT>::count_packets_received(
+        SuperFrameHeader* super_frame_buffer
+    )
+    {
+        uint64_t packets_received = 0;
+        uint64_t frame_outer_chunk_size = decoder_->get_frame_outer_chunk_size();
+        for (uint64_t frame_idx = 0; frame_idx < frame_outer_chunk_size; frame_idx++)
+        {
+            packets_received += decoder_->get_packets_received(
+                decoder_->get_frame_header(super_frame_buffer, frame_idx)
+            );
+        }
+        return packets_received;
+    }
+
+    template <typename DecoderT>
+    void PacketProcessorCoreT<DecoderT>::stop(void)
+    {
+        if (run_lcore_)
+        {
+            LOG4CXX_INFO(logger_, "Core " << lcore_id_ << " stopping");
+            run_lcore_ = false;
+        }
+        else
+        {
+            if (unlikely(debug_enabled_))
+            {
+                LOG4CXX_DEBUG_LEVEL(2, logger_, "Core " << lcore_id_ << " already stopped");
+            }
+        }
+
+    }
+
+    template <typename DecoderT>
+    void PacketProcessorCoreT<DecoderT>::status(OdinData::IpcMessage& status, const std::string& path)
+    {
+        if (unlikely(debug_enabled_))
+        {
+            LOG4CXX_DEBUG_LEVEL(2, logger_, "Status requested for packetprocessorcore_" << proc_idx_
+                << " from the DPDK plugin");
+        }
+
+        std::string status_path = path + "/packetprocessorcore_" + std::to_string(proc_idx_) + "/";
+        
+        // Create path for updstream ring status
+        std::string ring_status = status_path + "upstream_rings/";
+
+        // Frame, packet, core usage and timing status reporting
+        metrics_.status(status, status_path);
+        status.set_param(
+            status_path + "release/policy", std::string(FrameReleasePolicy::policy_name(release_policy_))
+        );
+
+
+        status.set_param(ring_status + ring_name_str(config_.upstream_core, socket_id_, proc_idx_) + "_count", rte_ring_count(packet_fwd_ring_));
+        status.set_param(ring_status + ring_name_str(config_.upstream_core, socket_id_, proc_idx_) + "_size", rte_ring_get_size(packet_fwd_ring_));
+
+        
+    }
+
+    template <typename DecoderT>
+    bool PacketProcessorCoreT<DecoderT>::connect(void)
+    {
+
+        // connect to the ring for incoming packets
+        std::string upstream_ring_name = ring_name_str(config_.upstream_core, socket_id_, proc_idx_);
+        struct rte_ring* upstream_ring = rte_ring_lookup(upstream_ring_name.c_str());
+        if (upstream_ring == NULL)
+        {
+            // this needs to error out as there should always be upstream resources at this point
+            LOG4CXX_INFO(logger_, config_.core_name << " : " << proc_idx_ << " Failed to Connect to upstream resources!: " << upstream_ring_name );
+            return false;
+        }
+        else
+        {
+            packet_fwd_ring_ = upstream_ring;
+            if (unlikely(debug_enabled_))
+            {
+                LOG4CXX_DEBUG_LEVEL(2, logger_, "Frame ready ring with name "
+                    << upstream_ring_name << " has already been created"
+                );
+            }
+        }
+
+        // connect to the ring for dumping old packets
+        std::string packet_release_ring_name = ring_name_pkt_release(socket_id_);
+        packet_release_ring_ = rte_ring_lookup(packet_release_ring_name.c_str());
+        if (packet_release_ring_ == NULL)
+        {
+            // this needs to error out as there should always be upstream resources at this point
+            LOG4CXX_INFO(logger_, config_.core_name << " : " << proc_idx_ << " Failed to Connect to upstream resources!" << packet_release_ring_name );
+            return false;
+        }
+        else
+        {
+            if (unlikely(debug_enabled_))
+            {
+                LOG4CXX_DEBUG_LEVEL(2, logger_, "Packet release ring with name "
+                    << packet_release_ring_name << " has already been created"
+                );
+            }
+        }
+
+
+        LOG4CXX_INFO(logger_, config_.core_name << " : " << proc_idx_ << " Connected to upstream resources successfully!");
+
+        return true;
+    }
+
+
+    template <typename DecoderT>
+    void PacketProcessorCoreT<DecoderT>::configure(OdinData::IpcMessage& config)
+    {
+        // Update the config based from the passed IPCmessage
+
+        LOG4CXX_INFO(logger_, config_.core_name << " : " << proc_idx_ << " Got update config.");
+
+        if (config.get_param("proc_enable", false))
+        {
+            first_frame_number_ = -1;
+            LOG4CXX_INFO(logger_, config_.core_name << " : " << proc_idx_ << "Reset frame latch");
+        }
+
+    }
+}
+#endif // INCLUDE_PACKETPROCESSORCOREIMPL_H_
@@ -40,7 +40,63 @@ public:
     virtual bool set_packet_received(RawFrameHeader* frame_hdr, uint32_t packet_number) = 0;
     virtual const uint32_t get_packets_received(RawFrameHeader* frame_hdr) const = 0;
     virtual const uint32_t get_packets_dropped(RawFrameHeader* frame_hdr) const = 0;
-    virtual const uint8_t get_packet_state(RawFrameHeader* frame_hdr, uint32_t packet_number) const = 0;
+
+    // Packet state is held in the frame header as a bitmap, one bit per packet packed into
+    // 64 bit words, so that received and missing packets can be handled a word at a time. The
+    // bitmap is addressed by byte, as frame headers are packed and the words are not aligned,
+    // so the words must be accessed with load_packet_state_word and store_packet_state_word
+    virtual uint8_t* get_packet_state_bitmap(RawFrameHeader* frame_hdr) const = 0;
+
+    const std::size_t get_packet_state_words(void) const
+    {
+        return (packets_per_frame_ + packet_state_word_bits - 1) / packet_state_word_bits;
+    }
+
+    // Mask of the bits in use in a word of the packet state bitmap, only the last word of a
+    // frame with a number of packets that is not a multiple of the word size is partial
+    const uint64_t get_packet_state_word_mask(std::size_t word_idx) const
+    {
+        std::size_t remaining = packets_per_frame_ - (word_idx * packet_state_word_bits);
+        return (remaining >= packet_state_word_bits) ? ~0ULL : ((1ULL << remaining) - 1);
+    }
+
+    // Load a word of the packet state bitmap, which may not be aligned
+    static inline uint64_t load_packet_state_word(const uint8_t* packet_state, std::size_t word_idx)
+    {
+        uint64_t word;
+        memcpy(&word, packet_state + (word_idx * sizeof(uint64_t)), sizeof(uint64_t));
+        return word;
+    }
+
+    // Store a word of the packet state bitmap, which may not be aligned
+    static inline void store_packet_state_word(
+        uint8_t* packet_state, std::size_t word_idx, uint64_t word
+    )
+    {
+        memcpy(packet_state + (word_idx * sizeof(uint64_t)), &word, sizeof(uint64_t));
+    }
+
+    // Set the state bit of a packet, returning false if the packet had already been received
+    static inline bool set_packet_state_bit(uint8_t* packet_state, uint32_t packet_number)
+    {
+        std::size_t word_idx = packet_number / packet_state_word_bits;
+        uint64_t bit = 1ULL << (packet_number % packet_state_word_bits);
+        uint64_t word = load_packet_state_word(packet_state, word_idx);
+        bool newly_set = !(word & bit);
+        store_packet_state_word(packet_state, word_idx, word | bit);
+        return newly_set;
+    }
+
+    static inline bool test_packet_state_bit(const uint8_t* packet_state, uint32_t packet_number)
+    {
+        return (load_packet_state_word(packet_state, packet_number / packet_state_word_bits) >>
+            (packet_number % packet_state_word_bits)) & 1ULL;
+    }
+
+    virtual const uint8_t get_packet_state(RawFrameHeader* frame_hdr, uint32_t packet_number) const
+    {
+        return test_packet_state_bit(get_packet_state_bitmap(frame_hdr), packet_number);
+    }
 
     virtual const uint64_t get_frame_number(PacketHeader* packet_hdr) const = 0;
     virtual const uint32_t get_packet_number(PacketHeader* packet_hdr) const = 0;
@@ -51,6 +107,8 @@ public:
     virtual SuperFrameHeader* reorder_frame(SuperFrameHeader* frame_hdr, SuperFrameHeader* reordered_frame) = 0;
     virtual SuperFrameHeader* reorder_frame(SuperFrameHeader* frame_hdr, boost::shared_ptr<FrameProcessor::Frame> reordered_frame) = 0;
 
+    static const std::size_t packet_state_word_bits = 64;
+
 protected:
 
     std::size_t packets_per_frame_;
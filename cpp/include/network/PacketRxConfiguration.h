@@ -20,7 +20,11 @@ namespace FrameProcessor
         const unsigned int default_release_ring_size = 32768;
         const unsigned int default_max_packet_tx_retries = 64;
         const unsigned int default_max_packet_queue_retries = 64;
+        const bool default_fwd_burst_mode = true;
         const std::string default_pcie_device = "";
+        const bool default_ip_reassembly = false;
+        const unsigned int default_ip_frag_flows = 4096;
+        const unsigned int default_ip_frag_timeout_ms = 100;
     }
 
     class PacketRxConfiguration : public OdinData::ParamContainer
@@ -39,8 +43,12 @@ namespace FrameProcessor
                 release_ring_size_(Defaults::default_release_ring_size),
                 max_packet_tx_retries_(Defaults::default_max_packet_tx_retries),
                 max_packet_queue_retries_(Defaults::default_max_packet_queue_retries),
+                fwd_burst_mode_(Defaults::default_fwd_burst_mode),
                 num_processor_cores_(Defaults::default_num_processor_cores),
-                pcie_device_(Defaults::default_pcie_device)
+                pcie_device_(Defaults::default_pcie_device),
+                ip_reassembly_(Defaults::default_ip_reassembly),
+                ip_frag_flows_(Defaults::default_ip_frag_flows),
+                ip_frag_timeout_ms_(Defaults::default_ip_frag_timeout_ms)
             {
                 bind_params();
             }
@@ -82,7 +90,11 @@ namespace FrameProcessor
                 bind_param<unsigned int>(release_ring_size_, "release_ring_size");
                 bind_param<unsigned int>(max_packet_tx_retries_, "max_packet_tx_retries");
                 bind_param<unsigned int>(max_packet_queue_retries_, "max_packet_queue_retries");
+                bind_param<bool>(fwd_burst_mode_, "fwd_burst_mode");
                 bind_param<std::string>(pcie_device_, "pcie_device");
+                bind_param<bool>(ip_reassembly_, "ip_reassembly");
+                bind_param<unsigned int>(ip_frag_flows_, "ip_frag_flows");
+                bind_param<unsigned int>(ip_frag_timeout_ms_, "ip_frag_timeout_ms");
 
             }
 
@@ -99,7 +111,11 @@ namespace FrameProcessor
             unsigned int release_ring_size_;        //!< Packet release ring size
             unsigned int max_packet_tx_retries_;    //!< Max num of packet RX retries
             unsigned int max_packet_queue_retries_; //!< Max num of packet queue retries
+            bool fwd_burst_mode_;                   //!< Stage and forward packets in bursts
             std::string pcie_device_;  //!< Vector of address to allow claiming of multiple PCIE devices 
+            bool ip_reassembly_;                    //!< Reassemble fragmented IPv4 datagrams
+            unsigned int ip_frag_flows_;            //!< Datagrams each core can reassemble at once
+            unsigned int ip_frag_timeout_ms_;       //!< Time to wait for the fragments of a datagram
 
             unsigned int num_processor_cores_;  //!< Number of packet processor cores running
 
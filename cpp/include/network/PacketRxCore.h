@@ -1,6 +1,7 @@
 #ifndef INCLUDE_PACKETRXCORE_H_
 #define INCLUDE_PACKETRXCORE_H_
 
+#include <atomic>
 #include <set>
 #include <string>
 #include <vector>
@@ -15,14 +16,22 @@ using namespace log4cxx::helpers;
 #include "network/PacketRxConfiguration.h"
 #include "network/PacketProtocolDecoder.h"
 #include "DpdkDevice.h"
+#include "FlightRecorder.h"
 
 #include <rte_ether.h>
 #include <rte_ring.h>
 #include <rte_mbuf.h>
 #include <rte_ethdev.h>
+#include <rte_ip_frag.h>
 
 namespace FrameProcessor
 {
+    //! Frame number latch shared by the PacketRxCore instances receiving on the queues of a
+    //! device, so that every instance distributes a given frame to the same downstream core
+    struct PacketRxFrameLatch
+    {
+        std::atomic<int64_t> first_frame_number;
+    };
 
     class PacketRxCore : public DpdkWorkerCore
     {
@@ -42,6 +51,7 @@ namespace FrameProcessor
 
     private:
         bool add_device(const std::string& pci_address);
+        bool attach_device(const std::string& pci_address);
         bool remove_device();
 
         bool handle_arp_request(
@@ -55,16 +65,28 @@ namespace FrameProcessor
             struct rte_mbuf **pkt, struct rte_ether_hdr **pkt_ether_hdr,
             struct rte_ipv4_hdr **pkt_ipv4_hdr, struct rte_udp_hdr **pkt_udp_hdr
         );
+        void flush_forward_staging(void);
+        struct rte_mbuf* reassemble_fragment(
+            struct rte_mbuf* pkt, struct rte_ipv4_hdr* pkt_ipv4_hdr, uint64_t rx_cycles
+        );
+        void release_death_row(void);
 
         static const uint16_t DEFAULT_BURST_SIZE;
         static const unsigned int DEFAULT_FWD_RING_SIZE;
         static const unsigned int DEFAULT_RELEASE_RING_SIZE;
 
+        //! Associativity of each bucket of the IPv4 reassembly table
+        static const uint32_t IP_FRAG_BUCKET_ENTRIES = 16;
+
         PacketRxConfiguration config_;
 
         DpdkDevice* device_;
 
         int proc_idx_;
+        unsigned int queue_idx_;        //!< Index of this core among the PacketRxCores
+        uint16_t rx_queue_id_;          //!< Device RX queue this core receives on
+        uint16_t tx_queue_id_;          //!< Device TX queue this core sends replies on
+        bool owns_device_;              //!< This core added the device and owns shared rings
         uint64_t total_packets_;
         uint64_t dropped_packets_;
         uint64_t captured_packets_;
@@ -75,14 +97,28 @@ namespace FrameProcessor
         int64_t first_frame_number_;
         uint64_t first_seen_frame_number_;
         uint64_t rx_frames_;
+        PacketRxFrameLatch* frame_latch_;        //!< Frame latch shared between RX queues
+        PacketRxFrameLatch local_frame_latch_;   //!< Fallback latch if the shared one fails
         bool rx_enable_;
 
 
         struct rte_ether_addr dev_eth_addr_;
         uint32_t dev_ip_addr_;
         std::vector<struct rte_ring *> packet_forward_rings_;
+        std::vector<std::vector<struct rte_mbuf *>> fwd_staging_;  //!< Per-ring staged packets
+        std::vector<uint16_t> fwd_staged_count_;                   //!< Per-ring staged count
         struct rte_ring *packet_release_ring_;
 
+        struct rte_ip_frag_tbl* frag_tbl_;          //!< IPv4 reassembly table, NULL if disabled
+        struct rte_ip_frag_death_row death_row_;    //!< Fragments freed by the reassembly table
+        uint64_t ip_fragments_;                     //!< IPv4 fragments received
+        uint64_t ip_reassembled_;                   //!< Datagrams reassembled from fragments
+        uint64_t ip_frag_timed_out_;                //!< Fragments of datagrams that timed out
+        uint64_t ip_frag_table_full_;               //!< Fragments dropped with the table full
+        uint64_t ip_frag_invalid_;                  //!< Fragments of invalid datagrams
+
+        FlightRecorder recorder_;       //!< Frame flight recorder
+
         LoggerPtr logger_;
     };
 }
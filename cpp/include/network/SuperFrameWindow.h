@@ -0,0 +1,196 @@
+/*
+ * SuperFrameWindow.h - a fixed-size window of in-flight super frames for packet processing.
+ *
+ * Super frames are assigned to packet processor cores in a fixed stride, so the frames in
+ * flight on a core have dense, monotonically increasing numbers. This allows them to be tracked
+ * in a preallocated ring of slots indexed by frame number, giving constant time insert, lookup
+ * and retire without any allocation on the packet processing path.
+ *
+ * The timeout of each frame is scheduled in a FrameTimeoutWheel from the frame start time, so
+ * that timed out frames are found within a tick of their timeout, however large the window.
+ */
+
+#ifndef INCLUDE_SUPERFRAMEWINDOW_H_
+#define INCLUDE_SUPERFRAMEWINDOW_H_
+
+#include <cstdint>
+#include <stdexcept>
+
+#include <rte_malloc.h>
+#include <rte_branch_prediction.h>
+#include <rte_cycles.h>
+
+#include "ProtocolDecoder.h"
+#include "network/FrameTimeoutWheel.h"
+
+namespace FrameProcessor
+{
+    class SuperFrameWindow
+    {
+    public:
+
+        //! Constructor for the SuperFrameWindow class.
+        //!
+        //! \param[in] window_size - minimum number of slots, rounded up to a power of two
+        //! \param[in] stride - difference between consecutive frame numbers seen by this core
+        //! \param[in] socket_id - NUMA socket to allocate the slots on
+        //! \param[in] timeout_cycles - frame timeout in TSC cycles
+        //! \param[in] tick_cycles - resolution of the frame timeouts in TSC cycles
+        //!
+        SuperFrameWindow(
+            unsigned int window_size, unsigned int stride, int socket_id,
+            uint64_t timeout_cycles, uint64_t tick_cycles
+        ) :
+            stride_(stride > 0 ? stride : 1),
+            size_(0),
+            timeout_cycles_(timeout_cycles),
+            timeouts_(
+                window_slots(window_size), tick_cycles, rte_get_tsc_cycles(), socket_id
+            )
+        {
+            unsigned int num_slots = window_slots(window_size);
+            mask_ = num_slots - 1;
+
+            slots_ = static_cast<Slot*>(rte_zmalloc_socket(
+                "super_frame_window", sizeof(Slot) * num_slots, RTE_CACHE_LINE_SIZE, socket_id
+            ));
+            if (slots_ == NULL)
+            {
+                throw std::runtime_error("Failed to allocate super frame window");
+            }
+        }
+
+        ~SuperFrameWindow()
+        {
+            rte_free(slots_);
+        }
+
+        //! Find the buffer of an in-flight super frame
+        //!
+        //! \param[in] super_frame_number - number of the super frame
+        //!
+        //! \return pointer to the super frame buffer, or NULL if the frame is not in the window
+        //!
+        inline SuperFrameHeader* find(uint64_t super_frame_number) const
+        {
+            const Slot& slot = slots_[index(super_frame_number)];
+            if ((slot.buffer != NULL) && (slot.super_frame_number == super_frame_number))
+            {
+                return slot.buffer;
+            }
+            return NULL;
+        }
+
+        //! Insert a super frame into the window
+        //!
+        //! If the slot for the frame is still occupied by a frame a whole window older, that frame
+        //! is evicted and returned so the caller can retire it.
+        //!
+        //! \param[in] super_frame_number - number of the super frame
+        //! \param[in] buffer - super frame buffer
+        //! \param[in] start_cycles - TSC cycle count the frame was started at
+        //!
+        //! \return pointer to the evicted super frame buffer, or NULL if the slot was free
+        //!
+        inline SuperFrameHeader* insert(
+            uint64_t super_frame_number, SuperFrameHeader* buffer, uint64_t start_cycles
+        )
+        {
+            uint64_t slot_index = index(super_frame_number);
+            Slot& slot = slots_[slot_index];
+            SuperFrameHeader* evicted = slot.buffer;
+            if (likely(evicted == NULL))
+            {
+                size_++;
+            }
+            slot.super_frame_number = super_frame_number;
+            slot.buffer = buffer;
+            timeouts_.schedule(slot_index, start_cycles + timeout_cycles_);
+            return evicted;
+        }
+
+        //! Remove a super frame from the window
+        //!
+        //! \param[in] super_frame_number - number of the super frame
+        //!
+        inline void erase(uint64_t super_frame_number)
+        {
+            uint64_t slot_index = index(super_frame_number);
+            Slot& slot = slots_[slot_index];
+            if ((slot.buffer != NULL) && (slot.super_frame_number == super_frame_number))
+            {
+                slot.buffer = NULL;
+                size_--;
+                timeouts_.cancel(slot_index);
+            }
+        }
+
+        //! Find a timed out super frame
+        //!
+        //! Advances the frame timeouts up to the specified number of ticks towards the current
+        //! time. The first timed out frame found is removed from the window and returned.
+        //!
+        //! \param[in] now - current TSC cycle count
+        //! \param[in] max_ticks - maximum number of timeout ticks to advance
+        //! \param[out] lateness_cycles - TSC cycles between the frame timeout and now
+        //!
+        //! \return pointer to the timed out super frame buffer, or NULL if none was found
+        //!
+        inline SuperFrameHeader* expire(
+            uint64_t now, unsigned int max_ticks, uint64_t& lateness_cycles
+        )
+        {
+            uint32_t slot_index = timeouts_.expire(now, max_ticks);
+            if (likely(slot_index == FrameTimeoutWheel::none))
+            {
+                return NULL;
+            }
+
+            Slot& slot = slots_[slot_index];
+            SuperFrameHeader* timed_out = slot.buffer;
+            slot.buffer = NULL;
+            size_--;
+            lateness_cycles = now - timeouts_.deadline(slot_index);
+            return timed_out;
+        }
+
+        //! Get the number of super frames currently in the window
+        inline uint64_t size(void) const { return size_; }
+
+        //! Get the number of slots in the window
+        inline uint64_t capacity(void) const { return mask_ + 1; }
+
+    private:
+
+        struct Slot
+        {
+            uint64_t super_frame_number;    //!< Number of the super frame in the slot
+            SuperFrameHeader* buffer;       //!< Super frame buffer, NULL if the slot is free
+        };
+
+        //! Get the number of slots for a window size, rounded up to a power of two
+        static inline unsigned int window_slots(unsigned int window_size)
+        {
+            unsigned int num_slots = 1;
+            while (num_slots < window_size)
+            {
+                num_slots <<= 1;
+            }
+            return num_slots;
+        }
+
+        inline uint64_t index(uint64_t super_frame_number) const
+        {
+            return (super_frame_number / stride_) & mask_;
+        }
+
+        Slot* slots_;               //!< Preallocated window slots
+        uint64_t mask_;             //!< Slot index mask
+        uint64_t stride_;           //!< Frame number stride between frames seen by this core
+        uint64_t size_;             //!< Number of occupied slots
+        uint64_t timeout_cycles_;   //!< Frame timeout in TSC cycles
+        FrameTimeoutWheel timeouts_;    //!< Timeouts of the frames in the window, by slot
+    };
+}
+
+#endif // INCLUDE_SUPERFRAMEWINDOW_H_
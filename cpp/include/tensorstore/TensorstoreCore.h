@@ -17,6 +17,7 @@
 #include <tensorstore/util/future.h>
 
 #include "DpdkWorkerCore.h"
+#include "DownstreamDistributor.h"
 #include "DpdkCoreConfiguration.h"
 #include "TensorstoreCoreConfiguration.h"
 #include "ProtocolDecoder.h"
@@ -97,9 +98,9 @@ namespace FrameProcessor
         // DPDK resources
         ProtocolDecoder* decoder_;
         DpdkSharedBuffer* shared_buf_;
-        struct rte_ring* clear_frames_ring_;
+        DpdkBufferPool* buffer_pool_;
         struct rte_ring* upstream_ring_;
-        std::vector<struct rte_ring*> downstream_rings_;
+        DownstreamDistributor downstream_;
         
         // TensorStore state
         bool tensorstore_initialized_;
@@ -24,6 +24,7 @@ namespace FrameProcessor
         public:
             TensorstoreCoreConfiguration() :
                 ParamContainer(),
+                distribution_(Defaults::default_distribution),
                 path_(Defaults::kDefaultDatasetPath),
                 enable_writing_(Defaults::kDefaultEnableWriting),
                 csv_logging_(Defaults::kDefaultCsvLogging),
@@ -58,6 +59,7 @@ namespace FrameProcessor
                 bind_param<std::string>(upstream_core, "upstream_core");
                 bind_param<unsigned int>(num_cores, "num_cores");
                 bind_param<unsigned int>(num_downstream_cores, "num_downstream_cores");
+                bind_param<std::string>(distribution_, "distribution");
                 bind_param<std::string>(storage_path_, "storage_path");
                 bind_param<unsigned int>(number_of_frames_, "number_of_frames");
                 bind_param<unsigned int>(frame_size_, "frame_size");
@@ -84,6 +86,7 @@ namespace FrameProcessor
             std::string upstream_core;
             unsigned int num_cores;
             unsigned int num_downstream_cores;
+            std::string distribution_;  //!< Policy for distributing frames to downstream cores
             
             // TensorStore specific config
             std::string storage_path_;
@@ -0,0 +1,598 @@
+/*
+ * CoreMetrics.cpp - per-lcore worker core metrics, reported in status and through rte_telemetry.
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <mutex>
+#include <utility>
+
+#include <rte_pause.h>
+#include <rte_telemetry.h>
+
+#include "CoreMetrics.h"
+#include "dpdk_version_compatibiliy.h"
+
+namespace FrameProcessor
+{
+    //! Get the lock protecting the registry of metrics blocks and the metrics they hold
+    static std::mutex& registry_mutex(void)
+    {
+        static std::mutex mutex;
+        return mutex;
+    }
+
+    //! Get the registry of metrics blocks, which must be accessed with the registry lock held
+    static std::vector<CoreMetrics*>& registry(void)
+    {
+        static std::vector<CoreMetrics*> metrics;
+        return metrics;
+    }
+
+    //! Get the profiling settings, which must be accessed with the registry lock held
+    static std::pair<bool, std::string>& profiling_settings(void)
+    {
+        static std::pair<bool, std::string> settings(false, "");
+        return settings;
+    }
+
+    //! Calculate the profiling values reported for a set of hardware counts
+    //!
+    //! \param[in] counts - hardware counts, indexed by event
+    //! \param[in] units - number of frames or idle loops the counts are attributed to
+    //! \param[out] values - names and values of the counts per unit, the instructions per cycle
+    //!                     and the misses per thousand instructions
+    //!
+    static void perf_values(
+        const uint64_t* counts, const uint64_t units,
+        std::vector<std::pair<std::string, double> >& values
+    )
+    {
+        values.clear();
+        for (unsigned int event = 0; event < PerfCounters::num_events; event++)
+        {
+            values.push_back(std::make_pair(
+                std::string(PerfCounters::event_name(event)),
+                units ? static_cast<double>(counts[event]) / units : 0.0
+            ));
+        }
+
+        double cycles = static_cast<double>(counts[PerfCounters::cycles]);
+        double kilo_instructions = counts[PerfCounters::instructions] / 1000.0;
+        values.push_back(std::make_pair(std::string("ipc"),
+            cycles ? counts[PerfCounters::instructions] / cycles : 0.0));
+        values.push_back(std::make_pair(std::string("llc_mpki"), kilo_instructions ?
+            counts[PerfCounters::llc_misses] / kilo_instructions : 0.0));
+        values.push_back(std::make_pair(std::string("dtlb_mpki"), kilo_instructions ?
+            counts[PerfCounters::dtlb_misses] / kilo_instructions : 0.0));
+        values.push_back(std::make_pair(std::string("branch_mpki"), kilo_instructions ?
+            counts[PerfCounters::branch_misses] / kilo_instructions : 0.0));
+    }
+
+    //! Convert a TSC cycle count to nanoseconds
+    static inline uint64_t cycles_to_ns(const uint64_t cycles)
+    {
+        return static_cast<uint64_t>((cycles * 1.0e9) / rte_get_tsc_hz());
+    }
+
+    //! Telemetry command listing the names of the registered metrics blocks
+    //!
+    //! \param[in] cmd - telemetry command
+    //! \param[in] params - telemetry command parameters, unused
+    //! \param[in] data - telemetry data to populate
+    //!
+    //! \return 0
+    //!
+    static int telemetry_list_cores(const char* cmd, const char* params, struct rte_tel_data* data)
+    {
+        rte_tel_data_start_array(data, RTE_TEL_STRING_VAL);
+
+        std::lock_guard<std::mutex> lock(registry_mutex());
+        for (auto& metrics : registry())
+        {
+            rte_tel_data_add_array_string(data, metrics->name().c_str());
+        }
+        return 0;
+    }
+
+    //! Telemetry command reporting the metrics of a named metrics block
+    //!
+    //! \param[in] cmd - telemetry command
+    //! \param[in] params - name of the metrics block, as listed by /odin_data/cores
+    //! \param[in] data - telemetry data to populate
+    //!
+    //! \return 0, or -EINVAL if there is no metrics block with the name given
+    //!
+    static int telemetry_core(const char* cmd, const char* params, struct rte_tel_data* data)
+    {
+        if ((params == NULL) || (strlen(params) == 0))
+        {
+            return -EINVAL;
+        }
+
+        std::lock_guard<std::mutex> lock(registry_mutex());
+        for (auto& metrics : registry())
+        {
+            if (metrics->name() == params)
+            {
+                metrics->telemetry(data);
+                return 0;
+            }
+        }
+        return -EINVAL;
+    }
+
+    //! Register the telemetry commands, once per process
+    static void register_telemetry_commands(void)
+    {
+        static std::once_flag registered;
+        std::call_once(registered, []() {
+            rte_telemetry_register_cmd("/odin_data/cores", telemetry_list_cores,
+                "Returns the names of the worker core metrics blocks. Takes no parameters"
+            );
+            rte_telemetry_register_cmd("/odin_data/core", telemetry_core,
+                "Returns the metrics of a worker core. Parameters: string core name"
+            );
+        });
+    }
+
+    //! Constructor for the CoreMetrics class
+    //!
+    //! The metrics block is added to the registry reported through rte_telemetry.
+    //!
+    //! \param[in] name - name of the metrics block, matching the core status path
+    //!
+    CoreMetrics::CoreMetrics(const std::string& name) :
+        name_(name),
+        perf_(NULL)
+    {
+        memset(&last_published_, 0, sizeof(last_published_));
+        memset(&local_, 0, sizeof(local_));
+        local_.period_start = rte_get_tsc_cycles();
+        local_.period_cycles = rte_get_tsc_hz();
+
+        published_.sequence.store(0, std::memory_order_relaxed);
+        for (unsigned int idx = 0; idx < num_values; idx++)
+        {
+            published_.values[idx].store(0, std::memory_order_relaxed);
+        }
+
+        register_telemetry_commands();
+
+        std::lock_guard<std::mutex> lock(registry_mutex());
+        registry().push_back(this);
+    }
+
+    //! Destructor for the CoreMetrics class
+    CoreMetrics::~CoreMetrics()
+    {
+        stop_profiling();
+
+        std::lock_guard<std::mutex> lock(registry_mutex());
+        registry().erase(
+            std::remove(registry().begin(), registry().end(), this), registry().end()
+        );
+    }
+
+    //! Add a counter, a running total incremented with add()
+    //!
+    //! \param[in] path - path to report the counter under, relative to the core status path
+    //!
+    //! \return the ID of the counter
+    //!
+    unsigned int CoreMetrics::add_counter(const std::string& path)
+    {
+        return add_metric(path, counter);
+    }
+
+    //! Add a gauge, a value set with set()
+    //!
+    //! \param[in] path - path to report the gauge under, relative to the core status path
+    //!
+    //! \return the ID of the gauge
+    //!
+    unsigned int CoreMetrics::add_gauge(const std::string& path)
+    {
+        return add_metric(path, gauge);
+    }
+
+    //! Add a timer, reporting the mean microseconds per frame of the cycles added with add()
+    //!
+    //! \param[in] path - path to report the timer under, relative to the core status path
+    //!
+    //! \return the ID of the timer
+    //!
+    unsigned int CoreMetrics::add_timer(const std::string& path)
+    {
+        return add_metric(path, timer);
+    }
+
+    //! Add a latency histogram owned and recorded by the core
+    //!
+    //! \param[in] path - path to report the histogram under, relative to the core status path
+    //! \param[in] histogram - pointer to the histogram
+    //!
+    void CoreMetrics::add_histogram(const std::string& path, const LatencyHistogram* histogram)
+    {
+        std::lock_guard<std::mutex> lock(registry_mutex());
+        histograms_.push_back(Histogram{path, histogram});
+    }
+
+    //! Enable or disable hardware counter profiling for worker cores started afterwards
+    //!
+    //! \param[in] enable - open hardware counters on each worker lcore when it starts
+    //! \param[in] csv_dir - directory to write a profiling CSV file for each core to, or empty
+    //!                      for no CSV files
+    //!
+    void CoreMetrics::set_profiling(const bool enable, const std::string& csv_dir)
+    {
+        std::lock_guard<std::mutex> lock(registry_mutex());
+        profiling_settings() = std::make_pair(enable, csv_dir);
+    }
+
+    //! Start a new publication period, called by the owning lcore before it starts processing
+    //!
+    //! If profiling is enabled, the hardware counters are opened here, on the owning lcore.
+    //!
+    void CoreMetrics::start(void)
+    {
+        start_profiling();
+
+        local_.period_start = rte_get_tsc_cycles();
+        local_.period_cycles = rte_get_tsc_hz();
+        local_.period_frames = 0;
+        local_.period_idle_loops = 0;
+        local_.period_busy_cycles = 0;
+    }
+
+    //! Publish the current totals, called by the owning lcore when it stops processing
+    //!
+    //! The frame total, counters and gauges are published immediately. The per-second rates,
+    //! timers and profiling results keep the values from the last full period. Any hardware
+    //! counters are closed.
+    //!
+    void CoreMetrics::flush(void)
+    {
+        last_published_.frames_processed = local_.frames_processed;
+        for (unsigned int idx = 0; idx < metrics_.size(); idx++)
+        {
+            if (metrics_[idx].kind != timer)
+            {
+                last_published_.values[idx] = local_.values[idx];
+            }
+        }
+        publish(last_published_);
+
+        stop_profiling();
+    }
+
+    //! Take a consistent copy of the published metric values
+    //!
+    //! \param[out] snapshot - snapshot to populate
+    //!
+    void CoreMetrics::snapshot(Snapshot& snapshot) const
+    {
+        uint64_t* values = reinterpret_cast<uint64_t*>(&snapshot);
+        while (true)
+        {
+            uint32_t sequence = published_.sequence.load(std::memory_order_acquire);
+            if ((sequence & 1) == 0)
+            {
+                for (unsigned int idx = 0; idx < num_values; idx++)
+                {
+                    values[idx] = published_.values[idx].load(std::memory_order_relaxed);
+                }
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (published_.sequence.load(std::memory_order_relaxed) == sequence)
+                {
+                    return;
+                }
+            }
+            rte_pause();
+        }
+    }
+
+    //! Report the metrics into a status message
+    //!
+    //! \param[in] status - status message to populate
+    //! \param[in] path - core status path to report the metrics under, ending with "/"
+    //!
+    void CoreMetrics::status(OdinData::IpcMessage& status, const std::string& path) const
+    {
+        Snapshot values;
+        snapshot(values);
+
+        status.set_param(path + "frames_processed", values.frames_processed);
+        status.set_param(path + "frames_processed_per_second", values.frames_per_second);
+        status.set_param(path + "idle_loops", values.idle_loops);
+        status.set_param(path + "core_usage", static_cast<int>(values.core_usage));
+        status.set_param(path + "timing/mean_frame_us", values.mean_frame_us);
+        status.set_param(path + "timing/max_frame_us", values.max_frame_us);
+
+        std::lock_guard<std::mutex> lock(registry_mutex());
+        for (unsigned int idx = 0; idx < metrics_.size(); idx++)
+        {
+            status.set_param(path + metrics_[idx].path, values.values[idx]);
+        }
+        for (auto& histogram : histograms_)
+        {
+            histogram.histogram->status(status, path + histogram.path + "/");
+        }
+
+        // Report the hardware counts per frame and per idle loop when profiling
+        status.set_param(path + "perf/enabled", values.perf_counters > 0);
+        if (values.perf_counters > 0)
+        {
+            std::vector<std::pair<std::string, double> > perf;
+            perf_values(values.perf_busy, values.period_frames, perf);
+            for (auto& value : perf)
+            {
+                status.set_param(path + "perf/frame/" + value.first, value.second);
+            }
+            perf_values(values.perf_idle, values.idle_loops, perf);
+            for (auto& value : perf)
+            {
+                status.set_param(path + "perf/idle_loop/" + value.first, value.second);
+            }
+        }
+    }
+
+    //! Report the metrics into telemetry data, called with the registry lock held
+    //!
+    //! Each histogram is reported as a nested dictionary of its count and percentiles, in
+    //! nanoseconds.
+    //!
+    //! \param[in] data - telemetry data to populate
+    //!
+    void CoreMetrics::telemetry(struct rte_tel_data* data) const
+    {
+        Snapshot values;
+        snapshot(values);
+
+        rte_tel_data_start_dict(data);
+        rte_tel_data_add_dict_uint(data, "frames_processed", values.frames_processed);
+        rte_tel_data_add_dict_uint(data, "frames_processed_per_second", values.frames_per_second);
+        rte_tel_data_add_dict_uint(data, "idle_loops", values.idle_loops);
+        rte_tel_data_add_dict_uint(data, "core_usage", values.core_usage);
+        rte_tel_data_add_dict_uint(data, "timing/mean_frame_us", values.mean_frame_us);
+        rte_tel_data_add_dict_uint(data, "timing/max_frame_us", values.max_frame_us);
+
+        for (unsigned int idx = 0; idx < metrics_.size(); idx++)
+        {
+            rte_tel_data_add_dict_uint(data, metrics_[idx].path.c_str(), values.values[idx]);
+        }
+
+        for (auto& histogram : histograms_)
+        {
+            struct rte_tel_data* histogram_data = rte_tel_data_alloc();
+            if (histogram_data == NULL)
+            {
+                continue;
+            }
+            const LatencyHistogram* latency = histogram.histogram;
+            rte_tel_data_start_dict(histogram_data);
+            rte_tel_data_add_dict_uint(histogram_data, "count", latency->count());
+            rte_tel_data_add_dict_uint(histogram_data, "p50_ns",
+                cycles_to_ns(latency->percentile(50.0)));
+            rte_tel_data_add_dict_uint(histogram_data, "p90_ns",
+                cycles_to_ns(latency->percentile(90.0)));
+            rte_tel_data_add_dict_uint(histogram_data, "p99_ns",
+                cycles_to_ns(latency->percentile(99.0)));
+            rte_tel_data_add_dict_uint(histogram_data, "p999_ns",
+                cycles_to_ns(latency->percentile(99.9)));
+            rte_tel_data_add_dict_uint(histogram_data, "max_ns", cycles_to_ns(latency->max()));
+            rte_tel_data_add_dict_container(data, histogram.path.c_str(), histogram_data, 0);
+        }
+    }
+
+    //! Add a counter, gauge or timer
+    //!
+    //! If the maximum number of metrics has already been added, the metric is given a spare
+    //! slot which is never reported, so the core can still update it without any checks.
+    //!
+    //! \param[in] path - path to report the metric under, relative to the core status path
+    //! \param[in] kind - kind of metric
+    //!
+    //! \return the ID of the metric
+    //!
+    unsigned int CoreMetrics::add_metric(const std::string& path, const MetricKind kind)
+    {
+        std::lock_guard<std::mutex> lock(registry_mutex());
+        if (metrics_.size() >= max_metrics)
+        {
+            return max_metrics;
+        }
+        metrics_.push_back(Metric{path, kind});
+        return metrics_.size() - 1;
+    }
+
+    //! Calculate the per-second rates and timers for the period just ended and publish them
+    //!
+    //! \param[in] now - current TSC cycle count
+    //!
+    void CoreMetrics::roll_over(const uint64_t now)
+    {
+        uint64_t cycles_per_sec = rte_get_tsc_hz();
+        uint64_t elapsed = now - local_.period_start;
+        uint64_t period_frames = local_.period_frames;
+
+        last_published_.frames_processed = local_.frames_processed;
+        last_published_.frames_per_second = (period_frames * cycles_per_sec) / elapsed;
+        last_published_.idle_loops = local_.period_idle_loops;
+        last_published_.core_usage = std::min<uint64_t>(
+            (local_.period_busy_cycles * 255) / elapsed, 255
+        );
+        last_published_.mean_frame_us = period_frames ?
+            (local_.period_busy_cycles * 1000000) / (period_frames * cycles_per_sec) : 0;
+        last_published_.max_frame_us = (local_.max_busy_cycles * 1000000) / cycles_per_sec;
+
+        for (unsigned int idx = 0; idx < metrics_.size(); idx++)
+        {
+            if (metrics_[idx].kind == timer)
+            {
+                last_published_.values[idx] = period_frames ?
+                    (local_.values[idx] * 1000000) / (period_frames * cycles_per_sec) : 0;
+                local_.values[idx] = 0;
+            }
+            else
+            {
+                last_published_.values[idx] = local_.values[idx];
+            }
+        }
+
+        // Split the hardware counts for the period between the work done and the idle loops
+        if (unlikely(perf_ != NULL))
+        {
+            uint64_t counts[PerfCounters::num_events];
+            perf_->read(counts);
+            for (unsigned int event = 0; event < PerfCounters::num_events; event++)
+            {
+                uint64_t total = counts[event] - local_.perf_period_start[event];
+                uint64_t work = std::min(local_.perf_period_busy[event], total);
+                last_published_.perf_busy[event] = work;
+                last_published_.perf_idle[event] = total - work;
+                local_.perf_period_start[event] = counts[event];
+                local_.perf_period_busy[event] = 0;
+            }
+        }
+        last_published_.period_frames = period_frames;
+
+        publish(last_published_);
+
+        if (csv_file_.is_open())
+        {
+            write_csv_row(last_published_);
+        }
+
+        local_.period_start = now;
+        local_.period_frames = 0;
+        local_.period_idle_loops = 0;
+        local_.period_busy_cycles = 0;
+    }
+
+    //! Publish a set of values for readers under the sequence lock
+    //!
+    //! \param[in] snapshot - values to publish
+    //!
+    void CoreMetrics::publish(const Snapshot& snapshot)
+    {
+        const uint64_t* values = reinterpret_cast<const uint64_t*>(&snapshot);
+        uint32_t sequence = published_.sequence.load(std::memory_order_relaxed);
+
+        published_.sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (unsigned int idx = 0; idx < num_values; idx++)
+        {
+            published_.values[idx].store(values[idx], std::memory_order_relaxed);
+        }
+        published_.sequence.store(sequence + 2, std::memory_order_release);
+    }
+
+    //! Add the hardware counts since begin_work() to the counts for work in the current period
+    void CoreMetrics::end_work(void)
+    {
+        uint64_t counts[PerfCounters::num_events];
+        perf_->read(counts);
+        for (unsigned int event = 0; event < PerfCounters::num_events; event++)
+        {
+            local_.perf_period_busy[event] += counts[event] - local_.perf_work_start[event];
+        }
+    }
+
+    //! Open the hardware counters and CSV file on the owning lcore, if profiling is enabled
+    void CoreMetrics::start_profiling(void)
+    {
+        std::pair<bool, std::string> settings;
+        {
+            std::lock_guard<std::mutex> lock(registry_mutex());
+            settings = profiling_settings();
+        }
+        if (!settings.first || (perf_ != NULL))
+        {
+            return;
+        }
+
+        LoggerPtr logger = Logger::getLogger("FP.CoreMetrics");
+
+        PerfCounters* perf = new PerfCounters();
+        unsigned int num_open = perf->open();
+        if (num_open == 0)
+        {
+            LOG4CXX_WARN(logger, name_ << " : no hardware counters available, profiling disabled");
+            delete perf;
+            return;
+        }
+        LOG4CXX_INFO(logger, name_ << " : profiling with " << num_open << " hardware counters");
+
+        perf->read(local_.perf_period_start);
+        memcpy(local_.perf_work_start, local_.perf_period_start, sizeof(local_.perf_work_start));
+        memset(local_.perf_period_busy, 0, sizeof(local_.perf_period_busy));
+        last_published_.perf_counters = num_open;
+        perf_ = perf;
+
+        // Open the CSV file, writing the column headings if it is new
+        if (!settings.second.empty())
+        {
+            std::string csv_path = settings.second + "/" + name_ + "_perf.csv";
+            csv_file_.open(csv_path.c_str(), std::ios::out | std::ios::app);
+            if (!csv_file_.is_open())
+            {
+                LOG4CXX_WARN(logger, name_ << " : unable to open profiling CSV file " << csv_path);
+            }
+            else if (csv_file_.tellp() == 0)
+            {
+                std::vector<std::pair<std::string, double> > perf_columns;
+                perf_values(local_.perf_period_busy, 0, perf_columns);
+                csv_file_ << "time,frames,idle_loops";
+                for (auto& basis : { "frame", "idle_loop" })
+                {
+                    for (auto& column : perf_columns)
+                    {
+                        csv_file_ << "," << basis << "_" << column.first;
+                    }
+                }
+                csv_file_ << std::endl;
+            }
+        }
+    }
+
+    //! Close the hardware counters and CSV file
+    void CoreMetrics::stop_profiling(void)
+    {
+        if (csv_file_.is_open())
+        {
+            csv_file_.close();
+        }
+        if (perf_ != NULL)
+        {
+            PerfCounters* perf = perf_;
+            perf_ = NULL;
+            delete perf;
+        }
+    }
+
+    //! Write a row of profiling results to the CSV file
+    //!
+    //! \param[in] snapshot - published values to write
+    //!
+    void CoreMetrics::write_csv_row(const Snapshot& snapshot)
+    {
+        std::vector<std::pair<std::string, double> > perf;
+
+        csv_file_ << time(NULL) << "," << snapshot.period_frames << "," << snapshot.idle_loops;
+        perf_values(snapshot.perf_busy, snapshot.period_frames, perf);
+        for (auto& value : perf)
+        {
+            csv_file_ << "," << value.second;
+        }
+        perf_values(snapshot.perf_idle, snapshot.idle_loops, perf);
+        for (auto& value : perf)
+        {
+            csv_file_ << "," << value.second;
+        }
+        csv_file_ << "\n";
+        csv_file_.flush();
+    }
+}
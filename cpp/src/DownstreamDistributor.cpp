@@ -0,0 +1,191 @@
+/*
+ * DownstreamDistributor.cpp - distribution of frames from a worker core to its downstream cores.
+ *
+ * The downstream rings are shared by all instances of the upstream worker core, so each ring is
+ * created by the first instance and looked up by the others. Under the shared policy a single
+ * ring is created, and downstream cores find it through lookup_upstream_ring() when no ring of
+ * their own exists.
+ */
+
+#include <algorithm>
+
+#include <rte_errno.h>
+
+#include "DownstreamDistributor.h"
+#include "DpdkUtils.h"
+
+namespace FrameProcessor
+{
+    //! Constructor for the DownstreamDistributor class.
+    DownstreamDistributor::DownstreamDistributor() :
+        policy_(distribute_static),
+        enqueue_failures_(0),
+        logger_(Logger::getLogger("FP.DownstreamDistributor"))
+    {
+    }
+
+    //! Create or look up the downstream rings
+    //!
+    //! This method resolves the distribution policy and creates the downstream rings for it,
+    //! one for each downstream core or a single shared ring, looking up any rings that have
+    //! already been created by another instance of the upstream core.
+    //!
+    //! \param[in] core_name - name of the upstream core, used to name the rings
+    //! \param[in] policy - name of the distribution policy
+    //! \param[in] num_downstream_cores - number of downstream cores
+    //! \param[in] ring_size - minimum size of each ring, rounded up to a power of two
+    //! \param[in] socket_id - ID of the DPDK NUMA socket to create the rings on
+    //!
+    //! \return true if all the rings were created or found
+    //!
+    bool DownstreamDistributor::create_rings(
+        const std::string& core_name, const std::string& policy, const int num_downstream_cores,
+        const unsigned int ring_size, const int socket_id
+    )
+    {
+        if (policy == "static")
+        {
+            policy_ = distribute_static;
+        }
+        else if (policy == "least_occupied")
+        {
+            policy_ = distribute_least_occupied;
+        }
+        else if (policy == "shared")
+        {
+            policy_ = distribute_shared;
+        }
+        else
+        {
+            LOG4CXX_WARN(logger_, "Unknown distribution policy " << policy
+                << " for " << core_name << ", using static distribution"
+            );
+            policy_ = distribute_static;
+        }
+
+        int num_rings = (policy_ == distribute_shared) ?
+            std::min(num_downstream_cores, 1) : num_downstream_cores;
+        bool rings_ok = true;
+
+        // Check if the downstream ring have already been created by another processing core,
+        // otherwise create it with the ring size rounded up to the next power of two
+        for (int ring_idx = 0; ring_idx < num_rings; ring_idx++)
+        {
+            std::string downstream_ring_name = (policy_ == distribute_shared) ?
+                shared_ring_name_str(core_name, socket_id) :
+                ring_name_str(core_name, socket_id, ring_idx);
+            struct rte_ring* downstream_ring = rte_ring_lookup(downstream_ring_name.c_str());
+            if (downstream_ring == NULL)
+            {
+                unsigned int downstream_ring_size = nearest_power_two(ring_size);
+                LOG4CXX_INFO(logger_, "Creating ring name "
+                    << downstream_ring_name << " of size " << downstream_ring_size
+                );
+                downstream_ring = rte_ring_create(
+                    downstream_ring_name.c_str(), downstream_ring_size, socket_id, 0
+                );
+                if (downstream_ring == NULL)
+                {
+                    LOG4CXX_ERROR(logger_, "Error creating downstream ring " << downstream_ring_name
+                        << " : " << rte_strerror(rte_errno)
+                    );
+                    rings_ok = false;
+                }
+            }
+            else
+            {
+                LOG4CXX_DEBUG_LEVEL(2, logger_, "downstream ring with name "
+                    << downstream_ring_name << " has already been created"
+                );
+            }
+            if (downstream_ring)
+            {
+                rings_.push_back(downstream_ring);
+            }
+        }
+
+        ring_enqueued_.assign(rings_.size(), 0);
+        return rings_ok;
+    }
+
+    //! Free the downstream rings
+    void DownstreamDistributor::free_rings(void)
+    {
+        for (auto& ring : rings_)
+        {
+            rte_ring_free(ring);
+        }
+        rings_.clear();
+        ring_enqueued_.clear();
+    }
+
+    //! Look up the ring a downstream core receives frames on
+    //!
+    //! This method looks up the ring created for the downstream core by its upstream core,
+    //! falling back to the shared ring if the upstream core uses the shared policy.
+    //!
+    //! \param[in] upstream_core - name of the upstream core
+    //! \param[in] socket_id - ID of the DPDK NUMA socket of the rings
+    //! \param[in] proc_idx - index of the downstream core
+    //!
+    //! \return pointer to the ring, or NULL if no ring was found
+    //!
+    struct rte_ring* DownstreamDistributor::lookup_upstream_ring(
+        const std::string& upstream_core, const int socket_id, const int proc_idx
+    )
+    {
+        struct rte_ring* ring =
+            rte_ring_lookup(ring_name_str(upstream_core, socket_id, proc_idx).c_str());
+        if (ring == NULL)
+        {
+            ring = rte_ring_lookup(shared_ring_name_str(upstream_core, socket_id).c_str());
+        }
+        return ring;
+    }
+
+    //! Report the distribution of frames to the downstream rings into a status message
+    //!
+    //! This method reports the policy, the frames enqueued by this core and the current
+    //! occupancy of each ring. The imbalance is the ratio of the most frames enqueued on any ring
+    //! to the mean, 1.0 when frames are spread evenly, and the occupancy spread is the difference
+    //! between the fullest and emptiest rings.
+    //!
+    //! \param[in] status - status message to populate
+    //! \param[in] path - parameter path to report the distribution under, ending with "/"
+    //!
+    void DownstreamDistributor::status(OdinData::IpcMessage& status, const std::string& path) const
+    {
+        static const char* policy_names[] = { "static", "least_occupied", "shared" };
+
+        uint64_t total_enqueued = 0;
+        uint64_t max_enqueued = 0;
+        unsigned int min_count = 0;
+        unsigned int max_count = 0;
+
+        for (unsigned int ring_idx = 0; ring_idx < rings_.size(); ring_idx++)
+        {
+            unsigned int count = rte_ring_count(rings_[ring_idx]);
+            std::string ring_path = path + "rings/" + std::string(rings_[ring_idx]->name) + "/";
+
+            status.set_param(ring_path + "enqueued", ring_enqueued_[ring_idx]);
+            status.set_param(ring_path + "count", count);
+            status.set_param(ring_path + "size", rte_ring_get_size(rings_[ring_idx]));
+
+            total_enqueued += ring_enqueued_[ring_idx];
+            max_enqueued = std::max(max_enqueued, ring_enqueued_[ring_idx]);
+            min_count = (ring_idx == 0) ? count : std::min(min_count, count);
+            max_count = std::max(max_count, count);
+        }
+
+        double imbalance = 1.0;
+        if (total_enqueued > 0)
+        {
+            imbalance = static_cast<double>(max_enqueued) * rings_.size() / total_enqueued;
+        }
+
+        status.set_param(path + "policy", std::string(policy_names[policy_]));
+        status.set_param(path + "imbalance", imbalance);
+        status.set_param(path + "occupancy_spread", max_count - min_count);
+        status.set_param(path + "enqueue_failures", enqueue_failures_);
+    }
+}
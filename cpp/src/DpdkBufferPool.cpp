@@ -0,0 +1,227 @@
+/*
+ * DpdkBufferPool.cpp - a pool of free frame buffers from a DPDK shared buffer.
+ *
+ * This class manages the free buffers of a DpdkSharedBuffer, replacing the shared ring of free
+ * frame buffers. Buffers are reused in LIFO order from an rte_stack, using the lock-free stack
+ * implementation where the platform supports it, fronted by per-lcore caches. Threads that are
+ * not DPDK lcores, for instance the frame processor plugin chain releasing a frame, bypass the
+ * caches and use the stack directly.
+ */
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+#include <rte_errno.h>
+#include <rte_malloc.h>
+
+#include "DpdkBufferPool.h"
+#include "DpdkUtils.h"
+
+namespace FrameProcessor
+{
+    //! Constructor for the DpdkBufferPool class.
+    //!
+    //! This constructor looks up the buffer pool for the specified socket, creating it and
+    //! populating it with every buffer in the shared buffer if it does not already exist. The
+    //! requested cache size is limited so that the lcore caches cannot hold a significant
+    //! fraction of the buffers in the pool.
+    //!
+    //! \param[in] shared_buf - shared buffer holding the buffers managed by the pool
+    //! \param[in] cache_size - number of buffers moved per lcore cache refill or flush
+    //! \param[in] socket_id - ID of the DPDK NUMA socket to create the pool on
+    //!
+    DpdkBufferPool::DpdkBufferPool(
+        const DpdkSharedBuffer& shared_buf, const unsigned int cache_size, const int socket_id
+    ):
+        num_buffers_(shared_buf.get_num_buffers()),
+        cache_size_(0),
+        socket_id_(socket_id),
+        lock_free_(false),
+        created_(false),
+        stack_(NULL),
+        caches_(NULL),
+        acquire_failures_(0),
+        logger_(Logger::getLogger("FP.DpdkBufferPool"))
+    {
+        name_ = buffer_pool_name_str(socket_id_);
+
+        // Limit the cache size so all the lcore caches together hold at most a quarter of the
+        // buffers in the pool
+        std::size_t cache_limit = num_buffers_ / (4 * 2 * std::max(rte_lcore_count(), 1u));
+        cache_size_ = static_cast<unsigned int>(std::min<std::size_t>(
+            std::min<std::size_t>(cache_size, max_cache_size), cache_limit
+        ));
+        if (cache_size_ != cache_size)
+        {
+            LOG4CXX_WARN(logger_, "Limiting buffer pool " << name_ << " cache size to "
+                << cache_size_ << " for " << num_buffers_ << " buffers");
+        }
+
+        // First try to lookup an existing pool
+        stack_ = rte_stack_lookup(name_.c_str());
+        if (stack_ != NULL)
+        {
+            LOG4CXX_INFO(logger_, "Found existing buffer pool " << name_);
+        }
+        else
+        {
+            // Create the stack, preferring the lock-free implementation if the platform supports it
+            stack_ = rte_stack_create(name_.c_str(), num_buffers_, socket_id_, RTE_STACK_F_LF);
+            lock_free_ = (stack_ != NULL);
+            if (stack_ == NULL)
+            {
+                LOG4CXX_INFO(logger_, "Lock-free stack not available for buffer pool " << name_
+                    << " : " << rte_strerror(rte_errno));
+                stack_ = rte_stack_create(name_.c_str(), num_buffers_, socket_id_, 0);
+            }
+            if (stack_ == NULL)
+            {
+                LOG4CXX_ERROR(logger_, "Error creating buffer pool " << name_
+                    << " on socket " << socket_id_
+                    << " : " << rte_strerror(rte_errno)
+                );
+                throw std::runtime_error("Failed to create or find buffer pool");
+            }
+            created_ = true;
+
+            // Populate the pool with every buffer, pushed in reverse so the first buffer in the
+            // shared buffer is the first to be acquired
+            std::vector<void*> buffers(num_buffers_);
+            for (std::size_t element = 0; element < num_buffers_; element++)
+            {
+                buffers[num_buffers_ - element - 1] = shared_buf.get_buffer_address(element);
+            }
+            rte_stack_push(stack_, buffers.data(), num_buffers_);
+
+            LOG4CXX_INFO(logger_, "Created buffer pool " << name_
+                << " with " << num_buffers_ << " buffers"
+                << " on socket " << socket_id_
+                << " lock free: " << lock_free_
+                << " cache size: " << cache_size_
+            );
+        }
+
+        if (cache_size_ > 0)
+        {
+            caches_ = static_cast<LcoreCache*>(rte_zmalloc_socket(
+                "buffer_pool_caches", sizeof(LcoreCache) * RTE_MAX_LCORE, RTE_CACHE_LINE_SIZE,
+                socket_id_
+            ));
+            if (caches_ == NULL)
+            {
+                LOG4CXX_WARN(logger_, "Failed to allocate lcore caches for buffer pool " << name_
+                    << ", running without caches");
+                cache_size_ = 0;
+            }
+        }
+    }
+
+    //! Destructor for the DpdkBufferPool class.
+    //!
+    //! This destructor frees the lcore caches and, if this instance created it, the pool stack.
+    //!
+    DpdkBufferPool::~DpdkBufferPool()
+    {
+        LOG4CXX_DEBUG_LEVEL(2, logger_, "Freeing buffer pool " << name_);
+        rte_free(caches_);
+        caches_ = NULL;
+        if (created_)
+        {
+            rte_stack_free(stack_);
+        }
+        stack_ = NULL;
+    }
+
+    //! Flush the buffer cache of the calling lcore
+    //!
+    //! This method returns all buffers held in the cache of the calling lcore to the pool stack,
+    //! making them available to other lcores. It should be called by worker cores as they stop.
+    //!
+    void DpdkBufferPool::flush(void)
+    {
+        unsigned int lcore_id = rte_lcore_id();
+        if ((cache_size_ == 0) || (lcore_id >= RTE_MAX_LCORE))
+        {
+            return;
+        }
+
+        LcoreCache& cache = caches_[lcore_id];
+        rte_stack_push(stack_, cache.objs, cache.len);
+        cache.len = 0;
+    }
+
+    //! Get the number of buffers managed by the pool
+    //!
+    //! \return The number of buffers in the pool as size_t
+    //!
+    const std::size_t DpdkBufferPool::get_num_buffers(void) const
+    {
+        return num_buffers_;
+    }
+
+    //! Get the number of free buffers in the pool
+    //!
+    //! This method returns the number of free buffers, including those held in lcore caches. The
+    //! count is taken without synchronising with the lcores so is approximate while running.
+    //!
+    //! \return The number of free buffers in the pool
+    //!
+    const std::size_t DpdkBufferPool::get_available(void) const
+    {
+        return rte_stack_count(stack_) + get_cached();
+    }
+
+    //! Get the number of free buffers held in lcore caches
+    //!
+    //! \return The number of buffers held in lcore caches
+    //!
+    const std::size_t DpdkBufferPool::get_cached(void) const
+    {
+        std::size_t cached = 0;
+        if (caches_ != NULL)
+        {
+            for (unsigned int lcore_id = 0; lcore_id < RTE_MAX_LCORE; lcore_id++)
+            {
+                cached += caches_[lcore_id].len;
+            }
+        }
+        return cached;
+    }
+
+    //! Get the number of failed attempts to acquire a buffer from the pool
+    //!
+    //! \return The number of failed acquires
+    //!
+    const uint64_t DpdkBufferPool::get_acquire_failures(void) const
+    {
+        uint64_t failures = acquire_failures_.load(std::memory_order_relaxed);
+        if (caches_ != NULL)
+        {
+            for (unsigned int lcore_id = 0; lcore_id < RTE_MAX_LCORE; lcore_id++)
+            {
+                failures += caches_[lcore_id].failures;
+            }
+        }
+        return failures;
+    }
+
+    //! Report the pool occupancy into a status message
+    //!
+    //! \param[in] status - status message to populate
+    //! \param[in] path - parameter path to report the pool status under, ending with "/"
+    //!
+    void DpdkBufferPool::status(OdinData::IpcMessage& status, const std::string& path) const
+    {
+        std::size_t available = get_available();
+
+        status.set_param(path + "name", name_);
+        status.set_param(path + "num_buffers", num_buffers_);
+        status.set_param(path + "available", available);
+        status.set_param(path + "in_use", num_buffers_ - std::min(available, num_buffers_));
+        status.set_param(path + "cached", get_cached());
+        status.set_param(path + "cache_size", cache_size_);
+        status.set_param(path + "lock_free", lock_free_);
+        status.set_param(path + "acquire_failures", get_acquire_failures());
+    }
+}
@@ -24,6 +24,8 @@
 
 #include "DpdkUtils.h"
 #include "DpdkCoreLoader.h"
+#include "CoreMetrics.h"
+#include "FlightRecorder.h"
 
 using namespace OdinData;
 
@@ -38,7 +40,10 @@ namespace FrameProcessor
     ) :
         logger_(Logger::getLogger("FP.DpdkCoreManager")),
         plugin_name_(plugin_name),
-        frame_callback_(frame_callback)
+        frame_callback_(frame_callback),
+        topology_(NULL),
+        nic_socket_(SOCKET_ID_ANY),
+        service_host_(new DpdkServiceHost())
     {
         LOG4CXX_INFO(logger_, "Initialising DPDK core manager");
 
@@ -85,32 +90,23 @@ namespace FrameProcessor
         // Bind the custom IO stream to the DPDK logger
         rte_openlog_stream(fopencookie(nullptr, "w", dpdk_log_funcs));
 
-       // Initialize array to store worker lcores grouped by their NUMA socket
+        // Build the NUMA and CPU topology of the worker lcores, used to place worker cores
         LOG4CXX_INFO(logger_, "Detected " << rte_socket_count() << " NUMA sockets");
-        for (int i = 0 ; i < rte_socket_count(); i++)
-        {
-            std::vector<int> vc;
-            available_core_ids_.push_back(vc);
-        }
-        // Iterate through all worker lcores and map them to their sockets
-        int lcore_id;
         LOG4CXX_INFO(logger_, "Mapping available DPDK worker lcores to sockets:");
-        RTE_LCORE_FOREACH_WORKER(lcore_id)
+        topology_ = new DpdkTopology();
+
+        // Enable hardware counter profiling of the worker cores if requested
+        CoreMetrics::set_profiling(core_config_.perf_profiling_, core_config_.perf_csv_dir_);
+        if (core_config_.perf_profiling_)
         {
-            unsigned int lcore_socket = rte_lcore_to_socket_id(lcore_id);
-            LOG4CXX_INFO(logger_, "  DPDK lcore " << lcore_id << " -> socket " << lcore_socket);
-            available_core_ids_[lcore_socket].push_back(lcore_id);
-        }
-        // Log the final mapping
-        for (size_t i = 0; i < available_core_ids_.size(); i++) {
-            std::stringstream ss;
-            ss << "Socket " << i << " has cores: ";
-            for (auto core : available_core_ids_[i]) {
-                ss << core << " ";
-            }
-            LOG4CXX_INFO(logger_, ss.str());
+            LOG4CXX_INFO(logger_, "Profiling worker cores with hardware performance counters");
         }
 
+        // Size the frame flight recorders before the worker cores create them
+        FlightRecorder::configure(
+            core_config_.flight_recorder_, core_config_.flight_recorder_size_,
+            core_config_.flight_recorder_loss_dump_
+        );
 
         try {
             LOG4CXX_DEBUG(logger_, "DPDKCoreManager: Beginning worker core configuration parsing");
@@ -273,7 +269,10 @@ namespace FrameProcessor
             LOG4CXX_ERROR(logger_, "DPDKCoreManager: Fatal exception during core configuration: " << ex.what());
         }
 
-            
+
+        // Place the shared buffer, rings and worker cores on the socket local to the NIC
+        resolve_placement_socket();
+
         // Create a shared buffer for packet processor cores to build raw frames into. This will
         // be shared between all PPCs, where the first to start will set up the frame processed
         // ring
@@ -282,16 +281,24 @@ namespace FrameProcessor
         DpdkSharedBuffer* shared_buffer =
             new DpdkSharedBuffer(
                 core_config_.shared_buffer_size_, decoder->get_frame_buffer_size(),
-                core_config_.socket_
+                core_config_.socket_, core_config_.shared_buffer_segment_size_
             );
 
         shared_buffers_.push_back(shared_buffer);
         LOG4CXX_DEBUG(logger_, "Created shared buffer for worker cores"
-            << " socket " << 0
+            << " socket " << core_config_.socket_
             << " total size " << shared_buffer->get_mem_size()
             << " buffer size " << shared_buffer->get_buffer_size()
             << " num buffers " << shared_buffer->get_num_buffers()
+            << " num segments " << shared_buffer->get_num_segments()
+        );
+
+        // Create the pool of free frame buffers in the shared buffer, shared by all the cores
+        // that acquire and release frame buffers
+        DpdkBufferPool* buffer_pool = new DpdkBufferPool(
+            *shared_buffer, core_config_.buffer_pool_cache_size_, core_config_.socket_
         );
+        buffer_pools_.push_back(buffer_pool);
 
         // Declare composite data structure to hold the configuration that all workers will likely require
         DpdkWorkCoreReferences dpdkWorkCoreReferences = 
@@ -300,6 +307,7 @@ namespace FrameProcessor
             decoder,
             frame_callback_,
             shared_buffer,
+            buffer_pool,
         };
 
 
@@ -329,8 +337,38 @@ namespace FrameProcessor
                             dpdkWorkCoreReferences
                         );
 
-                        
+                        if (!core)
+                        {
+                            LOG4CXX_ERROR(logger_, "Failed to load worker core from class: "
+                                << worker_class_name);
+                            continue;
+                        }
+
                         register_worker_core(core);
+
+                        // Pin the worker core to an lcore if one is given in the configuration
+                        if (itr->value.HasMember("lcores") && itr->value["lcores"].IsArray() &&
+                            (i < itr->value["lcores"].Size()) && itr->value["lcores"][i].IsInt())
+                        {
+                            pinned_lcore_ids_[core.get()] = itr->value["lcores"][i].GetInt();
+                        }
+
+                        // Host the worker core as a service on a shared service lcore if the
+                        // configuration requests it
+                        if (itr->value.HasMember("service") && itr->value["service"].IsBool() &&
+                            itr->value["service"].GetBool())
+                        {
+                            unsigned int service_lcore = 0;
+                            if (itr->value.HasMember("service_lcore") &&
+                                itr->value["service_lcore"].IsUint())
+                            {
+                                service_lcore = itr->value["service_lcore"].GetUint();
+                            }
+                            service_core_params_[core.get()] = std::make_pair(
+                                worker_class_name + "_" + std::to_string(i + process_offset),
+                                service_lcore
+                            );
+                        }
                         }
                     }
                 }
@@ -349,12 +387,21 @@ namespace FrameProcessor
         // Wait a moment for cores to fully stop
         rte_delay_us_block(1000);
 
+        // Delete buffer pools before the shared buffers they manage
+        for (auto& buffer_pool: buffer_pools_)
+        {
+            delete buffer_pool;
+        }
+
         // Delete shared buffers
         for (auto& shared_buffer: shared_buffers_)
         {
             delete shared_buffer;
         }
 
+        delete service_host_;
+        delete topology_;
+
         // Close and cleanup all DPDK devices/ports
         uint16_t port_id;
         for (port_id = 0; port_id < RTE_MAX_ETHPORTS; port_id++) {
@@ -397,43 +444,68 @@ namespace FrameProcessor
         for (boost::shared_ptr<DpdkWorkerCore>& core: registered_cores_)
         {
 
-            // Determine which, if any, socket the worker core should run on
-            unsigned int core_socket = core->socket_id();
-            int start_socket, end_socket = -1;
-
-            if (core_socket == SOCKET_ID_ANY)
+            // Hand worker cores configured as services to the service host rather than giving
+            // them a dedicated lcore
+            auto service_params = service_core_params_.find(core.get());
+            if (service_params != service_core_params_.end())
             {
-                LOG4CXX_DEBUG_LEVEL(2, logger_, "Worker core " << core_idx
-                    << " has not requested a specific socket"
-                );
-                start_socket = 0;
-                end_socket = available_core_ids_.size();
-            }
-            else
-            {
-                LOG4CXX_DEBUG_LEVEL(2, logger_, "Worker core " << core_idx
-                    << " wants socket id " << core_socket
+                if (core->supports_service())
+                {
+                    LOG4CXX_DEBUG(logger_, "Hosting worker core " << core_idx
+                        << " as service " << service_params->second.first
+                        << " on service lcore index " << service_params->second.second
+                    );
+                    service_host_->add_core(
+                        core.get(), service_params->second.first, service_params->second.second
+                    );
+                    service_cores_.push_back(core);
+                    core_idx++;
+                    continue;
+                }
+                LOG4CXX_WARN(logger_, "Worker core " << service_params->second.first
+                    << " cannot run as a service, launching it on a dedicated lcore"
                 );
-                start_socket = core_socket;
-                end_socket = core_socket;
             }
 
-            // Search through requested socket range for first available unused core
+            // Use the lcore pinned in the configuration if there is one, otherwise select
+            // the first free lcore on the socket the worker core requested
             int next_lcore_id = RTE_MAX_LCORE;
-            for (int socket = start_socket; socket <= end_socket; socket++)
+            auto pinned = pinned_lcore_ids_.find(core.get());
+            if (pinned != pinned_lcore_ids_.end())
             {
-                // Look through available cores on this socket
-                for (auto& avail_id: available_core_ids_[socket])
+                next_lcore_id = pinned->second;
+                if (!topology_->is_worker_lcore(next_lcore_id) ||
+                    (std::find(used_core_ids_.begin(), used_core_ids_.end(), next_lcore_id) !=
+                        std::end(used_core_ids_)))
                 {
-                    // Check if this core ID hasn't been used yet
-                    if (std::find(used_core_ids_.begin(), used_core_ids_.end(), avail_id) ==
-                        std::end(used_core_ids_))
-                    {
-                        next_lcore_id = avail_id; // Found an unused core
-                        break;
-                    }
+                    LOG4CXX_ERROR(logger_, "Error launching worker core " << core_idx
+                        << ": pinned lcore " << next_lcore_id
+                        << " is not a free DPDK worker lcore"
+                    );
+                    start_ok = false;
+                    break;
+                }
+                if ((core->socket_id() != SOCKET_ID_ANY) &&
+                    (topology_->lcore_socket(next_lcore_id) != static_cast<int>(core->socket_id())))
+                {
+                    LOG4CXX_WARN(logger_, "Worker core " << core_idx
+                        << " is pinned to lcore " << next_lcore_id
+                        << " on socket " << topology_->lcore_socket(next_lcore_id)
+                        << " but its resources are on socket " << core->socket_id()
+                    );
                 }
             }
+            else
+            {
+                int core_socket = (core->socket_id() == SOCKET_ID_ANY) ?
+                    SOCKET_ID_ANY : static_cast<int>(core->socket_id());
+                LOG4CXX_DEBUG_LEVEL(2, logger_, "Worker core " << core_idx
+                    << " wants socket id " << core_socket
+                );
+                next_lcore_id = topology_->select_lcore(
+                    core_socket, used_core_ids_, core_config_.smt_exclusive_placement_
+                );
+            }
 
             if (next_lcore_id == RTE_MAX_LCORE)
             {
@@ -464,11 +536,53 @@ namespace FrameProcessor
             used_core_ids_.push_back(next_lcore_id);
             core_idx++;
         }
+
+        // Select the shared service lcores and start the service-hosted worker cores on them
+        if (start_ok && !service_host_->empty())
+        {
+            std::vector<int> service_lcore_ids;
+            for (unsigned int idx = 0; idx < service_host_->get_num_lcores(); idx++)
+            {
+                int service_lcore_id = topology_->select_lcore(
+                    core_config_.socket_, used_core_ids_, core_config_.smt_exclusive_placement_
+                );
+                if (service_lcore_id == RTE_MAX_LCORE)
+                {
+                    LOG4CXX_ERROR(logger_, "Error starting service-hosted worker cores: "
+                        << "no lcore available for service lcore index " << idx
+                    );
+                    start_ok = false;
+                    break;
+                }
+                service_lcore_ids.push_back(service_lcore_id);
+                used_core_ids_.push_back(service_lcore_id);
+            }
+
+            if (start_ok)
+            {
+                LOG4CXX_INFO(logger_, "Starting " << service_cores_.size()
+                    << " service-hosted worker cores on " << service_lcore_ids.size()
+                    << " service lcores"
+                );
+                start_ok = service_host_->start(service_lcore_ids);
+            }
+        }
         return start_ok;
     }
 
     void DpdkCoreManager::stop(void)
     {
+        // Stop the service-hosted worker cores and release their service lcores
+        for (auto& lcore_id : service_host_->get_lcore_ids())
+        {
+            used_core_ids_.erase(
+                std::remove(used_core_ids_.begin(), used_core_ids_.end(), lcore_id),
+                used_core_ids_.end()
+            );
+        }
+        service_host_->stop();
+        service_cores_.clear();
+
         // Warn if there are no running worker cores to stop
         if (running_cores_.empty())
         {
@@ -548,6 +662,11 @@ namespace FrameProcessor
                 dpdk_eal_param_map_["allowdevice"] = "--allow";
                 dpdk_eal_param_map_["proc-type"] = "--proc-type";
                 dpdk_eal_param_map_["file-prefix"] = "--file-prefix";
+                dpdk_eal_param_map_["memory"] = "-m";
+                dpdk_eal_param_map_["vdev"] = "--vdev";
+                dpdk_eal_param_map_["no-huge"] = "--no-huge";
+                dpdk_eal_param_map_["no-pci"] = "--no-pci";
+                dpdk_eal_param_map_["in-memory"] = "--in-memory";
             }
 
             const rapidjson::Value& eal_params =
@@ -559,7 +678,15 @@ namespace FrameProcessor
                 const char* param_name = itr->name.GetString();
                 if (dpdk_eal_param_map_.count(param_name))
                 {
-                    if (itr->value.IsArray())
+                    // Boolean parameters are flags without a value, passed only when true
+                    if (itr->value.IsBool())
+                    {
+                        if (itr->value.GetBool())
+                        {
+                            eal_argv.push_back(strdup(dpdk_eal_param_map_[param_name]));
+                        }
+                    }
+                    else if (itr->value.IsArray())
                     {
                         for (rapidjson::Value::ConstValueIterator val_itr = itr->value.Begin();
                                 val_itr != itr->value.End(); ++val_itr)
@@ -602,6 +729,51 @@ namespace FrameProcessor
         return value;
     }
 
+    void DpdkCoreManager::resolve_placement_socket(void)
+    {
+        // Find the NUMA socket of the first network device claimed by a worker core
+        if (core_config_.worker_core_params_.IsObject())
+        {
+            for (rapidjson::Value::ConstMemberIterator itr = core_config_.worker_core_params_.MemberBegin();
+                itr != core_config_.worker_core_params_.MemberEnd(); ++itr)
+            {
+                if (!itr->value.IsObject() || !itr->value.HasMember("pcie_device") ||
+                    !itr->value["pcie_device"].IsString())
+                {
+                    continue;
+                }
+                std::string device_name = itr->value["pcie_device"].GetString();
+                if (!device_name.empty())
+                {
+                    nic_socket_ = DpdkTopology::device_socket(device_name);
+                    LOG4CXX_INFO(logger_, "Network device " << device_name
+                        << " is on socket " << nic_socket_
+                    );
+                    break;
+                }
+            }
+        }
+
+        if (!core_config_.nic_socket_placement_ || (nic_socket_ == SOCKET_ID_ANY) ||
+            (nic_socket_ == static_cast<int>(core_config_.socket_)))
+        {
+            return;
+        }
+
+        if (topology_->select_lcore(nic_socket_, std::vector<int>(), false) == RTE_MAX_LCORE)
+        {
+            LOG4CXX_WARN(logger_, "Network device socket " << nic_socket_
+                << " has no DPDK worker lcores, keeping configured socket " << core_config_.socket_
+            );
+            return;
+        }
+
+        LOG4CXX_INFO(logger_, "Placing shared buffer, rings and worker cores on network device"
+            << " socket " << nic_socket_ << " instead of configured socket " << core_config_.socket_
+        );
+        core_config_.socket_ = nic_socket_;
+    }
+
     int DpdkCoreManager::start_worker(void* worker_ptr)
     {
         DpdkWorkerCore* worker_core = (DpdkWorkerCore*)worker_ptr;
@@ -618,12 +790,33 @@ namespace FrameProcessor
 
         std::string status_path = plugin_name_ + "/core_manager/";
         status.set_param(status_path + "shared_buffer_size", core_config_.shared_buffer_size_);
+        for (auto& shared_buffer: shared_buffers_)
+        {
+            shared_buffer->status(status, status_path + "shared_buffer/");
+        }
+        status.set_param(status_path + "placement/socket", core_config_.socket_);
+        status.set_param(status_path + "placement/nic_socket", nic_socket_);
+        topology_->status(status, status_path + "placement/", used_core_ids_);
+        for (auto& buffer_pool: buffer_pools_)
+        {
+            buffer_pool->status(status, status_path + "buffer_pool/");
+        }
 
         // Loop through all running cores to and update their current status
         for (auto& core: running_cores_)
         {
             core->status(status, plugin_name_);
         }
+
+        // Report the service lcores and the status of the service-hosted worker cores
+        service_host_->status(status, status_path + "services/");
+        for (auto& core: service_cores_)
+        {
+            core->status(status, plugin_name_);
+        }
+
+        // Report the frame flight recorder settings
+        FlightRecorder::status(status, status_path + "flight_recorder/");
     }
 
     void DpdkCoreManager::configure(OdinData::IpcMessage& config)
@@ -633,6 +826,23 @@ namespace FrameProcessor
 
         LOG4CXX_INFO(logger_, "DpdkCoreManager: Got update message: " << config.get_msg_val());
 
+        // Switch the frame flight recorders on or off, change the prefix of the dumps written on
+        // frame loss, or dump the recorders now to the file given
+        if (config.has_param("flight_recorder"))
+        {
+            FlightRecorder::enable(config.get_param<bool>("flight_recorder"));
+        }
+        if (config.has_param("flight_recorder_loss_dump"))
+        {
+            FlightRecorder::set_loss_dump_file(
+                config.get_param<std::string>("flight_recorder_loss_dump")
+            );
+        }
+        if (config.has_param("flight_recorder_dump"))
+        {
+            FlightRecorder::dump(config.get_param<std::string>("flight_recorder_dump"));
+        }
+
         for (boost::shared_ptr<DpdkWorkerCore>& core: registered_cores_)
         {
             core.get()->configure(config);
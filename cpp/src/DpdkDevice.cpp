@@ -4,22 +4,39 @@
 
 namespace FrameProcessor
 {
-    DpdkDevice::DpdkDevice(uint16_t port_id, const DpdkDeviceConfiguration& config) :
+    DpdkDevice::DpdkDevice(
+        uint16_t port_id, const DpdkDeviceConfiguration& config, uint16_t split_header_size
+    ) :
         port_id_(port_id),
         mbuf_pool_size_(config.mbuf_pool_size()),
         mbuf_cache_size_(config.mbuf_cache_size()),
+        header_pool_(NULL),
         mtu_(config.mtu()),
         rx_rings_(config.rx_rings()),
         rx_num_desc_(config.rx_num_desc()),
         tx_rings_(config.tx_rings()),
         tx_num_desc_(config.tx_num_desc()),
+        rx_steering_(config.rx_steering()),
+        steering_field_offset_(config.steering_field_offset()),
+        rss_enabled_(false),
+        hw_steering_(false),
+        rx_buffer_split_(config.rx_buffer_split()),
+        rx_single_segment_(config.rx_single_segment()),
+        mbuf_data_room_(0),
+        split_header_size_(split_header_size),
+        buffer_split_(false),
         logger_(Logger::getLogger("FP.DpdkDevice"))
     {
 
         int rc;
 
-        // Get the NUMA socket ID for this device port is connected to
-        socket_id_ = 0;// = rte_eth_dev_socket_id(port_id_);
+        // Get the NUMA socket ID for this device port is connected to, using the socket of the
+        // calling lcore if the device has no NUMA affinity
+        socket_id_ = rte_eth_dev_socket_id(port_id_);
+        if (socket_id_ < 0)
+        {
+            socket_id_ = rte_socket_id();
+        }
 
         // Get the PCI device name
         char dev_name[RTE_DEV_NAME_MAX_LEN];
@@ -85,13 +102,32 @@ namespace FrameProcessor
 
         std::string mbuf_pool_name = mbuf_pool_name_str(socket_id_);
 
+        // In single segment mode, size the mbuf data room to hold the headroom and a whole frame
+        // at the MTU, with room for the ethernet header, two VLAN tags and the CRC, so that no
+        // received packet is scattered across several mbufs. Otherwise the data room is the MTU
+        uint32_t data_room = mtu_;
+        if (rx_single_segment_)
+        {
+            data_room = RTE_PKTMBUF_HEADROOM + mtu_ + RTE_ETHER_HDR_LEN + RTE_ETHER_CRC_LEN +
+                (2 * RTE_VLAN_HLEN);
+            if (data_room > UINT16_MAX)
+            {
+                LOG4CXX_WARN(logger_, "MTU " << mtu_ << " for device on port " << port_id_
+                    << " exceeds the largest mbuf data room, packets may be scattered"
+                );
+                data_room = UINT16_MAX;
+            }
+        }
+        mbuf_data_room_ = static_cast<uint16_t>(data_room);
+
         LOG4CXX_DEBUG_LEVEL(2, logger_, "Creating packet mbuf pool " << mbuf_pool_name
             << " for device on port " << port_id_
             << " socket " << socket_id_
+            << " data room " << mbuf_data_room_
         );
         mbuf_pool_ = rte_pktmbuf_pool_create(
             mbuf_pool_name.c_str(), mbuf_pool_size_, mbuf_cache_size_,
-            RTE_MBUF_PRIV_ALIGN, mtu_, socket_id_
+            RTE_MBUF_PRIV_ALIGN, mbuf_data_room_, socket_id_
         );
 
         if (mbuf_pool_ == NULL)
@@ -105,6 +141,49 @@ namespace FrameProcessor
                 );
                 return false;
             }
+
+            // The pool was created for another device on the socket, so report its data room
+            mbuf_data_room_ = rte_pktmbuf_data_room_size(mbuf_pool_);
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Creates the mbuf pool receiving packet headers when buffer split is in use.
+     *
+     * The header mbufs only need room for the packet headers, so the pool has the same number of
+     * elements as the main mbuf pool, which then receives the payload segments.
+     *
+     * @return true if the pool was created or already exists, false otherwise
+     */
+    bool DpdkDevice::init_header_pool(void)
+    {
+        std::string header_pool_name = mbuf_header_pool_name_str(socket_id_);
+        uint16_t header_room = RTE_ALIGN_CEIL(
+            split_header_size_ + RTE_PKTMBUF_HEADROOM, RTE_CACHE_LINE_SIZE
+        );
+
+        LOG4CXX_DEBUG_LEVEL(2, logger_, "Creating header mbuf pool " << header_pool_name
+            << " with data room " << header_room
+            << " for device on port " << port_id_
+        );
+        header_pool_ = rte_pktmbuf_pool_create(
+            header_pool_name.c_str(), mbuf_pool_size_, mbuf_cache_size_,
+            RTE_MBUF_PRIV_ALIGN, header_room, socket_id_
+        );
+
+        if (header_pool_ == NULL)
+        {
+            header_pool_ = rte_mempool_lookup(header_pool_name.c_str());
+            if (header_pool_ == NULL)
+            {
+                LOG4CXX_ERROR(logger_, "Error creating header mbuf pool for device on port "
+                    << port_id_ << " name " << header_pool_name
+                    << " : " << rte_strerror(rte_errno)
+                );
+                return false;
+            }
         }
 
         return true;
@@ -142,8 +221,15 @@ namespace FrameProcessor
             port_conf.txmode.offloads |= RTE_ETH_TX_OFFLOAD_MBUF_FAST_FREE;
         }
 
-        // Enable RX offload scatter to support reception of jumbo frames
-        if (dev_info.rx_offload_capa & RTE_ETH_RX_OFFLOAD_SCATTER)
+        // Enable RX offload scatter to support reception of jumbo frames, unless the mbufs are
+        // sized to receive every frame in a single segment
+        if (rx_single_segment_)
+        {
+            LOG4CXX_INFO(logger_, "Receiving single segment packets with mbuf data room "
+                << mbuf_data_room_ << " for device on port " << port_id_
+            );
+        }
+        else if (dev_info.rx_offload_capa & RTE_ETH_RX_OFFLOAD_SCATTER)
         {
             LOG4CXX_DEBUG_LEVEL(2, logger_,
                 "Enabling RX offload scatter for device on port " << port_id_
@@ -151,6 +237,54 @@ namespace FrameProcessor
             port_conf.rxmode.offloads |= RTE_ETH_RX_OFFLOAD_SCATTER;
         }
 
+        // Split received packets into a small header mbuf and a payload mbuf if requested and
+        // supported by the device. Payloads are then written by the NIC at the start of the
+        // payload mbuf data room, and the RX core only touches the header mbuf. Otherwise fall
+        // back to receiving whole packets and copying the payload from within the packet
+        if (rx_buffer_split_ && (split_header_size_ > 0))
+        {
+            if ((dev_info.rx_offload_capa & RTE_ETH_RX_OFFLOAD_BUFFER_SPLIT) &&
+                (dev_info.rx_seg_capa.max_nseg >= 2) && init_header_pool())
+            {
+                LOG4CXX_INFO(logger_, "Enabling RX buffer split at " << split_header_size_
+                    << " bytes for device on port " << port_id_
+                );
+                port_conf.rxmode.offloads |= RTE_ETH_RX_OFFLOAD_BUFFER_SPLIT;
+                buffer_split_ = true;
+            }
+            else
+            {
+                LOG4CXX_WARN(logger_, "Device on port " << port_id_
+                    << " does not support RX buffer split, falling back to copy from packet"
+                );
+            }
+        }
+
+        // Enable RSS across the RX queues on UDP flows if requested and supported by the device.
+        // If the device does not support this, packets are received on the queues as the driver
+        // chooses and frames are still distributed to the downstream cores in software
+        if ((rx_steering_ == "rss") && (rx_rings_ > 1))
+        {
+            uint64_t rss_hf = dev_info.flow_type_rss_offloads & RTE_ETH_RSS_NONFRAG_IPV4_UDP;
+            if (rss_hf != 0)
+            {
+                LOG4CXX_DEBUG_LEVEL(2, logger_,
+                    "Enabling RSS on UDP flows across " << rx_rings_
+                    << " RX queues for device on port " << port_id_
+                );
+                port_conf.rxmode.mq_mode = RTE_ETH_MQ_RX_RSS;
+                port_conf.rx_adv_conf.rss_conf.rss_key = NULL;
+                port_conf.rx_adv_conf.rss_conf.rss_hf = rss_hf;
+                rss_enabled_ = true;
+            }
+            else
+            {
+                LOG4CXX_WARN(logger_, "Device on port " << port_id_
+                    << " does not support RSS on UDP flows, falling back to software steering"
+                );
+            }
+        }
+
         // Apply the configuration to the device
         rc = rte_eth_dev_configure(port_id_, rx_rings_, tx_rings_, &port_conf);
         if (rc != 0)
@@ -171,31 +305,54 @@ namespace FrameProcessor
             return false;
         }
 
-        // Set up a RX queue for the device - TODO - confirm queue_id and why rxconf is null
-        uint16_t rx_queue_id = 0;
-        rc = rte_eth_rx_queue_setup(
-            port_id_, rx_queue_id, rx_num_desc_, socket_id_, NULL, mbuf_pool_
-        );
-        if (rc != 0)
+        // With buffer split, headers are received into the header pool and the remainder of each
+        // packet into the main mbuf pool
+        struct rte_eth_rxconf rxconf = dev_info.default_rxconf;
+        union rte_eth_rxseg rx_seg[2];
+        memset(rx_seg, 0, sizeof(rx_seg));
+        if (buffer_split_)
         {
-            LOG4CXX_ERROR(logger_, "Error setting up RX queue for device on port " << port_id_
-                << " : " << rte_strerror(rc)
+            rx_seg[0].split.mp = header_pool_;
+            rx_seg[0].split.length = split_header_size_;
+            rx_seg[1].split.mp = mbuf_pool_;
+            rx_seg[1].split.length = 0;
+            rxconf.rx_seg = rx_seg;
+            rxconf.rx_nseg = 2;
+            rxconf.offloads = port_conf.rxmode.offloads;
+        }
+
+        // Set up the RX queues for the device, one for each RX ring requested
+        for (uint16_t rx_queue_id = 0; rx_queue_id < rx_rings_; rx_queue_id++)
+        {
+            rc = rte_eth_rx_queue_setup(
+                port_id_, rx_queue_id, rx_num_desc_, socket_id_,
+                buffer_split_ ? &rxconf : NULL, buffer_split_ ? NULL : mbuf_pool_
             );
-            return false;
+            if (rc != 0)
+            {
+                LOG4CXX_ERROR(logger_, "Error setting up RX queue " << rx_queue_id
+                    << " for device on port " << port_id_
+                    << " : " << rte_strerror(rc)
+                );
+                return false;
+            }
         }
 
-        // Set up a TX queue for the device
-        uint16_t tx_queue_id = 0;
+        // Set up the TX queues for the device, one for each TX ring requested
         struct rte_eth_txconf txconf = dev_info.default_txconf;
         txconf.offloads = port_conf.txmode.offloads;
 
-        rc = rte_eth_tx_queue_setup(port_id_, tx_queue_id, tx_num_desc_, socket_id_, &txconf);
-        if (rc != 0)
+        for (uint16_t tx_queue_id = 0; tx_queue_id < tx_rings_; tx_queue_id++)
         {
-            LOG4CXX_ERROR(logger_, "Error setting up TX queue for device on port " << port_id_
-                << " : " << rte_strerror(rc)
-            );
-            return false;
+            rc = rte_eth_tx_queue_setup(port_id_, tx_queue_id, tx_num_desc_, socket_id_, &txconf);
+            if (rc != 0)
+            {
+                LOG4CXX_ERROR(logger_, "Error setting up TX queue " << tx_queue_id
+                    << " for device on port " << port_id_
+                    << " : " << rte_strerror(rc)
+                );
+                return false;
+            }
         }
 
         return true;
@@ -235,6 +392,7 @@ namespace FrameProcessor
         int rc;
 
         LOG4CXX_INFO(logger_, "Stopping ethernet device on port " << port_id_);
+        flush_flows();
         rc = rte_eth_dev_stop(port_id_);
         if (rc != 0)
         {
@@ -245,4 +403,198 @@ namespace FrameProcessor
         }
         return true;
     }
-}
\ No newline at end of file
+
+    /**
+     * @brief Configures steering of received packets to the RX queues of the device.
+     *
+     * Depending on the configured steering mode, either relies on the RSS set up when the port
+     * was initialised, or installs rte_flow rules directing packets to queues by UDP destination
+     * port or by the low bits of the frame number at the configured offset in the UDP payload.
+     * Should the device reject the rules, any rules created are removed and packets are left on
+     * the queues chosen by the driver, with frames still distributed in software.
+     *
+     * @param[in] rx_ports List of UDP destination ports packets are received on
+     * @return true if hardware steering is active or not required, false otherwise
+     */
+    bool DpdkDevice::configure_steering(const std::vector<uint16_t>& rx_ports)
+    {
+        hw_steering_ = false;
+
+        if ((rx_steering_ == "none") || (rx_rings_ < 2))
+        {
+            return true;
+        }
+
+        if (rx_steering_ == "rss")
+        {
+            hw_steering_ = rss_enabled_;
+            return hw_steering_;
+        }
+
+        struct rte_flow_item_udp udp_spec;
+        struct rte_flow_item_udp udp_mask;
+        struct rte_flow_item pattern[4];
+        memset(pattern, 0, sizeof(pattern));
+        pattern[0].type = RTE_FLOW_ITEM_TYPE_ETH;
+        pattern[1].type = RTE_FLOW_ITEM_TYPE_IPV4;
+        pattern[2].type = RTE_FLOW_ITEM_TYPE_UDP;
+        pattern[3].type = RTE_FLOW_ITEM_TYPE_END;
+
+        bool flows_ok = true;
+
+        if (rx_steering_ == "flow_udp_port")
+        {
+            // Direct each RX port to a queue, wrapping around the available queues
+            memset(&udp_mask, 0, sizeof(udp_mask));
+            udp_mask.hdr.dst_port = 0xFFFF;
+            pattern[2].mask = &udp_mask;
+
+            for (size_t port_idx = 0; flows_ok && (port_idx < rx_ports.size()); port_idx++)
+            {
+                memset(&udp_spec, 0, sizeof(udp_spec));
+                udp_spec.hdr.dst_port = rte_cpu_to_be_16(rx_ports[port_idx]);
+                pattern[2].spec = &udp_spec;
+
+                struct rte_flow* flow = create_queue_flow(pattern, port_idx % rx_rings_);
+                flows_ok = (flow != NULL);
+            }
+        }
+        else if (rx_steering_ == "flow_frame_number")
+        {
+            // Frame number steering matches the low bits of a single payload byte, so requires
+            // the number of queues to be a power of two
+            if ((rx_rings_ & (rx_rings_ - 1)) != 0)
+            {
+                LOG4CXX_WARN(logger_, "Frame number steering requires a power of two RX queues, "
+                    << rx_rings_ << " configured for device on port " << port_id_
+                );
+                flows_ok = false;
+            }
+
+            uint8_t raw_value;
+            uint8_t raw_mask_value = static_cast<uint8_t>(rx_rings_ - 1);
+            struct rte_flow_item_raw raw_spec;
+            struct rte_flow_item_raw raw_mask;
+            memset(&raw_spec, 0, sizeof(raw_spec));
+            memset(&raw_mask, 0, sizeof(raw_mask));
+
+            raw_spec.relative = 1;
+            raw_spec.offset = steering_field_offset_;
+            raw_spec.length = 1;
+            raw_spec.pattern = &raw_value;
+            raw_mask.relative = 1;
+            raw_mask.offset = -1;
+            raw_mask.length = 0xFFFF;
+            raw_mask.pattern = &raw_mask_value;
+
+            struct rte_flow_item frame_pattern[5];
+            memset(frame_pattern, 0, sizeof(frame_pattern));
+            frame_pattern[0].type = RTE_FLOW_ITEM_TYPE_ETH;
+            frame_pattern[1].type = RTE_FLOW_ITEM_TYPE_IPV4;
+            frame_pattern[2].type = RTE_FLOW_ITEM_TYPE_UDP;
+            frame_pattern[3].type = RTE_FLOW_ITEM_TYPE_RAW;
+            frame_pattern[3].spec = &raw_spec;
+            frame_pattern[3].mask = &raw_mask;
+            frame_pattern[4].type = RTE_FLOW_ITEM_TYPE_END;
+
+            for (uint16_t queue = 0; flows_ok && (queue < rx_rings_); queue++)
+            {
+                raw_value = static_cast<uint8_t>(queue);
+                struct rte_flow* flow = create_queue_flow(frame_pattern, queue);
+                flows_ok = (flow != NULL);
+            }
+        }
+        else
+        {
+            LOG4CXX_ERROR(logger_, "Unknown RX steering mode " << rx_steering_
+                << " for device on port " << port_id_
+            );
+            flows_ok = false;
+        }
+
+        if (!flows_ok)
+        {
+            LOG4CXX_WARN(logger_, "Unable to configure " << rx_steering_
+                << " steering for device on port " << port_id_
+                << ", falling back to software steering"
+            );
+            flush_flows();
+            return false;
+        }
+
+        LOG4CXX_INFO(logger_, "Configured " << rx_steering_ << " steering with "
+            << flows_.size() << " flow rules across " << rx_rings_
+            << " RX queues for device on port " << port_id_
+        );
+        hw_steering_ = true;
+        return true;
+    }
+
+    /**
+     * @brief Creates an ingress flow rule directing matching packets to an RX queue.
+     *
+     * The rule is validated before creation and, if successfully created, recorded so that it
+     * can be removed when the device is stopped.
+     *
+     * @param[in] pattern Flow pattern, terminated by an END item
+     * @param[in] queue RX queue matching packets are directed to
+     * @return pointer to the created flow, or NULL on failure
+     */
+    struct rte_flow* DpdkDevice::create_queue_flow(
+        const struct rte_flow_item* pattern, uint16_t queue
+    )
+    {
+        struct rte_flow_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.ingress = 1;
+
+        struct rte_flow_action_queue queue_action;
+        queue_action.index = queue;
+
+        struct rte_flow_action actions[2];
+        memset(actions, 0, sizeof(actions));
+        actions[0].type = RTE_FLOW_ACTION_TYPE_QUEUE;
+        actions[0].conf = &queue_action;
+        actions[1].type = RTE_FLOW_ACTION_TYPE_END;
+
+        struct rte_flow_error error;
+        memset(&error, 0, sizeof(error));
+
+        struct rte_flow* flow = NULL;
+        int rc = rte_flow_validate(port_id_, &attr, pattern, actions, &error);
+        if (rc == 0)
+        {
+            flow = rte_flow_create(port_id_, &attr, pattern, actions, &error);
+        }
+
+        if (flow == NULL)
+        {
+            LOG4CXX_DEBUG_LEVEL(2, logger_, "Failed to create flow rule to RX queue " << queue
+                << " for device on port " << port_id_
+                << " : " << (error.message ? error.message : "unknown error")
+            );
+        }
+        else
+        {
+            flows_.push_back(flow);
+        }
+
+        return flow;
+    }
+
+    void DpdkDevice::flush_flows(void)
+    {
+        if (flows_.empty())
+        {
+            return;
+        }
+
+        struct rte_flow_error error;
+        for (auto& flow: flows_)
+        {
+            rte_flow_destroy(port_id_, flow, &error);
+        }
+        flows_.clear();
+        hw_steering_ = false;
+    }
+}
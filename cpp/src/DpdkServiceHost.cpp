@@ -0,0 +1,386 @@
+/*
+ * DpdkServiceHost.cpp - hosting of low-rate worker cores as rte_service components.
+ */
+
+#include <algorithm>
+#include <cstring>
+
+#include <rte_cycles.h>
+#include <rte_service.h>
+#include <rte_service_component.h>
+
+#include "DpdkServiceHost.h"
+
+namespace FrameProcessor
+{
+    //! Time to wait for a service to stop running on its service lcore, in milliseconds
+    static const unsigned int service_stop_timeout_ms = 1000;
+
+    //! Constructor for the DpdkServiceHost class.
+    DpdkServiceHost::DpdkServiceHost() :
+        start_cycles_(0),
+        running_(false),
+        logger_(Logger::getLogger("FP.DpdkServiceHost"))
+    {
+    }
+
+    //! Destructor for the DpdkServiceHost class.
+    DpdkServiceHost::~DpdkServiceHost()
+    {
+        stop();
+        for (auto& service : services_)
+        {
+            delete service;
+        }
+    }
+
+    //! Add a worker core to be hosted as a service
+    //!
+    //! \param[in] core - worker core to host, which must support running as a service
+    //! \param[in] name - name of the service component
+    //! \param[in] lcore_index - index of the service lcore to map the core to
+    //!
+    void DpdkServiceHost::add_core(
+        DpdkWorkerCore* core, const std::string& name, const unsigned int lcore_index
+    )
+    {
+        HostedService* service = new HostedService();
+        service->core = core;
+        service->name = name.substr(0, RTE_SERVICE_NAME_MAX - 1);
+        service->lcore_index = lcore_index;
+        service->service_id = 0;
+        service->started = false;
+        service->registered = false;
+        service->idle_calls = 0;
+        services_.push_back(service);
+    }
+
+    //! Start the hosted cores as services on the service lcores
+    //!
+    //! This method starts each hosted core on its service lcore, then registers the cores as
+    //! service components, adds the lcores as service lcores, maps each service to its lcore and
+    //! starts the service lcores.
+    //!
+    //! \param[in] lcore_ids - IDs of the free worker lcores to use as service lcores, one for
+    //!                        each service lcore index
+    //!
+    //! \return true if all the hosted cores were started
+    //!
+    bool DpdkServiceHost::start(const std::vector<int>& lcore_ids)
+    {
+        bool start_ok = true;
+        lcore_ids_ = lcore_ids;
+
+        // Start the hosted cores on their service lcores before the lcores are handed over to
+        // the service framework
+        for (unsigned int lcore_index = 0; lcore_index < lcore_ids_.size(); lcore_index++)
+        {
+            LcoreLaunch launch = { this, lcore_index, true };
+            int launch_err = rte_eal_remote_launch(
+                start_lcore_services, &launch, lcore_ids_[lcore_index]
+            );
+            if (launch_err != 0)
+            {
+                LOG4CXX_ERROR(logger_, "Failed to start services on lcore "
+                    << lcore_ids_[lcore_index] << " : " << strerror(-launch_err)
+                );
+                lcore_ids_.resize(lcore_index);
+                running_ = true;
+                return false;
+            }
+            rte_eal_wait_lcore(lcore_ids_[lcore_index]);
+            start_ok &= launch.ok;
+        }
+
+        // Register the hosted cores that started as service components
+        for (auto& service : services_)
+        {
+            if (!service->started)
+            {
+                continue;
+            }
+
+            struct rte_service_spec service_spec;
+            memset(&service_spec, 0, sizeof(service_spec));
+            snprintf(service_spec.name, sizeof(service_spec.name), "%s", service->name.c_str());
+            service_spec.callback = run_service;
+            service_spec.callback_userdata = service;
+            service_spec.socket_id = rte_lcore_to_socket_id(lcore_ids_[service->lcore_index]);
+
+            int rc = rte_service_component_register(&service_spec, &service->service_id);
+            if (rc != 0)
+            {
+                LOG4CXX_ERROR(logger_, "Failed to register service " << service->name
+                    << " : " << strerror(-rc)
+                );
+                start_ok = false;
+                continue;
+            }
+            service->registered = true;
+
+            rte_service_component_runstate_set(service->service_id, 1);
+            rte_service_set_stats_enable(service->service_id, 1);
+            rte_service_runstate_set(service->service_id, 1);
+        }
+
+        // Add the service lcores, map the services to them and start the lcores running
+        for (auto& lcore_id : lcore_ids_)
+        {
+            int rc = rte_service_lcore_add(lcore_id);
+            if ((rc != 0) && (rc != -EALREADY))
+            {
+                LOG4CXX_ERROR(logger_, "Failed to add service lcore " << lcore_id
+                    << " : " << strerror(-rc)
+                );
+                start_ok = false;
+            }
+        }
+
+        for (auto& service : services_)
+        {
+            if (service->registered)
+            {
+                rte_service_map_lcore_set(
+                    service->service_id, lcore_ids_[service->lcore_index], 1
+                );
+                LOG4CXX_INFO(logger_, "Mapped service " << service->name
+                    << " to service lcore " << lcore_ids_[service->lcore_index]
+                );
+            }
+        }
+
+        for (auto& lcore_id : lcore_ids_)
+        {
+            int rc = rte_service_lcore_start(lcore_id);
+            if (rc != 0)
+            {
+                LOG4CXX_ERROR(logger_, "Failed to start service lcore " << lcore_id
+                    << " : " << strerror(-rc)
+                );
+                start_ok = false;
+            }
+        }
+
+        start_cycles_ = rte_get_tsc_cycles();
+        running_ = true;
+
+        return start_ok;
+    }
+
+    //! Stop the hosted services and release the service lcores
+    //!
+    //! This method stops each service and waits for it to finish its current call, stops the
+    //! service lcores and returns them to the EAL, then stops the hosted cores on the lcores
+    //! they were polled on and unregisters the services.
+    //!
+    void DpdkServiceHost::stop(void)
+    {
+        if (!running_)
+        {
+            return;
+        }
+
+        for (auto& service : services_)
+        {
+            if (service->registered)
+            {
+                rte_service_runstate_set(service->service_id, 0);
+            }
+        }
+
+        for (auto& service : services_)
+        {
+            unsigned int waited_ms = 0;
+            while (service->registered &&
+                (rte_service_may_be_active(service->service_id) == 1) &&
+                (waited_ms < service_stop_timeout_ms))
+            {
+                rte_delay_us_block(1000);
+                waited_ms++;
+            }
+            if (waited_ms >= service_stop_timeout_ms)
+            {
+                LOG4CXX_WARN(logger_, "Service " << service->name << " did not stop running");
+            }
+        }
+
+        for (auto& lcore_id : lcore_ids_)
+        {
+            LOG4CXX_DEBUG(logger_, "Stopping service lcore " << lcore_id);
+            rte_service_lcore_stop(lcore_id);
+            rte_eal_wait_lcore(lcore_id);
+            rte_service_lcore_del(lcore_id);
+        }
+
+        // Stop the hosted cores on the lcores they were polled on
+        for (unsigned int lcore_index = 0; lcore_index < lcore_ids_.size(); lcore_index++)
+        {
+            LcoreLaunch launch = { this, lcore_index, true };
+            if (rte_eal_remote_launch(stop_lcore_services, &launch, lcore_ids_[lcore_index]) == 0)
+            {
+                rte_eal_wait_lcore(lcore_ids_[lcore_index]);
+            }
+            else
+            {
+                LOG4CXX_WARN(logger_, "Stopping services for lcore "
+                    << lcore_ids_[lcore_index] << " on the current thread"
+                );
+                stop_lcore_services(&launch);
+            }
+        }
+
+        for (auto& service : services_)
+        {
+            if (service->registered)
+            {
+                rte_service_component_runstate_set(service->service_id, 0);
+                rte_service_component_unregister(service->service_id);
+                service->registered = false;
+            }
+        }
+
+        running_ = false;
+    }
+
+    //! Get the number of service lcores the hosted cores are mapped to
+    //!
+    //! \return the number of service lcores needed
+    //!
+    unsigned int DpdkServiceHost::get_num_lcores(void) const
+    {
+        unsigned int num_lcores = 0;
+        for (auto& service : services_)
+        {
+            num_lcores = std::max(num_lcores, service->lcore_index + 1);
+        }
+        return num_lcores;
+    }
+
+    //! Get the IDs of the service lcores
+    //!
+    //! \return the service lcore IDs, by service lcore index
+    //!
+    const std::vector<int>& DpdkServiceHost::get_lcore_ids(void) const
+    {
+        return lcore_ids_;
+    }
+
+    //! Check if any worker cores are hosted as services
+    //!
+    //! \return true if no worker cores are hosted
+    //!
+    bool DpdkServiceHost::empty(void) const
+    {
+        return services_.empty();
+    }
+
+    //! Report the service lcores and per-service cycle usage into a status message
+    //!
+    //! This method reports the loops run by each service lcore and, for each service, the calls
+    //! made, the calls which found no work, the cycles spent in the service and the percentage
+    //! of the time since the services started that was spent in the service.
+    //!
+    //! \param[in] status - status message to populate
+    //! \param[in] path - parameter path to report the services under, ending with "/"
+    //!
+    void DpdkServiceHost::status(OdinData::IpcMessage& status, const std::string& path) const
+    {
+        status.set_param(path + "num_lcores", static_cast<unsigned int>(lcore_ids_.size()));
+
+        for (auto& lcore_id : lcore_ids_)
+        {
+            uint64_t loops = 0;
+            rte_service_lcore_attr_get(lcore_id, RTE_SERVICE_LCORE_ATTR_LOOPS, &loops);
+            status.set_param(path + "lcores/" + std::to_string(lcore_id) + "/loops", loops);
+        }
+
+        uint64_t elapsed_cycles = running_ ? (rte_get_tsc_cycles() - start_cycles_) : 0;
+
+        for (auto& service : services_)
+        {
+            if (!service->registered)
+            {
+                continue;
+            }
+
+            uint64_t calls = 0;
+            uint64_t cycles = 0;
+            rte_service_attr_get(service->service_id, RTE_SERVICE_ATTR_CALL_COUNT, &calls);
+            rte_service_attr_get(service->service_id, RTE_SERVICE_ATTR_CYCLES, &cycles);
+
+            std::string service_path = path + "services/" + service->name + "/";
+            status.set_param(service_path + "lcore", lcore_ids_[service->lcore_index]);
+            status.set_param(service_path + "calls", calls);
+            status.set_param(service_path + "idle_calls", service->idle_calls);
+            status.set_param(service_path + "cycles", cycles);
+            status.set_param(service_path + "cycles_per_call", calls ? (cycles / calls) : 0);
+            status.set_param(service_path + "usage_percent",
+                elapsed_cycles ? ((100.0 * cycles) / elapsed_cycles) : 0.0
+            );
+        }
+    }
+
+    //! Service callback polling a hosted worker core
+    //!
+    //! \param[in] service_ptr - pointer to the hosted service
+    //!
+    //! \return 0 if the core did some work, -EAGAIN if it was idle
+    //!
+    int32_t DpdkServiceHost::run_service(void* service_ptr)
+    {
+        HostedService* service = static_cast<HostedService*>(service_ptr);
+        int32_t rc = service->core->service_poll();
+        if (rc == -EAGAIN)
+        {
+            service->idle_calls++;
+        }
+        return rc;
+    }
+
+    //! Start the hosted cores mapped to a service lcore, launched on that lcore
+    //!
+    //! \param[in] launch_ptr - pointer to the launch arguments
+    //!
+    //! \return 0
+    //!
+    int DpdkServiceHost::start_lcore_services(void* launch_ptr)
+    {
+        LcoreLaunch* launch = static_cast<LcoreLaunch*>(launch_ptr);
+        for (auto& service : launch->host->services_)
+        {
+            if (service->lcore_index != launch->lcore_index)
+            {
+                continue;
+            }
+            service->started = service->core->service_start(rte_lcore_id());
+            if (!service->started)
+            {
+                LOG4CXX_ERROR(launch->host->logger_, "Failed to start " << service->name
+                    << " as a service on lcore " << rte_lcore_id()
+                );
+                launch->ok = false;
+            }
+        }
+        return 0;
+    }
+
+    //! Stop the hosted cores mapped to a service lcore, launched on that lcore
+    //!
+    //! \param[in] launch_ptr - pointer to the launch arguments
+    //!
+    //! \return 0
+    //!
+    int DpdkServiceHost::stop_lcore_services(void* launch_ptr)
+    {
+        LcoreLaunch* launch = static_cast<LcoreLaunch*>(launch_ptr);
+        for (auto& service : launch->host->services_)
+        {
+            if ((service->lcore_index == launch->lcore_index) && service->started)
+            {
+                service->core->service_stop();
+                service->started = false;
+            }
+        }
+        return 0;
+    }
+}
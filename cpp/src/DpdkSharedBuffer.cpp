@@ -3,11 +3,18 @@
  *
  * This class implements a shared buffer system for assembling capture data, for instance raw
  * frames, in memory. It abstracts the DPDK memzone implementation in huge pages shared memory.
+ * The buffer may be split into segments, each a separate memzone holding a whole number of
+ * buffers, so that large buffers can be reserved on hosts where the hugepage memory is
+ * fragmented. Each segment is reserved on 1GB pages if possible, falling back to 2MB pages and
+ * then to any page size available.
  *
  * Created on: 05 December 2022
  *     Author: Dominic Banks & Tim Nicholls, STFC Detector Systems Software Group
  */
 
+#include <algorithm>
+#include <stdexcept>
+
 #include <rte_errno.h>
 
 #include "DpdkSharedBuffer.h"
@@ -15,17 +22,26 @@
 #include <iostream>
 namespace FrameProcessor
 {
+    //! Memzone page size flags to try for each segment, in order of preference
+    static const unsigned int segment_page_flags[] = {
+        RTE_MEMZONE_1GB, RTE_MEMZONE_2MB, RTE_MEMZONE_SIZE_HINT_ONLY
+    };
+
     //! Constructor for the DpdkSharedBuffer class.
     //!
-    //! This constructor sets up a shared buffer of a specified total size as a DPDK memzone,
-    //! containing the requested number of buffers and mapped to the specified DPDK NUMI socket ID.
+    //! This constructor sets up a shared buffer of a specified total size as one or more DPDK
+    //! memzones, containing the requested number of buffers and mapped to the specified DPDK NUMA
+    //! socket ID. If the memzones already exist, for instance when created by a primary process,
+    //! they are looked up rather than reserved.
     //!
     //! \param[in] mem_size - total memory size in bytes
     //! \param[in] buffer_size - size of each buffer in the memzone
     //! \param[in] socket_id - ID of the DPDK NUMA socket to create the memzone on
+    //! \param[in] segment_size - maximum size of each memzone segment, 0 for a single segment
     //!
     DpdkSharedBuffer::DpdkSharedBuffer(
-        const std::size_t mem_size, const std::size_t buffer_size, const int socket_id
+        const std::size_t mem_size, const std::size_t buffer_size, const int socket_id,
+        const std::size_t segment_size
     ):
         mem_size_(mem_size),
         buffer_size_(buffer_size),
@@ -37,49 +53,134 @@ namespace FrameProcessor
         num_buffers_ = mem_size_ / (buffer_size_);
         if (!num_buffers_)
         {
-            // TODO - buffer size exceeds memory size - should raise an exception
+            throw std::runtime_error("Shared buffer size is smaller than the frame buffer size");
+        }
+
+        // Calculate the number of buffers in each segment, so that no buffer straddles two
+        // segments, and the number of segments needed
+        buffers_per_segment_ = num_buffers_;
+        if (segment_size > 0)
+        {
+            buffers_per_segment_ = std::min(
+                std::max<std::size_t>(segment_size / buffer_size_, 1), num_buffers_
+            );
         }
+        std::size_t num_segments =
+            (num_buffers_ + buffers_per_segment_ - 1) / buffers_per_segment_;
 
-        // Create the memory zone for the shared memory buffer used to assemble frame packets
         name_ = shared_mem_name_str(socket_id_);
         LOG4CXX_INFO(logger_, "Creating shared memory buffer " << name_
             << " of size " << mem_size_
             << " on socket " << socket_id_
-            << " With " << num_buffers_ << " with size " << buffer_size_ 
+            << " With " << num_buffers_ << " with size " << buffer_size_
+            << " in " << num_segments << " segments"
         );
 
-        // First try to lookup existing memzone
-        memzone_ = rte_memzone_lookup(name_.c_str());
-        if (memzone_ != NULL) {
+        memzones_.resize(num_segments, NULL);
+        segment_addrs_.resize(num_segments, NULL);
+
+        // First try to lookup existing memzones
+        if (rte_memzone_lookup(shared_mem_segment_name_str(socket_id_, 0).c_str()) != NULL)
+        {
+            for (unsigned int segment = 0; segment < num_segments; segment++)
+            {
+                memzones_[segment] =
+                    rte_memzone_lookup(shared_mem_segment_name_str(socket_id_, segment).c_str());
+                if (memzones_[segment] == NULL)
+                {
+                    LOG4CXX_ERROR(logger_, "Existing shared memory buffer " << name_
+                        << " is missing segment " << segment);
+                    throw std::runtime_error("Failed to find shared memory buffer segment");
+                }
+                segment_addrs_[segment] = static_cast<char*>(memzones_[segment]->addr);
+            }
             LOG4CXX_INFO(logger_, "Found existing shared memory buffer " << name_);
             return;
         }
 
-        // If no existing memzone, try to create a new one
-        memzone_ = rte_memzone_reserve(
-            name_.c_str(), mem_size_, socket_id_, RTE_MEMZONE_1GB
-        );
-
-        if (memzone_ == NULL)
+        // If no existing memzones, reserve the segments in turn. DPDK holds the memory lock
+        // for the whole of each reservation, so they cannot be reserved in parallel
+        for (unsigned int segment = 0; segment < num_segments; segment++)
         {
-            LOG4CXX_ERROR(logger_, "Error creating shared memory buffer " << name_
-                        << " on socket " << socket_id_
-                        << " : " << rte_strerror(rte_errno)
-                        << " : " << rte_errno
-                );
-            throw std::runtime_error("Failed to create or find shared memory buffer");
+            int error = 0;
+            memzones_[segment] = reserve_segment(segment, error);
+            if (memzones_[segment] == NULL)
+            {
+                LOG4CXX_ERROR(logger_, "Error creating shared memory buffer " << name_
+                            << " segment " << segment
+                            << " on socket " << socket_id_
+                            << " : " << rte_strerror(error)
+                            << " : " << error
+                    );
+                free_segments();
+                throw std::runtime_error("Failed to create or find shared memory buffer");
+            }
+            segment_addrs_[segment] = static_cast<char*>(memzones_[segment]->addr);
         }
     }
 
     //! Destructor for the DpdkSharedBuffer class.
     //!
-    //! This destructor frees the memzone associated with the shared buffer.
+    //! This destructor frees the memzones associated with the shared buffer.
     //!
     DpdkSharedBuffer::~DpdkSharedBuffer()
     {
         LOG4CXX_DEBUG_LEVEL(2, logger_, "Freeing shared memory buffer " << name_);
-        rte_memzone_free(memzone_);
-        memzone_ = NULL;
+        free_segments();
+    }
+
+    //! Reserve the memzone for a shared buffer segment
+    //!
+    //! This method reserves the memzone for the specified segment, trying each page size in
+    //! order of preference.
+    //!
+    //! \param[in] segment - index of the segment to reserve
+    //! \param[out] error - DPDK error number of the last failed reservation
+    //!
+    //! \return pointer to the reserved memzone, or NULL if all page sizes failed
+    //!
+    const struct rte_memzone* DpdkSharedBuffer::reserve_segment(
+        const unsigned int segment, int& error
+    ) const
+    {
+        std::string segment_name = shared_mem_segment_name_str(socket_id_, segment);
+        std::size_t segment_buffers = std::min(
+            buffers_per_segment_, num_buffers_ - (segment * buffers_per_segment_)
+        );
+        std::size_t segment_size = segment_buffers * buffer_size_;
+
+        for (unsigned int flags : segment_page_flags)
+        {
+            const struct rte_memzone* memzone = rte_memzone_reserve(
+                segment_name.c_str(), segment_size, socket_id_, flags
+            );
+            if (memzone != NULL)
+            {
+                LOG4CXX_DEBUG_LEVEL(1, logger_, "Reserved shared memory buffer segment "
+                    << segment_name << " of size " << segment_size
+                    << " with page size " << memzone->hugepage_sz
+                );
+                return memzone;
+            }
+            error = rte_errno;
+            LOG4CXX_DEBUG_LEVEL(1, logger_, "Failed to reserve shared memory buffer segment "
+                << segment_name << " with memzone flags " << flags << " : " << rte_strerror(error)
+            );
+        }
+        return NULL;
+    }
+
+    //! Free the memzones of all reserved segments
+    void DpdkSharedBuffer::free_segments(void)
+    {
+        for (auto& memzone : memzones_)
+        {
+            if (memzone != NULL)
+            {
+                rte_memzone_free(memzone);
+                memzone = NULL;
+            }
+        }
     }
 
     //! Get the address of the buffer specified by the given buffer index
@@ -93,7 +194,10 @@ namespace FrameProcessor
     //!
     void* DpdkSharedBuffer::get_buffer_address(const unsigned int buffer) const
     {
-        return reinterpret_cast<void *>((char*)memzone_->addr + (buffer * buffer_size_));
+        return reinterpret_cast<void *>(
+            segment_addrs_[buffer / buffers_per_segment_] +
+            ((buffer % buffers_per_segment_) * buffer_size_)
+        );
     }
 
     //! Get the number of buffers in the shared buffer
@@ -128,5 +232,40 @@ namespace FrameProcessor
     {
         return mem_size_;
     }
-}
 
+    //! Get the number of memzone segments in the shared buffer
+    //!
+    //! \return Number of segments in the shared buffer
+    //!
+    const std::size_t DpdkSharedBuffer::get_num_segments(void) const
+    {
+        return memzones_.size();
+    }
+
+    //! Report the shared buffer layout into a status message
+    //!
+    //! This method reports the buffer dimensions and the memzone, size, page size and socket of
+    //! each segment.
+    //!
+    //! \param[in] status - status message to populate
+    //! \param[in] path - parameter path to report the layout under, ending with "/"
+    //!
+    void DpdkSharedBuffer::status(OdinData::IpcMessage& status, const std::string& path) const
+    {
+        status.set_param(path + "num_buffers", num_buffers_);
+        status.set_param(path + "buffer_size", buffer_size_);
+        status.set_param(path + "buffers_per_segment", buffers_per_segment_);
+        status.set_param(path + "num_segments", memzones_.size());
+
+        for (unsigned int segment = 0; segment < memzones_.size(); segment++)
+        {
+            const struct rte_memzone* memzone = memzones_[segment];
+            std::string segment_path = path + "segments/" + std::to_string(segment) + "/";
+
+            status.set_param(segment_path + "name", std::string(memzone->name));
+            status.set_param(segment_path + "size", static_cast<uint64_t>(memzone->len));
+            status.set_param(segment_path + "page_size", static_cast<uint64_t>(memzone->hugepage_sz));
+            status.set_param(segment_path + "socket", static_cast<int>(memzone->socket_id));
+        }
+    }
+}
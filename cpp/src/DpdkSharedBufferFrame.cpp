@@ -1,4 +1,5 @@
 #include "DpdkSharedBufferFrame.h"
+#include "FlightRecorder.h"
 
 namespace FrameProcessor {
 
@@ -8,18 +9,18 @@ namespace FrameProcessor {
  * @param meta_data 
  * @param data_src 
  * @param nbytes 
- * @param frame_processed 
+ * @param buffer_pool pool to release the buffer to on destruction
  * @param image_offset 
  */
 DpdkSharedBufferFrame::DpdkSharedBufferFrame(const FrameMetaData & meta_data,
                                                 void *data_src,
                                                 size_t nbytes,
-                                                rte_ring *frame_processed,
+                                                DpdkBufferPool *buffer_pool,
                                                 const int& image_offset)
     : Frame(meta_data, nbytes, image_offset) {
     
     data_ptr_ = data_src;
-    frame_processed_ = frame_processed;
+    buffer_pool_ = buffer_pool;
 }
 
 /** Copy constructor;
@@ -30,7 +31,7 @@ DpdkSharedBufferFrame::DpdkSharedBufferFrame(const DpdkSharedBufferFrame &frame)
 {
     data_ptr_ = frame.data_ptr_;
     data_size_ = frame.data_size_;
-    frame_processed_ = frame.frame_processed_;
+    buffer_pool_ = frame.buffer_pool_;
 }
 
 /**
@@ -38,10 +39,11 @@ DpdkSharedBufferFrame::DpdkSharedBufferFrame(const DpdkSharedBufferFrame &frame)
  * 
  */
 DpdkSharedBufferFrame::~DpdkSharedBufferFrame () {
-    /** Enqueue the memory location back to the starting ring */
-    if(frame_processed_ != nullptr)
+    /** Release the memory location back to the buffer pool */
+    if(buffer_pool_ != nullptr)
     {
-        rte_ring_enqueue(frame_processed_, data_ptr_);
+        FlightRecorder::record_release(get_frame_number());
+        buffer_pool_->release(data_ptr_);
     }
 }
 
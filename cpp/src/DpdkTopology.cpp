@@ -0,0 +1,256 @@
+/*
+ * DpdkTopology.cpp - NUMA and CPU topology used to place worker cores and their resources.
+ *
+ * The CPU topology of each worker lcore is read from sysfs when the topology is created, after
+ * the EAL has been initialised. Where sysfs is unavailable, each CPU is treated as its own
+ * physical core and L3 domain, so lcore selection falls back to socket-only placement.
+ */
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+#include <rte_ethdev.h>
+
+#include "DpdkTopology.h"
+
+namespace FrameProcessor
+{
+    //! Read an integer value from a sysfs file
+    //!
+    //! \param[in] path - path of the sysfs file
+    //! \param[in] default_value - value to return if the file cannot be read
+    //!
+    //! \return the integer value read from the file, or the default value
+    //!
+    static int read_sysfs_int(const std::string& path, const int default_value)
+    {
+        std::ifstream sysfs_file(path);
+        int value;
+        if (!(sysfs_file >> value))
+        {
+            return default_value;
+        }
+        return value;
+    }
+
+    //! Constructor for the DpdkTopology class.
+    //!
+    //! This constructor builds the topology of all DPDK worker lcores, ordered by socket, L3
+    //! domain and physical core, so that lcores selected in turn for a worker chain are packed
+    //! into the same L3 domain on distinct physical cores.
+    //!
+    DpdkTopology::DpdkTopology() :
+        num_sockets_(rte_socket_count()),
+        logger_(Logger::getLogger("FP.DpdkTopology"))
+    {
+        unsigned int lcore_id;
+        RTE_LCORE_FOREACH_WORKER(lcore_id)
+        {
+            LcoreTopology lcore;
+            lcore.lcore_id = lcore_id;
+            lcore.cpu_id = rte_lcore_to_cpu_id(lcore_id);
+            lcore.socket_id = rte_lcore_to_socket_id(lcore_id);
+
+            std::stringstream cpu_path;
+            cpu_path << "/sys/devices/system/cpu/cpu" << lcore.cpu_id << "/";
+            lcore.core_id = read_sysfs_int(cpu_path.str() + "topology/core_id", lcore.cpu_id);
+            lcore.package_id = read_sysfs_int(
+                cpu_path.str() + "topology/physical_package_id", lcore.socket_id
+            );
+            lcore.l3_id = read_sysfs_int(cpu_path.str() + "cache/index3/id", -1);
+
+            LOG4CXX_INFO(logger_, "  DPDK lcore " << lcore.lcore_id
+                << " -> cpu " << lcore.cpu_id
+                << " socket " << lcore.socket_id
+                << " package " << lcore.package_id
+                << " core " << lcore.core_id
+                << " L3 " << lcore.l3_id
+            );
+            lcores_.push_back(lcore);
+        }
+
+        std::stable_sort(lcores_.begin(), lcores_.end(),
+            [](const LcoreTopology& a, const LcoreTopology& b)
+            {
+                if (a.socket_id != b.socket_id) return a.socket_id < b.socket_id;
+                if (a.l3_id != b.l3_id) return a.l3_id < b.l3_id;
+                if (a.package_id != b.package_id) return a.package_id < b.package_id;
+                if (a.core_id != b.core_id) return a.core_id < b.core_id;
+                return a.cpu_id < b.cpu_id;
+            }
+        );
+    }
+
+    //! Get the NUMA socket a network device is attached to
+    //!
+    //! This method returns the socket of the specified device. If the device has already been
+    //! probed by DPDK, for instance from the EAL allow list, the socket is taken from the ethdev
+    //! port, otherwise PCI devices are resolved through sysfs before they are hot plugged.
+    //!
+    //! \param[in] device_name - PCI address or DPDK device name of the device
+    //!
+    //! \return the socket ID of the device, or SOCKET_ID_ANY if unknown
+    //!
+    int DpdkTopology::device_socket(const std::string& device_name)
+    {
+        uint16_t port_id;
+        if (rte_eth_dev_get_port_by_name(device_name.c_str(), &port_id) == 0)
+        {
+            int socket_id = rte_eth_dev_socket_id(port_id);
+            return (socket_id >= 0) ? socket_id : SOCKET_ID_ANY;
+        }
+
+        // Virtual devices, e.g. net_null or net_ring, have no NUMA affinity
+        if (device_name.rfind("net_", 0) == 0)
+        {
+            return SOCKET_ID_ANY;
+        }
+
+        int socket_id = read_sysfs_int(
+            "/sys/bus/pci/devices/" + device_name + "/numa_node", SOCKET_ID_ANY
+        );
+        return (socket_id >= 0) ? socket_id : SOCKET_ID_ANY;
+    }
+
+    //! Get the number of NUMA sockets
+    //!
+    //! \return The number of NUMA sockets detected by DPDK
+    //!
+    unsigned int DpdkTopology::get_num_sockets(void) const
+    {
+        return num_sockets_;
+    }
+
+    //! Check if an lcore is a DPDK worker lcore available for worker cores
+    //!
+    //! \param[in] lcore_id - ID of the lcore to check
+    //!
+    //! \return true if the lcore is a worker lcore
+    //!
+    bool DpdkTopology::is_worker_lcore(const int lcore_id) const
+    {
+        return find_lcore(lcore_id) != NULL;
+    }
+
+    //! Get the NUMA socket of a worker lcore
+    //!
+    //! \param[in] lcore_id - ID of the lcore
+    //!
+    //! \return the socket ID of the lcore, or SOCKET_ID_ANY if it is not a worker lcore
+    //!
+    int DpdkTopology::lcore_socket(const int lcore_id) const
+    {
+        const LcoreTopology* lcore = find_lcore(lcore_id);
+        return (lcore != NULL) ? lcore->socket_id : SOCKET_ID_ANY;
+    }
+
+    //! Select an unused worker lcore for a worker core
+    //!
+    //! This method selects the first unused worker lcore on the requested socket, in topology
+    //! order. If SMT exclusive placement is requested, lcores whose physical core is already
+    //! running a worker core are skipped unless no other lcore is available on the socket.
+    //!
+    //! \param[in] socket_id - socket to select an lcore on, or SOCKET_ID_ANY for any socket
+    //! \param[in] used_lcores - lcores already running worker cores
+    //! \param[in] smt_exclusive - avoid lcores sharing a physical core with a used lcore
+    //!
+    //! \return the selected lcore ID, or RTE_MAX_LCORE if no lcore is available
+    //!
+    int DpdkTopology::select_lcore(
+        const int socket_id, const std::vector<int>& used_lcores, const bool smt_exclusive
+    ) const
+    {
+        int shared_lcore_id = RTE_MAX_LCORE;
+
+        for (auto& lcore : lcores_)
+        {
+            if (((socket_id != SOCKET_ID_ANY) && (lcore.socket_id != socket_id)) ||
+                (std::find(used_lcores.begin(), used_lcores.end(), lcore.lcore_id) !=
+                    used_lcores.end()))
+            {
+                continue;
+            }
+
+            if (!smt_exclusive || !shares_physical_core(lcore, used_lcores))
+            {
+                return lcore.lcore_id;
+            }
+
+            if (shared_lcore_id == RTE_MAX_LCORE)
+            {
+                shared_lcore_id = lcore.lcore_id;
+            }
+        }
+
+        if (shared_lcore_id != RTE_MAX_LCORE)
+        {
+            LOG4CXX_WARN(logger_, "No free physical core on socket " << socket_id
+                << ", selecting lcore " << shared_lcore_id << " sharing an SMT sibling"
+            );
+        }
+        return shared_lcore_id;
+    }
+
+    //! Report the placement of worker lcores into a status message
+    //!
+    //! This method reports the CPU, socket, physical core and L3 domain of each used lcore.
+    //!
+    //! \param[in] status - status message to populate
+    //! \param[in] path - parameter path to report the topology under, ending with "/"
+    //! \param[in] used_lcores - lcores running worker cores
+    //!
+    void DpdkTopology::status(
+        OdinData::IpcMessage& status, const std::string& path,
+        const std::vector<int>& used_lcores
+    ) const
+    {
+        status.set_param(path + "num_sockets", num_sockets_);
+        status.set_param(path + "num_worker_lcores", static_cast<unsigned int>(lcores_.size()));
+
+        for (auto& lcore_id : used_lcores)
+        {
+            const LcoreTopology* lcore = find_lcore(lcore_id);
+            if (lcore == NULL)
+            {
+                continue;
+            }
+            std::string lcore_path = path + "lcores/" + std::to_string(lcore_id) + "/";
+            status.set_param(lcore_path + "cpu", lcore->cpu_id);
+            status.set_param(lcore_path + "socket", lcore->socket_id);
+            status.set_param(lcore_path + "core", lcore->core_id);
+            status.set_param(lcore_path + "l3", lcore->l3_id);
+            status.set_param(lcore_path + "smt_shared", shares_physical_core(*lcore, used_lcores));
+        }
+    }
+
+    //! Find the topology of a worker lcore
+    const DpdkTopology::LcoreTopology* DpdkTopology::find_lcore(const int lcore_id) const
+    {
+        for (auto& lcore : lcores_)
+        {
+            if (lcore.lcore_id == lcore_id)
+            {
+                return &lcore;
+            }
+        }
+        return NULL;
+    }
+
+    //! Check if an lcore shares its physical core with any other used lcore
+    bool DpdkTopology::shares_physical_core(
+        const LcoreTopology& lcore, const std::vector<int>& used_lcores
+    ) const
+    {
+        for (auto& used_id : used_lcores)
+        {
+            const LcoreTopology* used = find_lcore(used_id);
+            if ((used != NULL) && (used->lcore_id != lcore.lcore_id) &&
+                (used->package_id == lcore.package_id) && (used->core_id == lcore.core_id))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+}
@@ -56,6 +56,15 @@ namespace FrameProcessor
         return ss.str();
     }
 
+    std::string mbuf_header_pool_name_str(unsigned int socket_idx)
+    {
+        std::stringstream ss;
+
+        ss << boost::format("mbuf_hdr_pool_%02u") % socket_idx;
+
+        return ss.str();
+    }
+
     std::string ring_name_str(std::string UpStreamCore, unsigned int socket_idx, unsigned int core_idx)
     {
         std::stringstream ss;
@@ -65,6 +74,15 @@ namespace FrameProcessor
         return ss.str();
     }
 
+    std::string shared_ring_name_str(std::string core_name, unsigned int socket_idx)
+    {
+        std::stringstream ss;
+
+        ss << boost::format("%s_shared_%u") % core_name % socket_idx;
+
+        return ss.str();
+    }
+
     std::string ring_name_pkt_release(unsigned int socket_idx)
     {
         std::stringstream ss;
@@ -74,11 +92,11 @@ namespace FrameProcessor
         return ss.str();
     }
 
-    std::string ring_name_clear_frames(unsigned int socket_idx)
+    std::string buffer_pool_name_str(unsigned int socket_idx)
     {
         std::stringstream ss;
 
-        ss << boost::format("clear_frames_%u") % socket_idx;
+        ss << boost::format("buffer_pool_%u") % socket_idx;
 
         return ss.str();
     }
@@ -92,6 +110,24 @@ namespace FrameProcessor
         return ss.str();
     }
 
+    std::string shared_mem_segment_name_str(unsigned int socket_idx, unsigned int segment_idx)
+    {
+        std::stringstream ss;
+
+        ss << boost::format("smb_%02u_%03u") % socket_idx % segment_idx;
+
+        return ss.str();
+    }
+
+    std::string rx_frame_latch_name_str(unsigned int socket_idx)
+    {
+        std::stringstream ss;
+
+        ss << boost::format("rx_frame_latch_%u") % socket_idx;
+
+        return ss.str();
+    }
+
     std::vector<uint16_t> tokenize_port_list(const std::string& port_list_str)
     {
 
@@ -0,0 +1,508 @@
+/*
+ * FlightRecorder.cpp - per-lcore record of the path each frame takes through the worker cores.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+#include <rte_common.h>
+#include <rte_lcore.h>
+#include <rte_malloc.h>
+#include <rte_spinlock.h>
+
+#include <log4cxx/logger.h>
+using namespace log4cxx;
+using namespace log4cxx::helpers;
+#include <DebugLevelLogger.h>
+
+#include "FlightRecorder.h"
+
+namespace FrameProcessor
+{
+    //! Maximum number of dumps written on frame loss before drop dumps are disarmed
+    static const unsigned int max_loss_dumps = 10;
+
+    //! Time allowed for lcores to finish writing an event after recording is paused for a dump
+    static const std::chrono::milliseconds dump_pause_time(1);
+
+    //! Thread ID used in traces for the shared release recorder
+    static const unsigned int release_thread_id = RTE_MAX_LCORE;
+
+    //! Names of the stages, as used in traces
+    static const char* stage_names[FlightRecorder::num_stages] = {
+        "rx", "process", "build", "compress", "wrap", "access", "release"
+    };
+
+    //! Names of the events, as used in traces
+    static const char* event_names[FlightRecorder::num_events] = {
+        "first_packet", "dequeued", "begin", "enqueued", "end", "incomplete", "dropped",
+        "released"
+    };
+
+    //! Recorder settings, which must be accessed with the registry lock held
+    struct RecorderSettings
+    {
+        unsigned int size;              //!< Number of events held by each recorder
+        std::string loss_dump_file;     //!< Prefix of dumps written on frame loss, empty for none
+        unsigned int loss_dumps;        //!< Number of dumps written on frame loss
+        std::string last_dump_file;     //!< Name of the last dump written
+    };
+
+    std::atomic<bool> FlightRecorder::enabled_(false);
+
+    //! Dump on frame loss armed, read by the lcores without the registry lock
+    static std::atomic<bool> loss_dump_armed(false);
+
+    //! Dump on frame loss in progress
+    static std::atomic<bool> loss_dump_pending(false);
+
+    //! Shared recorder for frames released by the plugin chain, created on configuration
+    static std::atomic<FlightRecorder*> release_recorder(NULL);
+
+    //! Lock serialising writes to the shared release recorder
+    static rte_spinlock_t release_lock = RTE_SPINLOCK_INITIALIZER;
+
+    //! Get the lock protecting the registry of recorders and the recorder settings
+    static std::mutex& registry_mutex(void)
+    {
+        static std::mutex mutex;
+        return mutex;
+    }
+
+    //! Get the registry of recorders, which must be accessed with the registry lock held
+    static std::vector<FlightRecorder*>& registry(void)
+    {
+        static std::vector<FlightRecorder*> recorders;
+        return recorders;
+    }
+
+    //! Get the recorder settings, which must be accessed with the registry lock held
+    static RecorderSettings& settings(void)
+    {
+        static RecorderSettings recorder_settings = { 65536, "", 0, "" };
+        return recorder_settings;
+    }
+
+    //! Get the logger shared by the recorders
+    static LoggerPtr& recorder_logger(void)
+    {
+        static LoggerPtr logger(Logger::getLogger("FP.FlightRecorder"));
+        return logger;
+    }
+
+    //! Constructor for the FlightRecorder class
+    //!
+    //! The ring is allocated with the size configured when the recorder is created, and is left
+    //! unallocated if the configured size is zero.
+    //!
+    //! \param[in] name - name of the recorder, shown as the thread name in traces
+    //! \param[in] socket_id - NUMA socket to allocate the ring on
+    //!
+    FlightRecorder::FlightRecorder(const std::string& name, const int socket_id) :
+        name_(name),
+        lcore_id_(LCORE_ID_ANY),
+        records_(NULL),
+        mask_(0),
+        head_(0)
+    {
+        std::lock_guard<std::mutex> lock(registry_mutex());
+
+        uint64_t size = settings().size;
+        if (size > 0)
+        {
+            size = rte_align64pow2(size);
+            records_ = static_cast<Record*>(rte_zmalloc_socket(
+                ("flight_" + name_).c_str(), size * sizeof(Record), RTE_CACHE_LINE_SIZE,
+                socket_id
+            ));
+            if (records_ == NULL)
+            {
+                LOG4CXX_WARN(recorder_logger(), "Unable to allocate " << size
+                    << " event flight recorder for " << name_
+                );
+            }
+            mask_ = size - 1;
+        }
+
+        registry().push_back(this);
+    }
+
+    //! Destructor for the FlightRecorder class
+    FlightRecorder::~FlightRecorder()
+    {
+        std::lock_guard<std::mutex> lock(registry_mutex());
+
+        std::vector<FlightRecorder*>& recorders = registry();
+        recorders.erase(std::remove(recorders.begin(), recorders.end(), this), recorders.end());
+
+        if (records_ != NULL)
+        {
+            rte_free(records_);
+        }
+    }
+
+    //! Bind the recorder to the calling lcore, which is the only one to write to it
+    void FlightRecorder::start(void)
+    {
+        lcore_id_ = rte_lcore_id();
+    }
+
+    //! Configure the flight recorders
+    //!
+    //! The ring size only applies to recorders created after this call, so this is called by the
+    //! core manager before the worker cores are created. The shared release recorder is created
+    //! on the first call.
+    //!
+    //! \param[in] enable - record events
+    //! \param[in] size - number of events held by each recorder, rounded up to a power of two
+    //! \param[in] loss_dump_file - prefix of the dumps written on frame loss, empty for none
+    //!
+    void FlightRecorder::configure(
+        const bool enable, const unsigned int size, const std::string& loss_dump_file
+    )
+    {
+        {
+            std::lock_guard<std::mutex> lock(registry_mutex());
+            settings().size = size;
+        }
+
+        if (release_recorder.load() == NULL)
+        {
+            FlightRecorder* recorder = new FlightRecorder("frame_release", SOCKET_ID_ANY);
+            recorder->lcore_id_ = release_thread_id;
+            release_recorder.store(recorder);
+        }
+
+        set_loss_dump_file(loss_dump_file);
+        FlightRecorder::enable(enable);
+    }
+
+    //! Enable or disable recording in every recorder
+    //!
+    //! \param[in] enable - record events
+    //!
+    void FlightRecorder::enable(const bool enable)
+    {
+        std::lock_guard<std::mutex> lock(registry_mutex());
+        if (enable != enabled_.load())
+        {
+            LOG4CXX_INFO(recorder_logger(), (enable ? "Enabling" : "Disabling")
+                << " frame flight recorders"
+            );
+        }
+        enabled_.store(enable);
+    }
+
+    //! Check if recording is enabled
+    //!
+    //! \return true if events are being recorded
+    //!
+    bool FlightRecorder::enabled(void)
+    {
+        return enabled_.load();
+    }
+
+    //! Set the prefix of the dumps written when a frame is dropped or incomplete
+    //!
+    //! Each dump is written to <prefix>_<n>.json. Setting the prefix rearms the dumps if the
+    //! maximum number of them has been written.
+    //!
+    //! \param[in] loss_dump_file - prefix of the dump files, empty to disable dumps on frame loss
+    //!
+    void FlightRecorder::set_loss_dump_file(const std::string& loss_dump_file)
+    {
+        std::lock_guard<std::mutex> lock(registry_mutex());
+        settings().loss_dump_file = loss_dump_file;
+        settings().loss_dumps = 0;
+        loss_dump_armed.store(!loss_dump_file.empty());
+    }
+
+    //! Dump every recorder to a Chrome trace event JSON file
+    //!
+    //! Recording is paused while the rings are read and then restored.
+    //!
+    //! \param[in] file_name - name of the trace file to write
+    //!
+    //! \return true if the trace was written
+    //!
+    bool FlightRecorder::dump(const std::string& file_name)
+    {
+        std::lock_guard<std::mutex> lock(registry_mutex());
+
+        // Pause recording and allow any event being written to complete
+        bool was_enabled = enabled_.exchange(false);
+        std::this_thread::sleep_for(dump_pause_time);
+
+        std::ofstream trace(file_name.c_str(), std::ios::out | std::ios::trunc);
+        if (!trace.is_open())
+        {
+            LOG4CXX_ERROR(recorder_logger(), "Unable to open flight recorder dump " << file_name);
+            enabled_.store(was_enabled);
+            return false;
+        }
+
+        // Trace timestamps are relative to the oldest event held by any recorder
+        uint64_t base_tsc = UINT64_MAX;
+        for (auto& recorder : registry())
+        {
+            base_tsc = std::min(base_tsc, recorder->first_tsc());
+        }
+
+        trace << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[" << std::endl;
+        trace << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << getpid()
+            << ",\"args\":{\"name\":\"odin-data DPDK\"}}";
+        for (auto& recorder : registry())
+        {
+            recorder->write_trace(trace, base_tsc);
+        }
+        trace << std::endl << "]}" << std::endl;
+        trace.close();
+
+        enabled_.store(was_enabled);
+        settings().last_dump_file = file_name;
+
+        if (trace.fail())
+        {
+            LOG4CXX_ERROR(recorder_logger(), "Error writing flight recorder dump " << file_name);
+            return false;
+        }
+
+        LOG4CXX_INFO(recorder_logger(), "Wrote flight recorder dump " << file_name);
+        return true;
+    }
+
+    //! Report the flight recorder settings in the status
+    //!
+    //! \param[out] status - status message to add the settings to
+    //! \param[in] path - path to report the settings under, ending with "/"
+    //!
+    void FlightRecorder::status(OdinData::IpcMessage& status, const std::string& path)
+    {
+        std::lock_guard<std::mutex> lock(registry_mutex());
+
+        status.set_param(path + "enabled", enabled_.load());
+        status.set_param(path + "size", settings().size);
+        status.set_param(path + "recorders", static_cast<unsigned int>(registry().size()));
+        status.set_param(path + "loss_dump_file", settings().loss_dump_file);
+        status.set_param(path + "loss_dumps", settings().loss_dumps);
+        status.set_param(path + "last_dump_file", settings().last_dump_file);
+    }
+
+    //! Get the name of a stage
+    //!
+    //! \param[in] stage - stage index
+    //!
+    //! \return the stage name, as used in traces
+    //!
+    const char* FlightRecorder::stage_name(const unsigned int stage)
+    {
+        return (stage < num_stages) ? stage_names[stage] : "unknown";
+    }
+
+    //! Get the name of an event
+    //!
+    //! \param[in] event - event index
+    //!
+    //! \return the event name, as used in traces
+    //!
+    const char* FlightRecorder::event_name(const unsigned int event)
+    {
+        return (event < num_events) ? event_names[event] : "unknown";
+    }
+
+    //! Write the release of a frame into the shared release recorder
+    //!
+    //! \param[in] tsc - TSC cycle count of the release
+    //! \param[in] frame_number - super frame number of the frame
+    //!
+    void FlightRecorder::write_release(const uint64_t tsc, const uint64_t frame_number)
+    {
+        FlightRecorder* recorder = release_recorder.load(std::memory_order_acquire);
+        if (recorder != NULL)
+        {
+            rte_spinlock_lock(&release_lock);
+            recorder->write(tsc, frame_number, release, released);
+            rte_spinlock_unlock(&release_lock);
+        }
+    }
+
+    //! Start a dump on frame loss, unless one is already in progress or dumps are not armed
+    //!
+    //! The dump is written by a separate thread, so that the lcore losing the frame is not held
+    //! up writing the file.
+    //!
+    void FlightRecorder::dump_on_loss(void)
+    {
+        if (loss_dump_armed.load(std::memory_order_relaxed) &&
+            !loss_dump_pending.exchange(true))
+        {
+            std::thread(&FlightRecorder::dump_loss_thread).detach();
+        }
+    }
+
+    //! Write a dump on frame loss, disarming the dumps once the maximum number are written
+    void FlightRecorder::dump_loss_thread(void)
+    {
+        std::string file_name;
+        {
+            std::lock_guard<std::mutex> lock(registry_mutex());
+            RecorderSettings& recorder_settings = settings();
+            if (recorder_settings.loss_dump_file.empty() ||
+                (recorder_settings.loss_dumps >= max_loss_dumps))
+            {
+                loss_dump_armed.store(false);
+                loss_dump_pending.store(false);
+                return;
+            }
+            file_name = recorder_settings.loss_dump_file + "_" +
+                std::to_string(recorder_settings.loss_dumps++) + ".json";
+            if (recorder_settings.loss_dumps >= max_loss_dumps)
+            {
+                LOG4CXX_WARN(recorder_logger(), "Written " << max_loss_dumps
+                    << " flight recorder dumps on frame loss, disarming further dumps"
+                );
+                loss_dump_armed.store(false);
+            }
+        }
+
+        LOG4CXX_INFO(recorder_logger(), "Frame lost, dumping flight recorders");
+        dump(file_name);
+        loss_dump_pending.store(false);
+    }
+
+    //! Get the TSC cycle count of the oldest event held by the recorder
+    //!
+    //! \return the cycle count, or UINT64_MAX if the recorder holds no events
+    //!
+    uint64_t FlightRecorder::first_tsc(void) const
+    {
+        uint64_t head = head_.load(std::memory_order_acquire);
+        if ((records_ == NULL) || (head == 0))
+        {
+            return UINT64_MAX;
+        }
+        uint64_t oldest = (head > (mask_ + 1)) ? (head - (mask_ + 1)) : 0;
+        return records_[oldest & mask_].tsc;
+    }
+
+    //! Write the events held by the recorder as Chrome trace events
+    //!
+    //! The begin and end of a stage are written as a slice on the thread of the lcore, except
+    //! for frame assembly, which is written as an asynchronous slice. Every other event is
+    //! written as an instant event. A frame passed on or received by a stage, and the first
+    //! packet of a frame reaching the packet processor, are also written as flow events keyed by
+    //! frame number, which join the hand over of the frame between lcores.
+    //!
+    //! \param[in] trace - stream to write the events to
+    //! \param[in] base_tsc - TSC cycle count of the start of the trace
+    //!
+    void FlightRecorder::write_trace(std::ostream& trace, const uint64_t base_tsc) const
+    {
+        uint64_t head = head_.load(std::memory_order_acquire);
+        if ((records_ == NULL) || (head == 0))
+        {
+            return;
+        }
+
+        const double us_per_cycle = 1.0e6 / rte_get_tsc_hz();
+        const pid_t pid = getpid();
+
+        trace << std::fixed << std::setprecision(3);
+        trace << "," << std::endl << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << pid
+            << ",\"tid\":" << lcore_id_ << ",\"args\":{\"name\":\"" << name_ << "\"}}";
+
+        // Begin of the slice open in each stage
+        uint64_t begin_tsc[num_stages] = { 0 };
+        uint32_t begin_frame[num_stages] = { 0 };
+        bool begin_open[num_stages] = { false };
+
+        auto write_event = [&](const char* name, const char* cat, const char* phase,
+            const uint64_t tsc, const uint32_t frame_number, const char* extra)
+        {
+            trace << "," << std::endl << "{\"name\":\"" << name << "\",\"cat\":\"" << cat
+                << "\",\"ph\":\"" << phase << "\",\"pid\":" << pid << ",\"tid\":" << lcore_id_
+                << ",\"ts\":" << (tsc - base_tsc) * us_per_cycle << extra
+                << ",\"args\":{\"frame\":" << frame_number << "}}";
+        };
+
+        uint64_t oldest = (head > (mask_ + 1)) ? (head - (mask_ + 1)) : 0;
+        for (uint64_t idx = oldest; idx < head; idx++)
+        {
+            const Record& record = records_[idx & mask_];
+            if ((record.stage >= num_stages) || (record.event >= num_events))
+            {
+                continue;
+            }
+
+            const char* stage = stage_names[record.stage];
+            const std::string flow_id = ",\"id\":" + std::to_string(record.frame_number);
+            bool assembly = (record.stage == process);
+
+            switch (record.event)
+            {
+                case begin:
+                    if (assembly)
+                    {
+                        write_event("assemble", stage, "b", record.tsc, record.frame_number,
+                            flow_id.c_str());
+                        write_event("frame", "frame", "f", record.tsc, record.frame_number,
+                            flow_id.c_str());
+                    }
+                    else
+                    {
+                        begin_tsc[record.stage] = record.tsc;
+                        begin_frame[record.stage] = record.frame_number;
+                        begin_open[record.stage] = true;
+                    }
+                    break;
+
+                case end:
+                    if (assembly)
+                    {
+                        write_event("assemble", stage, "e", record.tsc, record.frame_number,
+                            flow_id.c_str());
+                    }
+                    else if (begin_open[record.stage] &&
+                        (begin_frame[record.stage] == record.frame_number))
+                    {
+                        std::ostringstream duration;
+                        duration << std::fixed << std::setprecision(3) << ",\"dur\":"
+                            << (record.tsc - begin_tsc[record.stage]) * us_per_cycle;
+                        write_event(stage, stage, "X", begin_tsc[record.stage],
+                            record.frame_number, duration.str().c_str());
+                        begin_open[record.stage] = false;
+                    }
+                    break;
+
+                default:
+                    write_event(event_names[record.event], stage, "i", record.tsc,
+                        record.frame_number, ",\"s\":\"t\"");
+
+                    if ((record.event == first_packet) || (record.event == enqueued))
+                    {
+                        write_event("frame", "frame", "s", record.tsc, record.frame_number,
+                            (flow_id + ",\"bp\":\"e\"").c_str());
+                    }
+                    else if ((record.event == dequeued) || (record.event == released))
+                    {
+                        write_event("frame", "frame", "f", record.tsc, record.frame_number,
+                            flow_id.c_str());
+                    }
+                    else if (assembly && (record.event == incomplete))
+                    {
+                        write_event("assemble", stage, "e", record.tsc, record.frame_number,
+                            flow_id.c_str());
+                    }
+                    break;
+            }
+        }
+    }
+}
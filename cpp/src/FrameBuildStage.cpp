@@ -0,0 +1,175 @@
+#include "FrameBuildStage.h"
+
+#include <cstring>
+
+#include <rte_memcpy.h>
+
+namespace FrameProcessor
+{
+    //! Constructor for the FrameBuildStage class
+    //!
+    //! \param[in] decoder - packet protocol decoder for the super frame layout
+    //! \param[in] buffer_pool - pool to acquire the spare frame buffer from
+    //!
+    FrameBuildStage::FrameBuildStage(PacketProtocolDecoder* decoder, DpdkBufferPool* buffer_pool) :
+        decoder_(decoder),
+        buffer_pool_(buffer_pool),
+        reordered_frame_(NULL),
+        frame_size_(
+            decoder->get_frame_x_resolution() * decoder->get_frame_y_resolution() *
+            get_size_from_enum(decoder->get_frame_bit_depth())
+        ),
+        payload_size_(decoder->get_payload_size()),
+        zero_fill_(true)
+    {
+    }
+
+    //! Acquire the spare frame buffer to build the first frame into
+    //!
+    //! \return true if the spare buffer has been acquired
+    //!
+    bool FrameBuildStage::start(void)
+    {
+        if (reordered_frame_ == NULL)
+        {
+            reordered_frame_ = static_cast<SuperFrameHeader*>(buffer_pool_->acquire());
+        }
+        return reordered_frame_ != NULL;
+    }
+
+    //! Build a super frame
+    //!
+    //! \param[in] frame - pointer to the super frame as received
+    //! \param[in] frame_number - super frame number of the frame
+    //!
+    //! \return pointer to the built frame
+    //!
+    SuperFrameHeader* FrameBuildStage::process(SuperFrameHeader* frame, const uint64_t frame_number)
+    {
+        // If a superframe has any incomplete frames, clear the payload of their dropped packets
+        if (zero_fill_ && (decoder_->get_super_frame_frames_received(frame) <
+            decoder_->get_frame_outer_chunk_size()))
+        {
+            clear_dropped_packets(frame);
+        }
+
+        // Read the completion time before the frame is reordered, as the decoder may
+        // build into a buffer without copying the super frame header
+        uint64_t complete_cycles = decoder_->get_super_frame_complete_time(frame);
+
+        // Use the decoder to build that frame into another HP location
+        SuperFrameHeader* built_frame = decoder_->reorder_frame(frame, reordered_frame_);
+
+        // Carry the frame headers over to a frame built into the spare buffer, so the packet
+        // state of each frame reaches the wrapper rather than that of an earlier frame
+        if (built_frame != frame)
+        {
+            const std::size_t super_frame_header_size = decoder_->get_super_frame_header_size();
+            rte_memcpy(
+                reinterpret_cast<char*>(built_frame) + super_frame_header_size,
+                reinterpret_cast<char*>(frame) + super_frame_header_size,
+                decoder_->get_image_data_offset() - super_frame_header_size
+            );
+        }
+
+        decoder_->set_super_frame_image_size(
+            built_frame, frame_size_ * decoder_->get_frame_outer_chunk_size()
+        );
+
+        // Stamp the built time for the downstream stages and record the build latency
+        uint64_t built_cycles = rte_get_tsc_cycles();
+        decoder_->set_super_frame_built_time(built_frame, built_cycles);
+        complete_to_built_.record(built_cycles - complete_cycles);
+
+        // If the frame was built into the spare buffer, the received buffer becomes the spare
+        if (built_frame == reordered_frame_)
+        {
+            reordered_frame_ = frame;
+        }
+
+        return built_frame;
+    }
+
+    //! Return the spare frame buffer to the pool
+    void FrameBuildStage::stop(void)
+    {
+        if (reordered_frame_ != NULL)
+        {
+            buffer_pool_->release(reordered_frame_);
+            reordered_frame_ = NULL;
+        }
+    }
+
+    //! Add the build latency histogram to the metrics of the core running the stage
+    //!
+    //! \param[in] metrics - metrics of the core running the stage
+    //! \param[in] path - path to report the stage under, relative to the core status path
+    //!
+    void FrameBuildStage::add_metrics(CoreMetrics& metrics, const std::string& path) const
+    {
+        metrics.add_histogram(path + "latency/complete_to_built", &complete_to_built_);
+    }
+
+    //! Clear the payload of the dropped packets of each incomplete frame in a super frame
+    //!
+    //! This is needed because frame buffers are reused, so the payload of dropped packets would
+    //! otherwise hold the data of an earlier frame. The packet state is scanned a word at a time,
+    //! zeroing each run of dropped packets in the word with a single memset.
+    //!
+    //! \param[in] frame - pointer to the super frame
+    //!
+    void FrameBuildStage::clear_dropped_packets(SuperFrameHeader* frame)
+    {
+        uint32_t incomplete_frames = decoder_->get_frame_outer_chunk_size() -
+            decoder_->get_super_frame_frames_received(frame);
+        uint32_t frame_idx = 0;
+        uint32_t frames_cleared = 0;
+        const std::size_t packet_state_words = decoder_->get_packet_state_words();
+
+        // While there are still incomplete frames
+        while ((frames_cleared < incomplete_frames) &&
+            (frame_idx < decoder_->get_frame_outer_chunk_size()))
+        {
+            RawFrameHeader* frame_hdr = decoder_->get_frame_header(frame, frame_idx);
+
+            // Get the number of dropped packets of this sub frame
+            uint32_t packets_dropped = decoder_->get_packets_dropped(frame_hdr);
+
+            if (packets_dropped)
+            {
+                const uint8_t* packet_state = decoder_->get_packet_state_bitmap(frame_hdr);
+                char* frame_data = decoder_->get_image_data_start(frame) +
+                    (frame_idx * payload_size_ * decoder_->get_packets_per_frame());
+                uint32_t packets_cleared = 0;
+
+                for (std::size_t word_idx = 0;
+                    (word_idx < packet_state_words) && (packets_cleared < packets_dropped);
+                    word_idx++)
+                {
+                    uint64_t missing =
+                        ~PacketProtocolDecoder::load_packet_state_word(packet_state, word_idx) &
+                        decoder_->get_packet_state_word_mask(word_idx);
+                    packets_cleared += __builtin_popcountll(missing);
+
+                    while (missing)
+                    {
+                        unsigned int first = __builtin_ctzll(missing);
+                        uint64_t run_bits = ~(missing >> first);
+                        unsigned int run = run_bits ?
+                            __builtin_ctzll(run_bits) : (64 - first);
+
+                        memset(
+                            frame_data + (((word_idx * PacketProtocolDecoder::packet_state_word_bits) + first) * payload_size_),
+                            0, run * payload_size_
+                        );
+
+                        missing = ((first + run) < 64) ?
+                            (missing & (~0ULL << (first + run))) : 0;
+                    }
+                }
+                frames_cleared++;
+            }
+            frame_idx++;
+        }
+    }
+}
@@ -9,16 +9,14 @@ namespace FrameProcessor
     FrameBuilderCore::FrameBuilderCore(
         int fb_idx, int socket_id, DpdkWorkCoreReferences &dpdkWorkCoreReferences
     ) : DpdkWorkerCore(socket_id),
-        logger_(Logger::getLogger("FP.FrameBuilderCore")),
         proc_idx_(fb_idx),
         decoder_(dynamic_cast<PacketProtocolDecoder *>(dpdkWorkCoreReferences.decoder)),
         shared_buf_(dpdkWorkCoreReferences.shared_buf),
-        built_frames_(0),
-        built_frames_hz_(1),
-        idle_loops_(0),
-        mean_us_on_frame_(0),
-        maximum_us_on_frame_(0),
-        core_usage_(1)
+        logger_(Logger::getLogger("FP.FrameBuilderCore")),
+        metrics_("framebuildercore_" + std::to_string(fb_idx)),
+        recorder_(metrics_.name(), socket_id),
+        buffer_pool_(dpdkWorkCoreReferences.buffer_pool),
+        build_stage_(decoder_, buffer_pool_)
 {
 
         // Get the configuration container for this worker
@@ -30,44 +28,20 @@ namespace FrameProcessor
             << " | connect: " << config_.connect
             << " | upstream_core: " << config_.upstream_core
             << " | num_downsteam_cores: " << config_.num_downstream_cores
+            << " | zero_fill_dropped: " << config_.zero_fill_dropped_
         );
 
-        // Check if the downstream ring have already been created by another processing core,
-        // otherwise create it with the ring size rounded up to the next power of two
-        for (int ring_idx = 0; ring_idx < config_.num_downstream_cores; ring_idx++)
-        {
-            std::string downstream_ring_name = ring_name_str(config_.core_name, socket_id_, ring_idx);
-            struct rte_ring* downstream_ring = rte_ring_lookup(downstream_ring_name.c_str());
-            if (downstream_ring == NULL)
-            {
-                unsigned int downstream_ring_size = nearest_power_two(shared_buf_->get_num_buffers());
-                LOG4CXX_INFO(logger_, "Creating ring name "
-                    << downstream_ring_name << " of size " << downstream_ring_size
-                );
-                downstream_ring = rte_ring_create(
-                    downstream_ring_name.c_str(), downstream_ring_size, socket_id_, 0
-                );
-                if (downstream_ring == NULL)
-                {
-                    LOG4CXX_ERROR(logger_, "Error creating downstream ring " << downstream_ring_name
-                        << " : " << rte_strerror(rte_errno)
-                    );
-                    // TODO - this is fatal and should raise an exception
-                }
-            }
-            else
-            {
-                LOG4CXX_DEBUG_LEVEL(2, logger_, "downstream ring with name "
-                    << downstream_ring_name << " has already been created"
-                );
-            }
-            if (downstream_ring)
-            {
-                downstream_rings_.push_back(downstream_ring);
-            }
+        build_stage_.set_zero_fill(config_.zero_fill_dropped_);
 
-        }
+        // Create the downstream rings, or look them up if already created by another core, and
+        // select the policy for distributing frames between them
+        downstream_.create_rings(
+            config_.core_name, config_.distribution_, config_.num_downstream_cores,
+            shared_buf_->get_num_buffers(), socket_id_
+        );
 
+        // Report the build latency with the core metrics
+        build_stage_.add_metrics(metrics_, "timing/");
     }
 
     FrameBuilderCore::~FrameBuilderCore(void)
@@ -76,14 +50,7 @@ namespace FrameProcessor
         stop();
 
         // Free downstream rings
-        for (auto& ring : downstream_rings_)
-        {
-            if (ring)
-            {
-                rte_ring_free(ring);
-            }
-        }
-        downstream_rings_.clear();
+        downstream_.free_rings();
     }
 
     bool FrameBuilderCore::run(unsigned int lcore_id)
@@ -96,151 +63,64 @@ namespace FrameProcessor
 
         // Generic frame variables
         struct SuperFrameHeader *current_frame_buffer_;
-        struct SuperFrameHeader *reordered_frame_location_;
-        struct SuperFrameHeader *returned_frame_location_;
-        dimensions_t dims(2);
-
-        // Specific frame variables from decoder
-
-        dims[0] = decoder_->get_frame_x_resolution();
-        dims[1] = decoder_->get_frame_y_resolution();
-        std::size_t frame_size =
-            dims[0] * dims[1] * get_size_from_enum(decoder_->get_frame_bit_depth());
-        std::size_t frame_header_size = decoder_->get_frame_header_size();
-        std::size_t payload_size = decoder_->get_payload_size();
+        struct SuperFrameHeader *built_frame_;
 
         // Status reporting variables
-        uint64_t frames_per_second = 1;
-        uint64_t last = rte_get_tsc_cycles();
-        uint64_t cycles_per_sec = rte_get_tsc_hz();
-        uint64_t cycles_working = 1;
         uint64_t start_frame_cycles = 1;
-        uint64_t average_frame_cycles = 1;
-        uint64_t total_frame_cycles = 1;
-        uint64_t maximum_frame_cycles = 1;
 
         // Get a memory location for the reordered frame to go into
-        rte_ring_dequeue(clear_frames_ring_, (void **)&reordered_frame_location_);
+        while (likely(run_lcore_) && !build_stage_.start())
+        {
+        }
+
+        metrics_.start();
+        recorder_.start();
 
         // While loop to continuously dequeue frame objects
         while (likely(run_lcore_))
         {
-            uint64_t now = rte_get_tsc_cycles();
-            if (unlikely((now - last) >= (cycles_per_sec)))
-            {
-                // Update any monitoring variables every second
-                built_frames_hz_ = frames_per_second - 1;
-                mean_us_on_frame_ = (total_frame_cycles * 1000000) / (frames_per_second * cycles_per_sec);
-                core_usage_ = (cycles_working * 255) / cycles_per_sec;
-
-                maximum_us_on_frame_ = (maximum_frame_cycles * 1000000) / (cycles_per_sec);
-
-                // Reset any counters
-                frames_per_second = 1;
-                idle_loops_ = 0;
-                total_frame_cycles = 1;
-                cycles_working = 1;
-                last = now;
-            }
+            // Publish the core metrics every second
+            metrics_.update(rte_get_tsc_cycles());
+
             // Attempt to dequeue a new frame object
             if (rte_ring_dequeue(upstream_ring_, (void **)&current_frame_buffer_) < 0)
             {
                 // No frame was dequeued, try again
-                idle_loops_++;
+                metrics_.idle();
                 continue;
             }
             else
             {
+                metrics_.begin_work();
                 start_frame_cycles = rte_get_tsc_cycles();
 
                 uint64_t frame_number = decoder_->get_super_frame_number(current_frame_buffer_);
 
                 LOG4CXX_DEBUG(logger_, config_.core_name << " : " << proc_idx_ << " Got frame: " << frame_number);
 
-                // If a superframe has any incomplete frames, iterate through them
-                // If the frame has any dropped packets, iterate through the frame and clear
-                // the payload of the dropped packets
-                uint32_t incomplete_frames = decoder_->get_frame_outer_chunk_size() - decoder_->get_super_frame_frames_received(current_frame_buffer_);
-
-                if (incomplete_frames)
-                {
-                    // Incomplete frames have been found
-                    uint32_t frame_idx = 0;
-                    uint32_t frames_cleared = 0;
-
-                    // While there are still incomplete frames
-                    while(frames_cleared < incomplete_frames)
-                    {
-                        uint32_t packet_idx = 0;
-                        uint32_t packets_cleared = 0;
-
-
-                        // Get the number of dropped packets of this sub frame
-                        uint32_t packets_dropped = decoder_->get_packets_dropped(
-                            decoder_->get_frame_header(current_frame_buffer_, frame_idx)
-                        );
-
-
-                        // Loop over packets in the subframe
-                        while (packets_cleared < packets_dropped)
-                        {
-                            // Check to see if this subframe is missing packets
-                            if (decoder_->get_packet_state(decoder_->get_frame_header(current_frame_buffer_, frame_idx), packet_idx) == 0)
-                            {
-                                // This is a dropped packet and needs to be zeroed out
-                                // to prevent corrupting the data
-                                // This is becuase we reuse memory
-                                memset(
-                                    decoder_->get_image_data_start(current_frame_buffer_) + ((frame_idx * payload_size * decoder_->get_packets_per_frame())) + (packet_idx * payload_size),
-                                    0, payload_size);
-                                    
-                                packets_cleared++;
-                            }
-                            packet_idx++;
-                        }
-                        frames_cleared++;
-                        //LOG4CXX_INFO(logger_,
-                        //        "Got incomplete super frame ("<< frame_number <<" ) with " << incomplete_frames << " incomplete frames");
-                    }
-
-                //     LOG4CXX_INFO(logger_,
-                //                 "Got incomplete super frame ("<< frame_number <<" ) with " << incomplete_frames << " incomplete frames");
-                }
-
-                // Use the decoder to build that frame into another HP location
-                returned_frame_location_ =
-                    decoder_->reorder_frame(current_frame_buffer_, reordered_frame_location_);
-                
-                decoder_->set_super_frame_image_size(returned_frame_location_, frame_size * decoder_->get_frame_outer_chunk_size());
+                recorder_.record(frame_number, FlightRecorder::build, FlightRecorder::dequeued);
+                recorder_.record(frame_number, FlightRecorder::build, FlightRecorder::begin);
+
+                // Build the frame, clearing the payload of any dropped packets
+                built_frame_ = build_stage_.process(current_frame_buffer_, frame_number);
 
                 // Enqueue the built frame object to the next set of cores
-                rte_ring_enqueue(
-                    downstream_rings_[frame_number % (config_.num_downstream_cores)], returned_frame_location_);
-                
-                 // Find which memory location the built was in
-                if (returned_frame_location_ == reordered_frame_location_)
-                {
-                    // The frame was built into the 2nd provided memory location
-                    reordered_frame_location_ = current_frame_buffer_;
-                }
-
-                uint64_t cycles_spent = rte_get_tsc_cycles() - start_frame_cycles;
-                total_frame_cycles += cycles_spent;
-                cycles_working += cycles_spent;
-                
-                if (maximum_frame_cycles < cycles_spent)
-                {
-                    maximum_frame_cycles = cycles_spent;
-                }
-                
-
-                frames_per_second++;
-                built_frames_++;
+                downstream_.enqueue(built_frame_, frame_number);
+
+                recorder_.record(frame_number, FlightRecorder::build, FlightRecorder::enqueued);
+                recorder_.record(frame_number, FlightRecorder::build, FlightRecorder::end);
+
+                metrics_.frame(rte_get_tsc_cycles() - start_frame_cycles);
 
                 LOG4CXX_DEBUG(logger_, config_.core_name << " : " << proc_idx_ << " Built frame: " << frame_number);
             }
         }
 
+        // Return the spare frame buffer to the pool
+        build_stage_.stop();
+        buffer_pool_->flush();
+        metrics_.flush();
+
         LOG4CXX_INFO(logger_, "Core " << lcore_id_ << " completed");
 
         return true;
@@ -270,18 +150,11 @@ namespace FrameProcessor
         // Create path for updstream ring status
         std::string ring_status = status_path + "upstream_rings/";
 
-        // Create path for timing status
-        std::string timing_status = status_path + "timing/";
-
-        // Frame status reporting
-        status.set_param(status_path + "frames_processed", built_frames_);
-        status.set_param(status_path + "frames_processed_per_second", built_frames_hz_);
-        status.set_param(status_path + "idle_loops", idle_loops_);
-        status.set_param(status_path + "core_usage", (int)core_usage_);
+        // Frame, core usage and timing status reporting
+        metrics_.status(status, status_path);
 
-        // Core timing status reporting
-        status.set_param(timing_status + "mean_frame_us", mean_us_on_frame_);
-        status.set_param(timing_status + "max_frame_us", maximum_us_on_frame_);
+        // Downstream distribution status
+        downstream_.status(status, status_path + "distribution/");
         
         // Upstream ring status
         status.set_param(ring_status + ring_name_str(config_.upstream_core, socket_id_, proc_idx_) + "_count", rte_ring_count(upstream_ring_));
@@ -293,7 +166,9 @@ namespace FrameProcessor
 
         // connect to the ring for incoming packets
         std::string upstream_ring_name = ring_name_str(config_.upstream_core, socket_id_, proc_idx_);
-        upstream_ring_ = rte_ring_lookup(upstream_ring_name.c_str());
+        upstream_ring_ = DownstreamDistributor::lookup_upstream_ring(
+            config_.upstream_core, socket_id_, proc_idx_
+        );
         if (upstream_ring_ == NULL)
         {
             // this needs to error out as there should always be upstream resources at this point
@@ -307,22 +182,6 @@ namespace FrameProcessor
             );  
         }
 
-        // connect to the ring for new memory locations packets
-        std::string clear_frames_ring_name = ring_name_clear_frames(socket_id_);
-        clear_frames_ring_ = rte_ring_lookup(clear_frames_ring_name.c_str());
-        if (clear_frames_ring_ == NULL)
-        {
-            // this needs to error out as there should always be upstream resources at this point
-            LOG4CXX_INFO(logger_, config_.core_name << " : " << proc_idx_ << " Failed to Connect to upstream resources!");
-            return false;
-        }
-        else
-        {
-            LOG4CXX_DEBUG_LEVEL(2, logger_, "Frame ready ring with name "
-                << upstream_ring_name << " has already been created"
-            );  
-        }
-
         LOG4CXX_INFO(logger_, config_.core_name << " : " << proc_idx_ << " Connected to upstream resources successfully!");
 
         return true;
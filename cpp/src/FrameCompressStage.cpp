@@ -0,0 +1,99 @@
+#include "FrameCompressStage.h"
+
+#include <blosc.h>
+#include <rte_memcpy.h>
+
+namespace FrameProcessor
+{
+    //! Constructor for the FrameCompressStage class
+    //!
+    //! \param[in] decoder - protocol decoder for the super frame layout
+    //! \param[in] buffer_pool - pool to acquire the spare frame buffer from
+    //!
+    FrameCompressStage::FrameCompressStage(ProtocolDecoder* decoder, DpdkBufferPool* buffer_pool) :
+        decoder_(decoder),
+        buffer_pool_(buffer_pool),
+        compressed_frame_(NULL),
+        compressor_name_(NULL),
+        frame_size_(
+            decoder->get_frame_x_resolution() * decoder->get_frame_y_resolution() *
+            get_size_from_enum(decoder->get_frame_bit_depth())
+        ),
+        dest_data_size_(frame_size_ + BLOSC_MAX_OVERHEAD)
+    {
+        // Blosc compression settings
+        blosc_compcode_to_compname(1, &compressor_name_);
+    }
+
+    //! Acquire the spare frame buffer to compress the first frame into
+    //!
+    //! \return true if the spare buffer has been acquired
+    //!
+    bool FrameCompressStage::start(void)
+    {
+        if (compressed_frame_ == NULL)
+        {
+            compressed_frame_ = static_cast<SuperFrameHeader*>(buffer_pool_->acquire());
+        }
+        return compressed_frame_ != NULL;
+    }
+
+    //! Compress a super frame
+    //!
+    //! \param[in] frame - pointer to the built super frame
+    //! \param[in] frame_number - super frame number of the frame
+    //!
+    //! \return pointer to the compressed frame
+    //!
+    SuperFrameHeader* FrameCompressStage::process(SuperFrameHeader* frame, const uint64_t frame_number)
+    {
+        SuperFrameHeader* compressed_frame = compressed_frame_;
+
+        int compressed_size = blosc_compress_ctx(
+            1, 1,
+            get_size_from_enum(decoder_->get_frame_bit_depth()), frame_size_,
+            decoder_->get_image_data_start(frame),
+            decoder_->get_image_data_start(compressed_frame), dest_data_size_, compressor_name_,
+            0, 1
+        );
+
+        // Copy the super frame header and the header of every frame to the new memory location
+        rte_memcpy(compressed_frame, frame, decoder_->get_image_data_offset());
+
+        // Set the correct image size to ensure that correct data is saved out
+        decoder_->set_super_frame_image_size(compressed_frame, compressed_size);
+
+        // Record the latency from the frame being built to compression completing, skipping
+        // frames never stamped as built
+        uint64_t built_cycles = decoder_->get_super_frame_built_time(compressed_frame);
+        if (built_cycles != 0)
+        {
+            built_to_compressed_.record(rte_get_tsc_cycles() - built_cycles);
+        }
+
+        // Reuse the old frame location for the next frame to be compressed
+        compressed_frame_ = frame;
+
+        return compressed_frame;
+    }
+
+    //! Return the spare frame buffer to the pool
+    void FrameCompressStage::stop(void)
+    {
+        if (compressed_frame_ != NULL)
+        {
+            buffer_pool_->release(compressed_frame_);
+            compressed_frame_ = NULL;
+        }
+    }
+
+    //! Add the compression latency histogram to the metrics of the core running the stage
+    //!
+    //! \param[in] metrics - metrics of the core running the stage
+    //! \param[in] path - path to report the stage under, relative to the core status path
+    //!
+    void FrameCompressStage::add_metrics(CoreMetrics& metrics, const std::string& path) const
+    {
+        metrics.add_histogram(path + "latency/built_to_compressed", &built_to_compressed_);
+    }
+}
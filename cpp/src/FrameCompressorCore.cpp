@@ -11,17 +11,15 @@ namespace FrameProcessor
         int fb_idx, int socket_id, DpdkWorkCoreReferences &dpdkWorkCoreReferences
     ) :
         DpdkWorkerCore(socket_id),
-        logger_(Logger::getLogger("FP.FrameCompressorCore")),
         proc_idx_(fb_idx),
         decoder_(dpdkWorkCoreReferences.decoder),
         shared_buf_(dpdkWorkCoreReferences.shared_buf),
-        processed_frames_(0),
-        processed_frames_hz_(0),
-        idle_loops_(0),
-        mean_us_on_frame_(1),
-        maximum_us_on_frame_(1),
-        core_usage_(1),
-        last_frame_(-1)
+        logger_(Logger::getLogger("FP.FrameCompressorCore")),
+        metrics_("FrameCompressorCore_" + std::to_string(fb_idx)),
+        recorder_(metrics_.name(), socket_id),
+        last_frame_id_(metrics_.add_gauge("last_frame_number")),
+        buffer_pool_(dpdkWorkCoreReferences.buffer_pool),
+        compress_stage_(decoder_, buffer_pool_)
     {
 
         // Get the configuration container for this worker
@@ -35,42 +33,15 @@ namespace FrameProcessor
             << " | num_downsteam_cores: " << config_.num_downstream_cores
         );
 
-        // Check if the downstream ring have already been created by another processing core,
-        // otherwise create it with the ring size rounded up to the next power of two
-        for (int ring_idx = 0; ring_idx < config_.num_downstream_cores; ring_idx++)
-        {
-            std::string downstream_ring_name = ring_name_str(config_.core_name, socket_id_, ring_idx);
-            struct rte_ring* downstream_ring = rte_ring_lookup(downstream_ring_name.c_str());
-            if (downstream_ring == NULL)
-            {
-                unsigned int downstream_ring_size = nearest_power_two(shared_buf_->get_num_buffers());
-                LOG4CXX_INFO(logger_, "Creating ring name "
-                    << downstream_ring_name << " of size " << downstream_ring_size
-                );
-                downstream_ring = rte_ring_create(
-                    downstream_ring_name.c_str(), downstream_ring_size, socket_id_, 0
-                );
-                if (downstream_ring == NULL)
-                {
-                    LOG4CXX_ERROR(logger_, "Error creating downstream ring " << downstream_ring_name
-                        << " : " << rte_strerror(rte_errno)
-                    );
-                    // TODO - this is fatal and should raise an exception
-                }
-            }
-            else
-            {
-                LOG4CXX_DEBUG_LEVEL(2, logger_, "downstream ring with name "
-                    << downstream_ring_name << " has already been created"
-                );
-            }
-            if (downstream_ring)
-            {
-                downstream_rings_.push_back(downstream_ring);
-            }
-
-        }
+        // Create the downstream rings, or look them up if already created by another core, and
+        // select the policy for distributing frames between them
+        downstream_.create_rings(
+            config_.core_name, config_.distribution_, config_.num_downstream_cores,
+            shared_buf_->get_num_buffers(), socket_id_
+        );
 
+        // Report the compression latency with the core metrics
+        compress_stage_.add_metrics(metrics_, "timing/");
     }
 
     FrameCompressorCore::~FrameCompressorCore(void)
@@ -87,115 +58,67 @@ namespace FrameProcessor
 
         LOG4CXX_INFO(logger_, "Core " << lcore_id_ << " starting up");
 
-        // Blosc compression settings
-        const char * p_compressor_name;
-        blosc_compcode_to_compname(1, &p_compressor_name);
-
         // Generic frame variables
         struct SuperFrameHeader *current_frame_buffer_, *compressed_frame_;
-        dimensions_t dims(2);
-        int compressed_size = 0;
-
-        // Specific frame variables from decoder
-        dims[0] = decoder_->get_frame_x_resolution();
-        dims[1] = decoder_->get_frame_y_resolution();
-        std::size_t frame_size = 
-            dims[0] * dims[1] * get_size_from_enum(decoder_->get_frame_bit_depth());
-        size_t dest_data_size = frame_size + BLOSC_MAX_OVERHEAD;
-        std::size_t frame_header_size = decoder_->get_frame_header_size();
 
         // Status reporting variables
-        uint64_t frames_per_second = 1;
-        uint64_t last = rte_get_tsc_cycles();
-        uint64_t cycles_per_sec = rte_get_tsc_hz();
-        uint64_t cycles_working = 1;
         uint64_t start_frame_cycles = 1;
-        uint64_t average_frame_cycles = 1;
-        uint64_t total_frame_cycles = 1;
-        uint64_t maximum_frame_cycles = 1;
-        uint64_t idle_loops = 0;
 
-        while (compressed_frame_ == NULL)
+        // Get a memory location for the compressed frame to go into
+        while (likely(run_lcore_) && !compress_stage_.start())
         {
-            rte_ring_dequeue(clear_frames_ring_, (void**) &compressed_frame_);
         }
 
+        metrics_.start();
+        recorder_.start();
+
         //While loop to continuously dequeue frame objects
         while (likely(run_lcore_))
         {
-            uint64_t now = rte_get_tsc_cycles();
-            if (unlikely((now - last) >= (cycles_per_sec)))
-            {
-                // Update any monitoring variables every second
-                processed_frames_hz_ = frames_per_second - 1;
-                mean_us_on_frame_ = (total_frame_cycles * 1000000) / (frames_per_second * cycles_per_sec);
-                core_usage_ = (cycles_working * 255) / cycles_per_sec;
-
-                maximum_us_on_frame_ = (maximum_frame_cycles * 1000000) / (cycles_per_sec);
+            // Publish the core metrics every second
+            metrics_.update(rte_get_tsc_cycles());
 
-                idle_loops_ = idle_loops;
-
-                // Reset any counters
-                frames_per_second = 1;
-                idle_loops = 0;
-                total_frame_cycles = 1;
-                cycles_working = 1;
-                last = now;
-            }
             // Attempt to dequeue a new frame object
             if (rte_ring_dequeue(upstream_ring_, (void**) &current_frame_buffer_) < 0)
             {
 
                 // No frame was dequeued, try again
-                idle_loops_++;
+                metrics_.idle();
                 continue;
             }
             else
             {
+                metrics_.begin_work();
                 start_frame_cycles = rte_get_tsc_cycles();
 
                 uint64_t frame_number = decoder_->get_super_frame_number(current_frame_buffer_);
+                metrics_.set(last_frame_id_, frame_number);
 
-                // Compress the cores using the provided config
-                compressed_size = blosc_compress_ctx(
-                    1, 1,
-                    get_size_from_enum(decoder_->get_frame_bit_depth()), frame_size,
-                    decoder_->get_image_data_start(current_frame_buffer_),
-                    decoder_->get_image_data_start(compressed_frame_), dest_data_size, p_compressor_name,
-                    0, 1
-                );
+                recorder_.record(frame_number, FlightRecorder::compress, FlightRecorder::dequeued);
+                recorder_.record(frame_number, FlightRecorder::compress, FlightRecorder::begin);
 
-                // Copy the Frame_Header to the new memory location
-                rte_memcpy(compressed_frame_, current_frame_buffer_, decoder_->get_super_frame_header_size() + decoder_->get_frame_header_size());
-
-                // Set the correct image size to ensure that correct data is saved out
-                decoder_->set_super_frame_image_size(compressed_frame_, compressed_size);
+                // Compress the frame, reusing the old frame location for the next frame
+                compressed_frame_ = compress_stage_.process(current_frame_buffer_, frame_number);
 
                 // Enqueue the frame to be wrapped into a shared pointer
-                rte_ring_enqueue(downstream_rings_[frame_number % (config_.num_downstream_cores)], compressed_frame_);
+                downstream_.enqueue(compressed_frame_, frame_number);
 
-                // Resuse the old frame location for the next frame to be compressed
-                compressed_frame_ = current_frame_buffer_;
+                recorder_.record(frame_number, FlightRecorder::compress, FlightRecorder::enqueued);
+                recorder_.record(frame_number, FlightRecorder::compress, FlightRecorder::end);
 
                 // Calculate status
-                uint64_t cycles_spent = rte_get_tsc_cycles() - start_frame_cycles;
-                total_frame_cycles += cycles_spent;
-                cycles_working += cycles_spent;
-                
-                if (maximum_frame_cycles < cycles_spent)
-                {
-                    maximum_frame_cycles = cycles_spent;
-                }
-                
-
-                frames_per_second++;
-                processed_frames_++;
+                metrics_.frame(rte_get_tsc_cycles() - start_frame_cycles);
 
                 LOG4CXX_DEBUG(logger_, config_.core_name << " : " << proc_idx_ << " Compressed frame: " << frame_number);
                 
             }
         }
 
+        // Return the spare frame buffer to the pool
+        compress_stage_.stop();
+        buffer_pool_->flush();
+        metrics_.flush();
+
         LOG4CXX_INFO(logger_, "Core " << lcore_id_ << " completed");
 
         return true;
@@ -224,26 +147,15 @@ namespace FrameProcessor
         // Create path for updstream ring status
         std::string ring_status = status_path + "upstream_rings/";
 
-        // Create path for timing status
-        std::string timing_status = status_path + "timing/";
+        // Frame, core usage and timing status reporting
+        metrics_.status(status, status_path);
 
-        // Frame status reporting
-        status.set_param(status_path + "frames_processed", processed_frames_);
-        status.set_param(status_path + "frames_processed_per_second", processed_frames_hz_);
-        status.set_param(status_path + "idle_loops", idle_loops_);
-        status.set_param(status_path + "core_usage", (int)core_usage_);
-        status.set_param(status_path + "last_frame_number", last_frame_);
-
-        // Core timing status reporting
-        status.set_param(timing_status + "mean_frame_us", mean_us_on_frame_);
-        status.set_param(timing_status + "max_frame_us", maximum_us_on_frame_);
+        // Downstream distribution status
+        downstream_.status(status, status_path + "distribution/");
 
         // Upstream ring status
         status.set_param(ring_status + ring_name_str(config_.upstream_core, socket_id_, proc_idx_) + "_count", rte_ring_count(upstream_ring_));
         status.set_param(ring_status + ring_name_str(config_.upstream_core, socket_id_, proc_idx_) + "_size", rte_ring_get_size(upstream_ring_));
-
-        status.set_param(ring_status + ring_name_clear_frames(socket_id_) + "_count" , rte_ring_count(clear_frames_ring_));
-        status.set_param(ring_status + ring_name_clear_frames(socket_id_) + "_size" , rte_ring_get_size(clear_frames_ring_));
     }
 
     bool FrameCompressorCore::connect(void)
@@ -251,7 +163,9 @@ namespace FrameProcessor
 
         // connect to the ring for incoming packets
         std::string upstream_ring_name = ring_name_str(config_.upstream_core, socket_id_, proc_idx_);
-        struct rte_ring* upstream_ring = rte_ring_lookup(upstream_ring_name.c_str());
+        struct rte_ring* upstream_ring = DownstreamDistributor::lookup_upstream_ring(
+            config_.upstream_core, socket_id_, proc_idx_
+        );
         if (upstream_ring == NULL)
         {
             // this needs to error out as there should always be upstream resources at this point
@@ -266,22 +180,6 @@ namespace FrameProcessor
             );  
         }
 
-        // connect to the ring for new memory locations packets
-        std::string clear_frames_ring_name = ring_name_clear_frames(socket_id_);
-        clear_frames_ring_ = rte_ring_lookup(clear_frames_ring_name.c_str());
-        if (clear_frames_ring_ == NULL)
-        {
-            // this needs to error out as there should always be upstream resources at this point
-            LOG4CXX_INFO(logger_, config_.core_name << " : " << proc_idx_ << " Failed to Connect to upstream resources!");
-            return false;
-        }
-        else
-        {
-            LOG4CXX_DEBUG_LEVEL(2, logger_, "Frame ready ring with name "
-                << upstream_ring_name << " has already been created"
-            );  
-        }
-
         LOG4CXX_INFO(logger_, config_.core_name << " : " << proc_idx_ << " Connected to upstream resources successfully!");
 
         return true;
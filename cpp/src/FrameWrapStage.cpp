@@ -0,0 +1,167 @@
+#include "FrameWrapStage.h"
+#include "DpdkSharedBufferFrame.h"
+
+#include <sstream>
+
+namespace FrameProcessor
+{
+    //! Constructor for the FrameWrapStage class
+    //!
+    //! \param[in] decoder - protocol decoder for the super frame layout
+    //! \param[in] buffer_pool - pool the wrapped frames return their buffers to
+    //! \param[in] frame_callback - callback passing frames to the plugin chain
+    //! \param[in] dataset_name - dataset name set in the frame metadata
+    //!
+    FrameWrapStage::FrameWrapStage(
+        ProtocolDecoder* decoder, DpdkBufferPool* buffer_pool, FrameCallback& frame_callback,
+        const std::string& dataset_name
+    ) :
+        decoder_(decoder),
+        packet_decoder_(dynamic_cast<PacketProtocolDecoder*>(decoder)),
+        buffer_pool_(buffer_pool),
+        frame_callback_(frame_callback),
+        dataset_name_(dataset_name),
+        frame_size_(1),
+        data_pointer_offset_(decoder->get_image_data_offset()),
+        logger_(Logger::getLogger("FP.FrameWrapStage"))
+    {
+        // Get dimensions from the decoder, in native order for HDF5
+        std::vector<std::size_t> decoder_dims = decoder_->get_frame_dimensions();
+        dims_.resize(decoder_dims.size());
+
+        std::stringstream dim_str;
+        dim_str << "Frame dimensions: [";
+        for (size_t i = 0; i < decoder_dims.size(); i++) {
+            dims_[i] = decoder_dims[i];
+            frame_size_ *= decoder_dims[i];
+            dim_str << dims_[i];
+            if (i < decoder_dims.size() - 1) dim_str << ", ";
+        }
+        dim_str << "]";
+        LOG4CXX_DEBUG(logger_, dim_str.str());
+
+        // Calculate total frame size based on dimensions and bit depth
+        frame_size_ *= decoder_->get_frame_outer_chunk_size() *
+            (decoder_->get_frame_bit_depth() == FrameProcessor::DataType::raw_32bit ? 4 : 2);
+    }
+
+    //! Wrap a super frame and pass it to the plugin chain
+    //!
+    //! \param[in] frame - pointer to the super frame
+    //! \param[in] frame_number - super frame number of the frame
+    //!
+    //! \return NULL, as the frame is consumed by the plugin chain
+    //!
+    SuperFrameHeader* FrameWrapStage::process(SuperFrameHeader* frame, const uint64_t frame_number)
+    {
+        decoder_->set_super_frame_image_size(frame, frame_size_);
+
+        // Create new frame metadata object
+        FrameMetaData frame_meta;
+        frame_meta.set_dataset_name(dataset_name_);
+        frame_meta.set_frame_number(frame_number);
+        frame_meta.set_dimensions(dims_);
+        frame_meta.set_data_type(decoder_->get_frame_bit_depth());
+
+        // Report any packets missing from the frame
+        if (packet_decoder_ != NULL)
+        {
+            set_packet_loss(frame, frame_meta);
+        }
+
+        LOG4CXX_DEBUG(logger_, "Created frame metadata:"
+            << " Dataset: " << dataset_name_
+            << " Frame: " << frame_number
+            << " Data type: " << decoder_->get_frame_bit_depth());
+
+        // Get the image size, with this we can work out if the frame has been compressed
+        uint64_t image_size = decoder_->get_super_frame_image_size(frame);
+
+        if (frame_size_ != image_size)
+        {
+            frame_meta.set_compression_type(blosc);
+        }
+        else
+        {
+            frame_meta.set_compression_type(no_compression);
+        }
+
+        // Create the shared boost pointer to allow the plugin chain to access huge pages
+        boost::shared_ptr<Frame> complete_frame =
+                boost::shared_ptr<Frame>(new DpdkSharedBufferFrame(
+                                            frame_meta, frame,
+                                            decoder_->get_frame_buffer_size(),
+                                            buffer_pool_, data_pointer_offset_));
+
+        complete_frame->set_image_size(image_size);
+        complete_frame->set_outer_chunk_size(decoder_->get_frame_outer_chunk_size());
+
+        // Record the latency from the frame being built to it being handed to the plugin
+        // chain, before the callback can release the buffer. Frames never stamped as built
+        // are skipped
+        uint64_t built_cycles = decoder_->get_super_frame_built_time(frame);
+        if (built_cycles != 0)
+        {
+            built_to_wrapped_.record(rte_get_tsc_cycles() - built_cycles);
+        }
+
+        frame_callback_(complete_frame);
+
+        return NULL;
+    }
+
+    //! Set the packet loss parameters of a super frame in its metadata
+    //!
+    //! \param[in] frame - pointer to the super frame
+    //! \param[in] frame_meta - metadata of the frame
+    //!
+    void FrameWrapStage::set_packet_loss(SuperFrameHeader* frame, FrameMetaData& frame_meta)
+    {
+        const uint64_t frame_outer_chunk_size = decoder_->get_frame_outer_chunk_size();
+        uint64_t packets_lost = 0;
+
+        for (uint64_t frame_idx = 0; frame_idx < frame_outer_chunk_size; frame_idx++)
+        {
+            packets_lost += packet_decoder_->get_packets_dropped(
+                decoder_->get_frame_header(frame, frame_idx)
+            );
+        }
+        frame_meta.set_parameter<uint64_t>("packets_lost", packets_lost);
+
+        // Complete frames need no mask, so the common case costs nothing more
+        if (packets_lost == 0)
+        {
+            return;
+        }
+
+        const std::size_t packet_state_words = packet_decoder_->get_packet_state_words();
+        std::vector<uint64_t> packet_mask(frame_outer_chunk_size * packet_state_words);
+
+        for (uint64_t frame_idx = 0; frame_idx < frame_outer_chunk_size; frame_idx++)
+        {
+            const uint8_t* packet_state = packet_decoder_->get_packet_state_bitmap(
+                decoder_->get_frame_header(frame, frame_idx)
+            );
+            for (std::size_t word_idx = 0; word_idx < packet_state_words; word_idx++)
+            {
+                packet_mask[(frame_idx * packet_state_words) + word_idx] =
+                    PacketProtocolDecoder::load_packet_state_word(packet_state, word_idx) &
+                    packet_decoder_->get_packet_state_word_mask(word_idx);
+            }
+        }
+        frame_meta.set_parameter<std::vector<uint64_t> >("packet_mask", packet_mask);
+        frame_meta.set_parameter<uint64_t>(
+            "packets_per_frame", packet_decoder_->get_packets_per_frame()
+        );
+    }
+
+    //! Add the wrapping latency histogram to the metrics of the core running the stage
+    //!
+    //! \param[in] metrics - metrics of the core running the stage
+    //! \param[in] path - path to report the stage under, relative to the core status path
+    //!
+    void FrameWrapStage::add_metrics(CoreMetrics& metrics, const std::string& path) const
+    {
+        metrics.add_histogram(path + "latency/built_to_wrapped", &built_to_wrapped_);
+    }
+}
@@ -1,5 +1,6 @@
 #include "FrameWrapperCore.h"
 #include "DpdkUtils.h"
+#include "DownstreamDistributor.h"
 #include <blosc.h>
 #include "DpdkSharedBufferFrame.h"
 #include </usr/lib/x86_64-linux-gnu/hdf5/serial/include/hdf5.h>
@@ -10,17 +11,16 @@ namespace FrameProcessor
         int fb_idx, int socket_id, DpdkWorkCoreReferences &dpdkWorkCoreReferences
     ) :
         DpdkWorkerCore(socket_id),
-        logger_(Logger::getLogger("FP.FrameWrapperCore")),
         proc_idx_(fb_idx),
         decoder_(dpdkWorkCoreReferences.decoder),
+        logger_(Logger::getLogger("FP.FrameWrapperCore")),
         frame_callback_(dpdkWorkCoreReferences.frame_callback),
-        processed_frames_(0),
-        processed_frames_hz_(0),
-        idle_loops_(0),
-        mean_us_on_frame_(1),
-        maximum_us_on_frame_(1),
-        core_usage_(1),
-        last_frame_(-1)
+        metrics_("FrameWrapperCore_" + std::to_string(fb_idx)),
+        recorder_(metrics_.name(), socket_id),
+        last_frame_id_(metrics_.add_gauge("last_frame_number")),
+        wrap_stage_(NULL),
+        resequencer_(NULL),
+        buffer_pool_(dpdkWorkCoreReferences.buffer_pool)
     {
 
         // Get the configuration container for this worker
@@ -34,12 +34,36 @@ namespace FrameProcessor
             << " | num_downsteam_cores: " << config_.num_downstream_cores
         );
 
+        // Create the stage wrapping frames for the plugin chain
+        wrap_stage_ = new FrameWrapStage(
+            decoder_, buffer_pool_, frame_callback_, config_.dataset_name_
+        );
+        wrap_stage_->add_metrics(metrics_, "timing/");
+
+        // Create the reorder window if frames are to be passed to the plugin chain in order. The
+        // window expects consecutive frame numbers, so cannot be used when the frames are shared
+        // between several wrapper cores
+        if ((config_.resequence_window_ > 0) && (config_.num_cores > 1))
+        {
+            LOG4CXX_ERROR(logger_, "Frame resequencing requires a single wrapper core, disabling"
+                << " it for " << config_.num_cores << " wrapper cores"
+            );
+        }
+        else if (config_.resequence_window_ > 0)
+        {
+            resequencer_ = new FrameResequencer(
+                config_.resequence_window_, convert_ms_to_cycles(config_.resequence_timeout_ms_)
+            );
+        }
+
     }
 
     FrameWrapperCore::~FrameWrapperCore(void)
     {
         LOG4CXX_DEBUG_LEVEL(2, logger_, "FrameWrapperCore destructor");
         stop();
+        delete resequencer_;
+        delete wrap_stage_;
     }
 
     bool FrameWrapperCore::run(unsigned int lcore_id)
@@ -50,158 +74,48 @@ namespace FrameProcessor
 
         LOG4CXX_INFO(logger_, "Core " << lcore_id_ << " starting up");
 
-        // Blosc compression settings
-        const char * p_compressor_name;
-        blosc_compcode_to_compname(1, &p_compressor_name);
-
-        // Frame variables
-        struct SuperFrameHeader *current_super_frame_buffer_;
-        
-        // Get dimensions from the decoder
-        std::vector<std::size_t> decoder_dims = decoder_->get_frame_dimensions();
-        LOG4CXX_DEBUG(logger_, "Got dimensions from decoder, size: " << decoder_dims.size());
-        
-        dimensions_t dims(decoder_dims.size());
-        LOG4CXX_DEBUG(logger_, "Created dimensions_t with size: " << dims.size());
-        
-        // Copy dimensions in correct order for HDF5
-        for (size_t i = 0; i < decoder_dims.size(); i++) {
-            dims[i] = decoder_dims[i];
-            LOG4CXX_DEBUG(logger_, "Dimension " << i << ": " << dims[i]);
-        }
-        LOG4CXX_DEBUG(logger_, "Using native dimension order without reversal");
-        
-        std::stringstream dim_str;
-        dim_str << "Frame dimensions: [";
-        for (size_t i = 0; i < dims.size(); i++) {
-            dim_str << dims[i];
-            if (i < dims.size() - 1) dim_str << ", ";
-        }
-        dim_str << "]";
-        LOG4CXX_DEBUG(logger_, dim_str.str());
-        
-        // Calculate total frame size based on dimensions and bit depth
-        std::size_t frame_size = 1;
-        for (const auto& dim : decoder_dims) {
-            frame_size *= dim;
-            LOG4CXX_DEBUG(logger_, "Accumulating frame size: " << frame_size);
-        }
-        frame_size *= decoder_->get_frame_outer_chunk_size() * (decoder_->get_frame_bit_depth() == FrameProcessor::DataType::raw_32bit ? 4 : 2);
-            //dims[0] * dims[1] * get_size_from_enum(decoder_->get_frame_bit_depth());
-        std::size_t frame_header_size = decoder_->get_frame_header_size();
-
-
-        //uint64_t data_pointer_offset = (frame_header_size * decoder_->get_frame_outer_chunk_size()) + decoder_->get_super_frame_header_size();
-        uint64_t data_pointer_offset = decoder_->get_image_data_offset();
-        // Status reporting variables
-        uint64_t frames_per_second = 1;
-        uint64_t last = rte_get_tsc_cycles();
-        uint64_t cycles_per_sec = rte_get_tsc_hz();
-        uint64_t cycles_working = 1;
-        uint64_t start_frame_cycles = 1;
-        uint64_t average_frame_cycles = 1;
-        uint64_t total_frame_cycles = 1;
-        uint64_t maximum_frame_cycles = 1;
-        uint64_t idle_loops = 0;
+        metrics_.start();
+        recorder_.start();
 
         //While loop to continuously dequeue frame objects
         while (likely(run_lcore_))
         {
-            uint64_t now = rte_get_tsc_cycles();
-            if (unlikely((now - last) >= (cycles_per_sec)))
-            {
-                // Update any monitoring variables every second
-                processed_frames_hz_ = frames_per_second - 1;
-                mean_us_on_frame_ = (total_frame_cycles * 1000000) / (frames_per_second * cycles_per_sec);
-                core_usage_ = (cycles_working * 255) / cycles_per_sec;
+            metrics_.update(rte_get_tsc_cycles());
+            poll_frame();
+        }
 
-                maximum_us_on_frame_ = (maximum_frame_cycles * 1000000) / (cycles_per_sec);
+        drain();
 
-                idle_loops_ = idle_loops;
+        LOG4CXX_INFO(logger_, "Core " << lcore_id_ << " completed");
 
-                // Reset any counters
-                frames_per_second = 1;
-                idle_loops = 0;
-                total_frame_cycles = 1;
-                cycles_working = 1;
-                last = now;
-            }
-            // Attempt to dequeue a new frame object
-            if (rte_ring_dequeue(upstream_ring_, (void**) &current_super_frame_buffer_) < 0)
-            {
-                // No frame was dequeued, try again
-                idle_loops++;
-                continue;
-            }
-            else
-            {
-                start_frame_cycles = rte_get_tsc_cycles();
-                
-                uint64_t frame_number = decoder_->get_super_frame_number(current_super_frame_buffer_);
-                last_frame_ = frame_number;
-
-
-                decoder_->set_super_frame_image_size(current_super_frame_buffer_, frame_size);
-
-                // Create new frame metadata object
-                FrameMetaData frame_meta;
-                frame_meta.set_dataset_name(config_.dataset_name_);
-                frame_meta.set_frame_number(frame_number);
-                frame_meta.set_dimensions(dims);
-                frame_meta.set_data_type(decoder_->get_frame_bit_depth());
-                
-                LOG4CXX_DEBUG(logger_, "Created frame metadata:"
-                    << " Dataset: " << config_.dataset_name_
-                    << " Frame: " << frame_number
-                    << " Data type: " << decoder_->get_frame_bit_depth());
-
-                // Get the image size, with this we can work out if the frame has been compressed
-                uint64_t image_size = decoder_->get_super_frame_image_size(current_super_frame_buffer_);
-
-                if (frame_size != image_size)
-                {
-                    frame_meta.set_compression_type(blosc);
-                }
-                else
-                {
-                    frame_meta.set_compression_type(no_compression);
-                }
-
-                // Create the shared boost pointer to allow the plugin chain to access huge pages
-                boost::shared_ptr<Frame> complete_frame =
-                        boost::shared_ptr<Frame>(new DpdkSharedBufferFrame(
-                                                    frame_meta, current_super_frame_buffer_,
-                                                    decoder_->get_frame_buffer_size(),
-                                                    clear_frames_ring_, data_pointer_offset));
-
-                complete_frame->set_image_size(decoder_->get_super_frame_image_size(current_super_frame_buffer_));
-                complete_frame->set_outer_chunk_size(decoder_->get_frame_outer_chunk_size());
-                frame_callback_(complete_frame);
-
-
-                // Calculate status
-                uint64_t cycles_spent = rte_get_tsc_cycles() - start_frame_cycles;
-                total_frame_cycles += cycles_spent;
-                cycles_working += cycles_spent;
-                
-                if (maximum_frame_cycles < cycles_spent)
-                {
-                    maximum_frame_cycles = cycles_spent;
-                }
-                
-
-                frames_per_second++;
-                processed_frames_++;
-
-                LOG4CXX_DEBUG(logger_,  config_.core_name << " : " << proc_idx_ << " Wrapped frame: " << frame_number);
-            }
-        }
+        return true;
+    }
 
-        LOG4CXX_INFO(logger_, "Core " << lcore_id_ << " completed");
+    bool FrameWrapperCore::service_start(unsigned int lcore_id)
+    {
+        lcore_id_ = lcore_id;
+
+        LOG4CXX_INFO(logger_, "Core " << proc_idx_ << " starting up as a service on lcore " << lcore_id_);
+
+        metrics_.start();
+        recorder_.start();
 
         return true;
     }
 
+    int32_t FrameWrapperCore::service_poll(void)
+    {
+        metrics_.update(rte_get_tsc_cycles());
+        return poll_frame() ? 0 : -EAGAIN;
+    }
+
+    void FrameWrapperCore::service_stop(void)
+    {
+        drain();
+
+        LOG4CXX_INFO(logger_, "Core " << proc_idx_ << " service on lcore " << lcore_id_ << " completed");
+    }
+
     void FrameWrapperCore::stop(void)
     {
         if (run_lcore_)
@@ -225,26 +139,18 @@ namespace FrameProcessor
         // Create path for updstream ring status
         std::string ring_status = status_path + "upstream_rings/";
 
-        // Create path for timing status
-        std::string timing_status = status_path + "timing/";
-
-        // Frame status reporting
-        status.set_param(status_path + "frames_processed", processed_frames_);
-        status.set_param(status_path + "frames_processed_per_second", processed_frames_hz_);
-        status.set_param(status_path + "idle_loops", idle_loops_);
-        status.set_param(status_path + "core_usage", (int)core_usage_);
-        status.set_param(status_path + "last_frame_number", last_frame_);
+        // Frame, core usage and timing status reporting
+        metrics_.status(status, status_path);
 
-        // Core timing status reporting
-        status.set_param(timing_status + "mean_frame_us", mean_us_on_frame_);
-        status.set_param(timing_status + "max_frame_us", maximum_us_on_frame_);
+        // Reorder window status
+        if (resequencer_)
+        {
+            resequencer_->status(status, status_path + "resequencer/");
+        }
 
         // Upstream ring status
         status.set_param(ring_status + ring_name_str(config_.upstream_core, socket_id_, proc_idx_) + "_count", rte_ring_count(upstream_ring_));
         status.set_param(ring_status + ring_name_str(config_.upstream_core, socket_id_, proc_idx_) + "_size", rte_ring_get_size(upstream_ring_));
-
-        status.set_param(ring_status + ring_name_clear_frames(socket_id_) + "_count" , rte_ring_count(clear_frames_ring_));
-        status.set_param(ring_status + ring_name_clear_frames(socket_id_) + "_size" , rte_ring_get_size(clear_frames_ring_));
     }
 
     bool FrameWrapperCore::connect(void)
@@ -252,7 +158,9 @@ namespace FrameProcessor
 
         // connect to the ring for incoming packets
         std::string upstream_ring_name = ring_name_str(config_.upstream_core, socket_id_, proc_idx_);
-        struct rte_ring* upstream_ring = rte_ring_lookup(upstream_ring_name.c_str());
+        struct rte_ring* upstream_ring = DownstreamDistributor::lookup_upstream_ring(
+            config_.upstream_core, socket_id_, proc_idx_
+        );
         if (upstream_ring == NULL)
         {
             // this needs to error out as there should always be upstream resources at this point
@@ -267,33 +175,107 @@ namespace FrameProcessor
             );  
         }
 
-        // connect to the ring for new memory locations packets
-        std::string clear_frames_ring_name = ring_name_clear_frames(socket_id_);
-        clear_frames_ring_ = rte_ring_lookup(clear_frames_ring_name.c_str());
-        if (clear_frames_ring_ == NULL)
+        LOG4CXX_INFO(logger_, config_.core_name << " : " << proc_idx_ << " Connected to upstream resources successfully!");
+
+        return true;
+    }
+
+    void FrameWrapperCore::configure(OdinData::IpcMessage& config)
+    {
+        // Update the config based from the passed IPCmessage
+
+        LOG4CXX_INFO(logger_, config_.core_name << " : " << proc_idx_ << " Got update config.");
+
+    }
+
+    //! Dequeue a frame, if one is ready, and pass it to the plugin chain
+    //!
+    //! \return true if a frame was dequeued
+    //!
+    bool FrameWrapperCore::poll_frame(void)
+    {
+        struct SuperFrameHeader *current_super_frame_buffer_;
+        auto release = [this](struct SuperFrameHeader* frame) { wrap_frame(frame); };
+
+        // Attempt to dequeue a new frame object
+        if (rte_ring_dequeue(upstream_ring_, (void**) &current_super_frame_buffer_) < 0)
         {
-            // this needs to error out as there should always be upstream resources at this point
-            LOG4CXX_INFO(logger_, config_.core_name << " : " << proc_idx_ << " Failed to Connect to upstream resources!");
+            // No frame was dequeued, release any frames held behind a timed out frame
+            metrics_.idle();
+            if (resequencer_)
+            {
+                resequencer_->poll(rte_get_tsc_cycles(), release);
+            }
             return false;
         }
+
+        metrics_.begin_work();
+        uint64_t start_frame_cycles = rte_get_tsc_cycles();
+
+        recorder_.record(
+            decoder_->get_super_frame_number(current_super_frame_buffer_),
+            FlightRecorder::wrap, FlightRecorder::dequeued
+        );
+
+        // Pass the frame to the plugin chain, through the reorder window if enabled
+        if (resequencer_)
+        {
+            resequencer_->insert(
+                current_super_frame_buffer_,
+                decoder_->get_super_frame_number(current_super_frame_buffer_),
+                start_frame_cycles, release
+            );
+
+            // Apply the timeout under continuous traffic too, not only when the ring is empty
+            resequencer_->poll(start_frame_cycles, release);
+        }
         else
         {
-            LOG4CXX_DEBUG_LEVEL(2, logger_, "Frame ready ring with name "
-                << upstream_ring_name << " has already been created"
-            );  
+            wrap_frame(current_super_frame_buffer_);
         }
 
-        LOG4CXX_INFO(logger_, config_.core_name << " : " << proc_idx_ << " Connected to upstream resources successfully!");
+        // Calculate status, the frames passed on are counted as they are wrapped
+        metrics_.busy(rte_get_tsc_cycles() - start_frame_cycles);
 
         return true;
     }
 
-    void FrameWrapperCore::configure(OdinData::IpcMessage& config)
+    //! Wrap a frame into a shared buffer frame object and pass it to the plugin chain
+    //!
+    //! \param[in] frame - pointer to the super frame
+    //!
+    void FrameWrapperCore::wrap_frame(struct SuperFrameHeader* frame)
     {
-        // Update the config based from the passed IPCmessage
+        uint64_t frame_number = decoder_->get_super_frame_number(frame);
+        metrics_.set(last_frame_id_, frame_number);
 
-        LOG4CXX_INFO(logger_, config_.core_name << " : " << proc_idx_ << " Got update config.");
+        recorder_.record(frame_number, FlightRecorder::wrap, FlightRecorder::begin);
+
+        wrap_stage_->process(frame, frame_number);
+
+        recorder_.record(frame_number, FlightRecorder::wrap, FlightRecorder::enqueued);
+        recorder_.record(frame_number, FlightRecorder::wrap, FlightRecorder::end);
+
+        metrics_.frames(1);
+
+        LOG4CXX_DEBUG(logger_,  config_.core_name << " : " << proc_idx_ << " Wrapped frame: " << frame_number);
+    }
+
+    //! Pass on any frames held in the reorder window and return cached buffers to the pool
+    void FrameWrapperCore::drain(void)
+    {
+        // Pass any frames still held in the reorder window to the plugin chain
+        if (resequencer_)
+        {
+            auto release = [this](struct SuperFrameHeader* frame) { wrap_frame(frame); };
+            resequencer_->flush(release);
+        }
+
+        // Return any frame buffers released and cached on this lcore to the pool
+        buffer_pool_->flush();
 
+        // Publish the final frame counts
+        metrics_.flush();
     }
 
     DPDKREGISTER(DpdkWorkerCore, FrameWrapperCore, "FrameWrapperCore");
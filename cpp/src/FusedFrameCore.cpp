@@ -0,0 +1,336 @@
+#include "FusedFrameCore.h"
+#include "DpdkUtils.h"
+#include "FrameBuildStage.h"
+#include "FrameCompressStage.h"
+#include "FrameWrapStage.h"
+
+namespace FrameProcessor
+{
+    FusedFrameCore::FusedFrameCore(
+        int fb_idx, int socket_id, DpdkWorkCoreReferences &dpdkWorkCoreReferences
+    ) :
+        DpdkWorkerCore(socket_id),
+        proc_idx_(fb_idx),
+        decoder_(dpdkWorkCoreReferences.decoder),
+        shared_buf_(dpdkWorkCoreReferences.shared_buf),
+        logger_(Logger::getLogger("FP.FusedFrameCore")),
+        metrics_("FusedFrameCore_" + std::to_string(fb_idx)),
+        recorder_(metrics_.name(), socket_id),
+        last_frame_id_(metrics_.add_gauge("last_frame_number")),
+        buffer_pool_(dpdkWorkCoreReferences.buffer_pool),
+        upstream_ring_(NULL)
+    {
+
+        // Get the configuration container for this worker
+        config_.resolve(dpdkWorkCoreReferences.core_config);
+
+        std::stringstream stage_list;
+        for (auto& stage_name : config_.stages_)
+        {
+            stage_list << " " << stage_name;
+        }
+
+        LOG4CXX_INFO(logger_, "FP.FusedFrameCore " << proc_idx_ << " Created with config:"
+            << " | core_name" << config_.core_name
+            << " | num_cores: " << config_.num_cores
+            << " | connect: " << config_.connect
+            << " | upstream_core: " << config_.upstream_core
+            << " | num_downsteam_cores: " << config_.num_downstream_cores
+            << " | stages:" << stage_list.str()
+        );
+
+        // Create the stages, and the downstream rings if the frames are not wrapped for the
+        // plugin chain by the last stage
+        if (create_stages(dpdkWorkCoreReferences))
+        {
+            downstream_.create_rings(
+                config_.core_name, config_.distribution_, config_.num_downstream_cores,
+                shared_buf_->get_num_buffers(), socket_id_
+            );
+            if (downstream_.empty())
+            {
+                LOG4CXX_ERROR(logger_, config_.core_name << " : " << proc_idx_
+                    << " has no wrap stage and no downstream cores, frames will be discarded"
+                );
+            }
+        }
+    }
+
+    FusedFrameCore::~FusedFrameCore(void)
+    {
+        LOG4CXX_DEBUG_LEVEL(2, logger_, "FusedFrameCore destructor");
+        stop();
+
+        for (auto& stage : stages_)
+        {
+            delete stage;
+        }
+
+        // Free downstream rings
+        downstream_.free_rings();
+    }
+
+    bool FusedFrameCore::run(unsigned int lcore_id)
+    {
+
+        lcore_id_ = lcore_id;
+        run_lcore_ = true;
+
+        LOG4CXX_INFO(logger_, "Core " << lcore_id_ << " starting up");
+
+        // Generic frame variables
+        struct SuperFrameHeader *current_frame_buffer_;
+        unsigned int num_stages = stages_.size();
+
+        // Stages frames are received and passed on under in the flight recorder
+        FlightRecorder::Stage first_trace_stage =
+            stages_.empty() ? FlightRecorder::build : stages_.front()->trace_stage();
+        FlightRecorder::Stage last_trace_stage =
+            stages_.empty() ? FlightRecorder::build : stages_.back()->trace_stage();
+
+        // Status reporting variables
+        uint64_t start_frame_cycles = 1;
+
+        // Acquire any spare frame buffers the stages need on this lcore
+        for (auto& stage : stages_)
+        {
+            while (likely(run_lcore_) && !stage->start())
+            {
+            }
+        }
+
+        metrics_.start();
+        recorder_.start();
+
+        //While loop to continuously dequeue frame objects
+        while (likely(run_lcore_))
+        {
+            // Publish the core metrics every second
+            metrics_.update(rte_get_tsc_cycles());
+
+            // Attempt to dequeue a new frame object
+            if (rte_ring_dequeue(upstream_ring_, (void**) &current_frame_buffer_) < 0)
+            {
+                // No frame was dequeued, try again
+                metrics_.idle();
+                continue;
+            }
+            else
+            {
+                metrics_.begin_work();
+                start_frame_cycles = rte_get_tsc_cycles();
+
+                uint64_t frame_number = decoder_->get_super_frame_number(current_frame_buffer_);
+                metrics_.set(last_frame_id_, frame_number);
+
+                recorder_.record(frame_number, first_trace_stage, FlightRecorder::dequeued);
+
+                // Apply each stage in turn until the frame is consumed by a wrap stage
+                uint64_t stage_start = start_frame_cycles;
+                for (unsigned int stage_idx = 0;
+                    (stage_idx < num_stages) && (current_frame_buffer_ != NULL); stage_idx++)
+                {
+                    FlightRecorder::Stage trace_stage = stages_[stage_idx]->trace_stage();
+                    recorder_.record(frame_number, trace_stage, FlightRecorder::begin);
+
+                    current_frame_buffer_ =
+                        stages_[stage_idx]->process(current_frame_buffer_, frame_number);
+
+                    // A frame consumed by a wrap stage has been passed to the plugin chain
+                    if (current_frame_buffer_ == NULL)
+                    {
+                        recorder_.record(frame_number, trace_stage, FlightRecorder::enqueued);
+                    }
+                    recorder_.record(frame_number, trace_stage, FlightRecorder::end);
+
+                    uint64_t stage_end = rte_get_tsc_cycles();
+                    metrics_.add(stage_timer_ids_[stage_idx], stage_end - stage_start);
+                    stage_start = stage_end;
+                }
+
+                // Pass on a frame not consumed by the stages to the downstream cores
+                if (current_frame_buffer_ != NULL)
+                {
+                    if (likely(!downstream_.empty()))
+                    {
+                        downstream_.enqueue(current_frame_buffer_, frame_number);
+                        recorder_.record(frame_number, last_trace_stage, FlightRecorder::enqueued);
+                    }
+                    else
+                    {
+                        buffer_pool_->release(current_frame_buffer_);
+                    }
+                }
+
+                // Calculate status
+                metrics_.frame(rte_get_tsc_cycles() - start_frame_cycles);
+
+                LOG4CXX_DEBUG(logger_, config_.core_name << " : " << proc_idx_ << " Processed frame: " << frame_number);
+            }
+        }
+
+        // Return any spare frame buffers held by the stages to the pool
+        for (auto& stage : stages_)
+        {
+            stage->stop();
+        }
+        buffer_pool_->flush();
+        metrics_.flush();
+
+        LOG4CXX_INFO(logger_, "Core " << lcore_id_ << " completed");
+
+        return true;
+    }
+
+    void FusedFrameCore::stop(void)
+    {
+        if (run_lcore_)
+        {
+            LOG4CXX_INFO(logger_, "Core " << lcore_id_ << " stopping");
+            run_lcore_ = false;
+        }
+        else
+        {
+            LOG4CXX_DEBUG_LEVEL(2, logger_, "Core " << lcore_id_ << " already stopped");
+        }
+    }
+
+    void FusedFrameCore::status(OdinData::IpcMessage& status, const std::string& path)
+    {
+        LOG4CXX_DEBUG(logger_, "Status requested for FusedFrameCore_" << proc_idx_
+            << " from the DPDK plugin");
+
+        std::string status_path = path + "/FusedFrameCore_" + std::to_string(proc_idx_) + "/";
+
+        // Create path for updstream ring status
+        std::string ring_status = status_path + "upstream_rings/";
+
+        // Frame, core usage, timing and stage status reporting
+        metrics_.status(status, status_path);
+
+        // Downstream distribution status
+        if (!downstream_.empty())
+        {
+            downstream_.status(status, status_path + "distribution/");
+        }
+
+        // Upstream ring status
+        if (upstream_ring_ != NULL)
+        {
+            status.set_param(ring_status + ring_name_str(config_.upstream_core, socket_id_, proc_idx_) + "_count", rte_ring_count(upstream_ring_));
+            status.set_param(ring_status + ring_name_str(config_.upstream_core, socket_id_, proc_idx_) + "_size", rte_ring_get_size(upstream_ring_));
+        }
+    }
+
+    bool FusedFrameCore::connect(void)
+    {
+
+        // connect to the ring for incoming packets
+        std::string upstream_ring_name = ring_name_str(config_.upstream_core, socket_id_, proc_idx_);
+        struct rte_ring* upstream_ring = DownstreamDistributor::lookup_upstream_ring(
+            config_.upstream_core, socket_id_, proc_idx_
+        );
+        if (upstream_ring == NULL)
+        {
+            // this needs to error out as there should always be upstream resources at this point
+            LOG4CXX_INFO(logger_, config_.core_name << " : " << proc_idx_ << " Failed to Connect to upstream resources!");
+            return false;
+        }
+        else
+        {
+            upstream_ring_ = upstream_ring;
+            LOG4CXX_DEBUG_LEVEL(2, logger_, "Frame ready ring with name "
+                << upstream_ring_name << " has already been created"
+            );
+        }
+
+        LOG4CXX_INFO(logger_, config_.core_name << " : " << proc_idx_ << " Connected to upstream resources successfully!");
+
+        return true;
+    }
+
+    void FusedFrameCore::configure(OdinData::IpcMessage& config)
+    {
+        // Update the config based from the passed IPCmessage
+
+        LOG4CXX_INFO(logger_, config_.core_name << " : " << proc_idx_ << " Got update config.");
+
+    }
+
+    //! Create the configured frame stages
+    //!
+    //! This method creates a stage for each name in the stage list. The build stage needs a
+    //! packet protocol decoder and must be the first stage, as it builds frames from received
+    //! packets, and the wrap stage consumes each frame so must be the last. Invalid stages are
+    //! ignored with an error.
+    //!
+    //! \param[in] dpdkWorkCoreReferences - references to the resources shared by worker cores
+    //!
+    //! \return true if frames leave the last stage to be passed on to downstream cores
+    //!
+    bool FusedFrameCore::create_stages(DpdkWorkCoreReferences &dpdkWorkCoreReferences)
+    {
+        for (auto& stage_name : config_.stages_)
+        {
+            if (stage_name == "build")
+            {
+                PacketProtocolDecoder* packet_decoder =
+                    dynamic_cast<PacketProtocolDecoder*>(decoder_);
+                if (packet_decoder == NULL)
+                {
+                    LOG4CXX_ERROR(logger_, "Cannot add build stage to " << config_.core_name
+                        << " as the decoder is not a packet protocol decoder"
+                    );
+                }
+                else if (!stages_.empty())
+                {
+                    LOG4CXX_ERROR(logger_, "Cannot add build stage to " << config_.core_name
+                        << " as it must be the first stage"
+                    );
+                }
+                else
+                {
+                    FrameBuildStage* build_stage = new FrameBuildStage(packet_decoder, buffer_pool_);
+                    build_stage->set_zero_fill(config_.zero_fill_dropped_);
+                    stages_.push_back(build_stage);
+                }
+            }
+            else if (stage_name == "compress")
+            {
+                stages_.push_back(new FrameCompressStage(decoder_, buffer_pool_));
+            }
+            else if (stage_name == "wrap")
+            {
+                stages_.push_back(new FrameWrapStage(
+                    decoder_, buffer_pool_, dpdkWorkCoreReferences.frame_callback,
+                    config_.dataset_name_
+                ));
+                if (&stage_name != &config_.stages_.back())
+                {
+                    LOG4CXX_ERROR(logger_, "Ignoring stages after the wrap stage for "
+                        << config_.core_name
+                    );
+                }
+                break;
+            }
+            else
+            {
+                LOG4CXX_ERROR(logger_, "Unknown stage " << stage_name
+                    << " for " << config_.core_name
+                );
+            }
+        }
+
+        // Add a frame timer and any latency histograms for each stage to the core metrics
+        for (auto& stage : stages_)
+        {
+            std::string stage_path = "stages/" + std::string(stage->name()) + "/";
+            stage_timer_ids_.push_back(metrics_.add_timer(stage_path + "mean_frame_us"));
+            stage->add_metrics(metrics_, stage_path);
+        }
+
+        return stages_.empty() || (std::string(stages_.back()->name()) != "wrap");
+    }
+
+    DPDKREGISTER(DpdkWorkerCore, FusedFrameCore, "FusedFrameCore");
+}
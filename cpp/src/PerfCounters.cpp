@@ -0,0 +1,180 @@
+/*
+ * PerfCounters.cpp - hardware performance counters for the calling worker lcore.
+ */
+
+#include <cerrno>
+#include <cstring>
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "PerfCounters.h"
+
+namespace FrameProcessor
+{
+    //! Perf event type and configuration of each counted event
+    static const struct
+    {
+        uint32_t type;
+        uint64_t config;
+        const char* name;
+    } perf_events[PerfCounters::num_events] = {
+        { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, "cycles" },
+        { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS, "instructions" },
+        { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES, "llc_misses" },
+        {
+            PERF_TYPE_HW_CACHE,
+            PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                (PERF_COUNT_HW_CACHE_RESULT_MISS << 16),
+            "dtlb_misses"
+        },
+        { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES, "branch_misses" }
+    };
+
+    //! Constructor for the PerfCounters class
+    PerfCounters::PerfCounters() :
+        logger_(Logger::getLogger("FP.PerfCounters"))
+    {
+        for (unsigned int event = 0; event < num_events; event++)
+        {
+            fds_[event] = -1;
+            pages_[event] = NULL;
+        }
+    }
+
+    //! Destructor for the PerfCounters class
+    PerfCounters::~PerfCounters()
+    {
+        close();
+    }
+
+    //! Open the counters for the calling thread
+    //!
+    //! Each counter is opened separately, so that an event the PMU does not support, or that the
+    //! kernel does not permit, only leaves that counter closed.
+    //!
+    //! \return the number of counters opened
+    //!
+    unsigned int PerfCounters::open(void)
+    {
+        unsigned int num_open = 0;
+        long page_size = sysconf(_SC_PAGESIZE);
+
+        for (unsigned int event = 0; event < num_events; event++)
+        {
+            struct perf_event_attr attr;
+            memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = perf_events[event].type;
+            attr.config = perf_events[event].config;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+
+            int fd = static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+            if (fd < 0)
+            {
+                LOG4CXX_WARN(logger_, "Unable to open " << perf_events[event].name
+                    << " counter: " << strerror(errno)
+                    << ((errno == EACCES) || (errno == EPERM) ?
+                        ", check /proc/sys/kernel/perf_event_paranoid" : "")
+                );
+                continue;
+            }
+            fds_[event] = fd;
+            num_open++;
+
+            // Map the perf event page so the counter can be read from user space with rdpmc,
+            // falling back to read() if the mapping fails
+            void* page = mmap(NULL, page_size, PROT_READ, MAP_SHARED, fd, 0);
+            if (page != MAP_FAILED)
+            {
+                pages_[event] = static_cast<struct perf_event_mmap_page*>(page);
+            }
+        }
+
+        return num_open;
+    }
+
+    //! Close any open counters
+    void PerfCounters::close(void)
+    {
+        long page_size = sysconf(_SC_PAGESIZE);
+        for (unsigned int event = 0; event < num_events; event++)
+        {
+            if (pages_[event] != NULL)
+            {
+                munmap(pages_[event], page_size);
+                pages_[event] = NULL;
+            }
+            if (fds_[event] >= 0)
+            {
+                ::close(fds_[event]);
+                fds_[event] = -1;
+            }
+        }
+    }
+
+    //! Get the name of an event
+    //!
+    //! \param[in] event - event index
+    //!
+    //! \return the event name, as used in status and CSV columns
+    //!
+    const char* PerfCounters::event_name(const unsigned int event)
+    {
+        return (event < num_events) ? perf_events[event].name : "unknown";
+    }
+
+    //! Read the current value of an open counter
+    //!
+    //! The counter is read with rdpmc if the perf event page allows user space reads, retrying
+    //! if the kernel updates the page during the read. Otherwise the counter is read with a
+    //! read() system call.
+    //!
+    //! \param[in] event - event index
+    //!
+    //! \return the counter value
+    //!
+    uint64_t PerfCounters::read_counter(const unsigned int event) const
+    {
+#if defined(__x86_64__)
+        volatile struct perf_event_mmap_page* page = pages_[event];
+        if (page != NULL)
+        {
+            uint32_t sequence;
+            uint64_t count;
+            bool user_read;
+            do
+            {
+                sequence = page->lock;
+                __sync_synchronize();
+                uint32_t index = page->index;
+                user_read = page->cap_user_rdpmc && (index != 0);
+                count = page->offset;
+                if (user_read)
+                {
+                    // Sign extend the raw counter from its width before adding the offset
+                    int64_t pmc = static_cast<int64_t>(__builtin_ia32_rdpmc(index - 1));
+                    unsigned int shift = 64 - page->pmc_width;
+                    count += static_cast<uint64_t>((pmc << shift) >> shift);
+                }
+                __sync_synchronize();
+            } while (page->lock != sequence);
+
+            if (user_read)
+            {
+                return count;
+            }
+        }
+#endif
+        uint64_t value = 0;
+        if (::read(fds_[event], &value, sizeof(value)) != sizeof(value))
+        {
+            return 0;
+        }
+        return value;
+    }
+}
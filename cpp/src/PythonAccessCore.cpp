@@ -1,5 +1,6 @@
 #include "PythonAccessCore.h"
 #include "DpdkUtils.h"
+#include "DownstreamDistributor.h"
 #include <blosc.h>
 #include "DpdkSharedBufferFrame.h"
 #include <iostream>
@@ -11,17 +12,14 @@ namespace FrameProcessor
         int fb_idx, int socket_id, DpdkWorkCoreReferences &dpdkWorkCoreReferences
     ) :
         DpdkWorkerCore(socket_id),
-        logger_(Logger::getLogger("FP.PythonAccessCore")),
         proc_idx_(fb_idx),
         decoder_(dpdkWorkCoreReferences.decoder),
         shared_buf_(dpdkWorkCoreReferences.shared_buf),
-        processed_frames_(0),
-        processed_frames_hz_(0),
-        idle_loops_(0),
-        mean_us_on_frame_(1),
-        maximum_us_on_frame_(1),
-        core_usage_(1),
-        last_frame_(-1)
+        logger_(Logger::getLogger("FP.PythonAccessCore")),
+        metrics_("PythonAccessCore_" + std::to_string(fb_idx)),
+        recorder_(metrics_.name(), socket_id),
+        last_frame_id_(metrics_.add_gauge("last_frame_number")),
+        buffer_pool_(dpdkWorkCoreReferences.buffer_pool)
     {
 
         config_.resolve(dpdkWorkCoreReferences.core_config);
@@ -122,90 +120,47 @@ namespace FrameProcessor
 
         LOG4CXX_INFO(logger_, "PythonAccessCore: " << lcore_id_ << " starting up");
 
-        // Generic frame variables
-        struct SuperFrameHeader *current_frame_buffer_, *compressed_frame_;
-
-
-        // Specific frame variables from decoder
-        std::size_t frame_header_size = decoder_->get_frame_header_size();
-
-        // Status reporting variables
-        uint64_t frames_per_second = 1;
-        uint64_t last = rte_get_tsc_cycles();
-        uint64_t cycles_per_sec = rte_get_tsc_hz();
-        uint64_t cycles_working = 1;
-        uint64_t start_frame_cycles = 1;
-        uint64_t average_frame_cycles = 1;
-        uint64_t total_frame_cycles = 1;
-        uint64_t maximum_frame_cycles = 1;
-        uint64_t idle_loops = 0;
-
-        while (compressed_frame_ == NULL)
-        {
-            rte_ring_dequeue(clear_frames_ring_, (void**) &compressed_frame_);
-        }
+        metrics_.start();
+        recorder_.start();
 
         //While loop to continuously dequeue frame objects
         while (likely(run_lcore_))
         {
-            uint64_t now = rte_get_tsc_cycles();
-            if (unlikely((now - last) >= (cycles_per_sec)))
-            {
-                // Update any monitoring variables every second
-                processed_frames_hz_ = frames_per_second - 1;
-                mean_us_on_frame_ = (total_frame_cycles * 1000000) / (frames_per_second * cycles_per_sec);
-                core_usage_ = (cycles_working * 255) / cycles_per_sec;
-
-                maximum_us_on_frame_ = (maximum_frame_cycles * 1000000) / (cycles_per_sec);
+            metrics_.update(rte_get_tsc_cycles());
+            poll_frame();
+        }
 
-                idle_loops_ = idle_loops;
+        // Publish the final frame counts
+        metrics_.flush();
 
-                // Reset any counters
-                frames_per_second = 1;
-                idle_loops = 0;
-                total_frame_cycles = 1;
-                cycles_working = 1;
-                last = now;
-            }
-            // Attempt to dequeue a new frame object
-            if (rte_ring_dequeue(upstream_ring_, (void**) &current_frame_buffer_) < 0)
-            {
+        LOG4CXX_INFO(logger_, "Core " << lcore_id_ << " completed");
 
-                // No frame was dequeued, try again
-                idle_loops_++;
-                continue;
-            }
-            else
-            {
-                start_frame_cycles = rte_get_tsc_cycles();
+        return true;
+    }
 
-                uint64_t frame_number = decoder_->get_super_frame_number(current_frame_buffer_);
+    bool PythonAccessCore::service_start(unsigned int lcore_id)
+    {
+        lcore_id_ = lcore_id;
 
-                // Enqueue the frame to be wrapped into a shared pointer
-                rte_ring_enqueue(python_access_rings_[frame_number % (config_.num_downstream_cores)], current_frame_buffer_);
+        LOG4CXX_INFO(logger_, "PythonAccessCore: " << proc_idx_ << " starting up as a service on lcore " << lcore_id_);
 
-                // Calculate status
-                uint64_t cycles_spent = rte_get_tsc_cycles() - start_frame_cycles;
-                total_frame_cycles += cycles_spent;
-                cycles_working += cycles_spent;
-                
-                if (maximum_frame_cycles < cycles_spent)
-                {
-                    maximum_frame_cycles = cycles_spent;
-                }
-                
+        metrics_.start();
+        recorder_.start();
 
-                frames_per_second++;
-                processed_frames_++;
+        return true;
+    }
 
-                LOG4CXX_DEBUG(logger_, config_.core_name << " : " << proc_idx_ << " Enqueued frame: " << frame_number);
-                
-            }
-        }
+    int32_t PythonAccessCore::service_poll(void)
+    {
+        metrics_.update(rte_get_tsc_cycles());
+        return poll_frame() ? 0 : -EAGAIN;
+    }
 
-        LOG4CXX_INFO(logger_, "Core " << lcore_id_ << " completed");
+    void PythonAccessCore::service_stop(void)
+    {
+        metrics_.flush();
 
-        return true;
+        LOG4CXX_INFO(logger_, "Core " << proc_idx_ << " service on lcore " << lcore_id_ << " completed");
     }
 
     void PythonAccessCore::stop(void)
@@ -234,27 +189,12 @@ namespace FrameProcessor
         // Create path for updstream ring status
         std::string python_access_ring_status = status_path + "python_access_rings/";
 
-        // Create path for timing status
-        std::string timing_status = status_path + "timing/";
-
-        // Frame status reporting
-        status.set_param(status_path + "frames_processed", processed_frames_);
-        status.set_param(status_path + "frames_processed_per_second", processed_frames_hz_);
-        status.set_param(status_path + "idle_loops", idle_loops_);
-        status.set_param(status_path + "core_usage", (int)core_usage_);
-        status.set_param(status_path + "last_frame_number", last_frame_);
-
-        // Core timing status reporting
-        status.set_param(timing_status + "mean_frame_us", mean_us_on_frame_);
-        status.set_param(timing_status + "max_frame_us", maximum_us_on_frame_);
+        // Frame, core usage and timing status reporting
+        metrics_.status(status, status_path);
 
         // Upstream ring status
         status.set_param(ring_status + ring_name_str(config_.upstream_core, socket_id_, proc_idx_) + "_count", rte_ring_count(upstream_ring_));
         status.set_param(ring_status + ring_name_str(config_.upstream_core, socket_id_, proc_idx_) + "_size", rte_ring_get_size(upstream_ring_));
-        
-
-        status.set_param(ring_status + ring_name_clear_frames(socket_id_) + "_count" , rte_ring_count(clear_frames_ring_));
-        status.set_param(ring_status + ring_name_clear_frames(socket_id_) + "_size" , rte_ring_get_size(clear_frames_ring_));
     }
 
     bool PythonAccessCore::connect(void)
@@ -262,7 +202,9 @@ namespace FrameProcessor
 
                 // connect to the ring for incoming packets
         std::string upstream_ring_name = ring_name_str(config_.upstream_core, socket_id_, proc_idx_);
-        struct rte_ring* upstream_ring = rte_ring_lookup(upstream_ring_name.c_str());
+        struct rte_ring* upstream_ring = DownstreamDistributor::lookup_upstream_ring(
+            config_.upstream_core, socket_id_, proc_idx_
+        );
         if (upstream_ring == NULL)
         {
             // this needs to error out as there should always be upstream resources at this point
@@ -277,22 +219,6 @@ namespace FrameProcessor
             );  
         }
 
-        // connect to the ring for new memory locations
-        std::string clear_frames_ring_name = ring_name_clear_frames(socket_id_);
-        clear_frames_ring_ = rte_ring_lookup(clear_frames_ring_name.c_str());
-        if (clear_frames_ring_ == NULL)
-        {
-            // this needs to error out as there should always be upstream resources at this point
-            LOG4CXX_INFO(logger_, config_.core_name << " : " << proc_idx_ << " Failed to Connect to upstream resources!");
-            return false;
-        }
-        else
-        {
-            LOG4CXX_DEBUG_LEVEL(2, logger_, "Frame ready ring with name "
-                << clear_frames_ring_name << " has already been created"
-            );  
-        }
-
         LOG4CXX_INFO(logger_, config_.core_name << " : " << proc_idx_ << " Connected to upstream resources successfully!");
 
         return true;
@@ -308,5 +234,44 @@ namespace FrameProcessor
 
     }
 
+    //! Dequeue a frame, if one is ready, and enqueue it for python to access
+    //!
+    //! \return true if a frame was dequeued
+    //!
+    bool PythonAccessCore::poll_frame(void)
+    {
+        struct SuperFrameHeader *current_frame_buffer_;
+
+        // Attempt to dequeue a new frame object
+        if (rte_ring_dequeue(upstream_ring_, (void**) &current_frame_buffer_) < 0)
+        {
+            // No frame was dequeued
+            metrics_.idle();
+            return false;
+        }
+
+        metrics_.begin_work();
+        uint64_t start_frame_cycles = rte_get_tsc_cycles();
+
+        uint64_t frame_number = decoder_->get_super_frame_number(current_frame_buffer_);
+        metrics_.set(last_frame_id_, frame_number);
+
+        recorder_.record(frame_number, FlightRecorder::access, FlightRecorder::dequeued);
+        recorder_.record(frame_number, FlightRecorder::access, FlightRecorder::begin);
+
+        // Enqueue the frame to be wrapped into a shared pointer
+        rte_ring_enqueue(python_access_rings_[frame_number % (config_.num_downstream_cores)], current_frame_buffer_);
+
+        recorder_.record(frame_number, FlightRecorder::access, FlightRecorder::enqueued);
+        recorder_.record(frame_number, FlightRecorder::access, FlightRecorder::end);
+
+        // Calculate status
+        metrics_.frame(rte_get_tsc_cycles() - start_frame_cycles);
+
+        LOG4CXX_DEBUG(logger_, config_.core_name << " : " << proc_idx_ << " Enqueued frame: " << frame_number);
+
+        return true;
+    }
+
     DPDKREGISTER(DpdkWorkerCore, PythonAccessCore, "PythonAccessCore");
 }
\ No newline at end of file
@@ -19,6 +19,7 @@ namespace FrameProcessor
         proc_idx_(proc_idx),
         decoder_(dpdkWorkCoreReferences.decoder),
         shared_buf_(dpdkWorkCoreReferences.shared_buf),
+        buffer_pool_(dpdkWorkCoreReferences.buffer_pool),
         logger_(Logger::getLogger("FP.CameraCaptureCore")),
         camera_controller_(NULL)
         
@@ -32,72 +33,12 @@ namespace FrameProcessor
 
         LOG4CXX_INFO(logger_, "Core CameraCaptureCore " << proc_idx_ << " config resolved!");
 
-        // Check if the downstream ring have already been created by another processing core,
-        // otherwise create it with the ring size rounded up to the next power of two
-        for (int ring_idx = 0; ring_idx < config_.num_downstream_cores; ring_idx++)
-        {
-            std::string downstream_ring_name = ring_name_str(config_.core_name, socket_id_, ring_idx);
-            struct rte_ring* downstream_ring = rte_ring_lookup(downstream_ring_name.c_str());
-            if (downstream_ring == NULL)
-            {
-                unsigned int downstream_ring_size = nearest_power_two(shared_buf_->get_num_buffers());
-                LOG4CXX_INFO(logger_, "Creating ring name "
-                    << downstream_ring_name << " of size " << downstream_ring_size
-                );
-                downstream_ring = rte_ring_create(
-                    downstream_ring_name.c_str(), downstream_ring_size, socket_id_, 0
-                );
-                if (downstream_ring == NULL)
-                {
-                    LOG4CXX_ERROR(logger_, "Error creating downstream ring " << downstream_ring_name
-                        << " : " << rte_strerror(rte_errno)
-                    );
-                    // TODO - this is fatal and should raise an exception
-                }
-            }
-            else
-            {
-                LOG4CXX_DEBUG_LEVEL(2, logger_, "downstream ring with name "
-                    << downstream_ring_name << " has already been created"
-                );
-            }
-            if (downstream_ring)
-            {
-                downstream_rings_.push_back(downstream_ring);
-            }
-
-        }
-
-        // Check if the clear_frames ring has already been created by another procsssing core,
-        // otherwise create it with the ring size rounded up to the next power of two
-        std::string clear_frames_ring_name = ring_name_clear_frames(socket_id_);
-        clear_frames_ring_ = rte_ring_lookup(clear_frames_ring_name.c_str());
-        if (clear_frames_ring_ == NULL)
-        {
-            unsigned int clear_frames_ring_size = nearest_power_two(shared_buf_->get_num_buffers());
-            LOG4CXX_DEBUG_LEVEL(2, logger_, "Creating frame processed ring name "
-                << clear_frames_ring_name << " of size " << clear_frames_ring_size
-            );
-            clear_frames_ring_ = rte_ring_create(
-                clear_frames_ring_name.c_str(), clear_frames_ring_size, socket_id_, 0
-            );
-            if (clear_frames_ring_ == NULL)
-            {
-                LOG4CXX_ERROR(logger_, "Error creating frame processed ring " << clear_frames_ring_name
-                    << " : " << rte_strerror(rte_errno)
-                );
-                // TODO - this is fatal and should raise an exception
-            }
-            else
-            {
-                // Populate the ring with hugepages memory locations to the SMB
-                for (int element = 0; element < shared_buf_->get_num_buffers(); element++)
-                {
-
-                    rte_ring_enqueue(clear_frames_ring_, shared_buf_->get_buffer_address(element));
-                }
-            }
-        }
+        // Create the downstream rings, or look them up if already created by another core, and
+        // select the policy for distributing frames between them
+        downstream_.create_rings(
+            config_.core_name, config_.distribution_, config_.num_downstream_cores,
+            shared_buf_->get_num_buffers(), socket_id_
+        );
     
     }
 
@@ -170,9 +111,9 @@ namespace FrameProcessor
                 if(frame_src != nullptr)
                 {
                     // Get a hugepages memory location for this frame
-                    if (unlikely(rte_ring_dequeue(
-                        clear_frames_ring_, (void **) &current_super_frame_buffer_
-                    )) != 0)
+                    current_super_frame_buffer_ =
+                        static_cast<SuperFrameHeader*>(buffer_pool_->acquire());
+                    if (unlikely(current_super_frame_buffer_ == NULL))
                     {
                         // Memory location cannot be found start dropping this frame
                         dropped_frames_++;
@@ -182,8 +123,9 @@ namespace FrameProcessor
                     else
                     {
                         //std::cout << "Got new frame: " << camera_controller_->camera_.camera_status_->frame_number_ << std::endl;
-                        // Zero out the frame header to clear old data
-                        memset(current_super_frame_buffer_, 0, decoder_->get_frame_buffer_size());
+                        // Zero out the frame headers to clear old data, the image data is
+                        // fully overwritten by the captured frame
+                        decoder_->reset_super_frame(current_super_frame_buffer_);
 
                         // Set the frame number and start time in the header
                         decoder_->set_super_frame_number(current_super_frame_buffer_, camera_controller_->camera_->camera_status_->frame_number_);
@@ -199,14 +141,22 @@ namespace FrameProcessor
 
                         decoder_->set_super_frame_image_size(current_super_frame_buffer_, frame_size);
 
+                        // The captured frame is complete and needs no building, so stamp both
+                        // times for the latencies recorded by the downstream stages
+                        uint64_t complete_cycles = rte_get_tsc_cycles();
+                        decoder_->set_super_frame_complete_time(
+                            current_super_frame_buffer_, complete_cycles
+                        );
+                        decoder_->set_super_frame_built_time(
+                            current_super_frame_buffer_, complete_cycles
+                        );
+
 
                         // Enqeue the frame to one of the downstream cores
-                        rte_ring_enqueue(
-                                    downstream_rings_[
-                                        decoder_->get_super_frame_number(current_super_frame_buffer_) % 
-                                        config_.num_downstream_cores
-                                    ], current_super_frame_buffer_
-                                );
+                        downstream_.enqueue(
+                            current_super_frame_buffer_,
+                            decoder_->get_super_frame_number(current_super_frame_buffer_)
+                        );
                     }
 
 
@@ -225,6 +175,9 @@ namespace FrameProcessor
             }
             in_capture_ = false;
         }
+
+        // Return any frame buffers cached on this lcore to the pool
+        buffer_pool_->flush();
         return true;
     }
 
@@ -248,6 +201,9 @@ namespace FrameProcessor
             << " from the DPDK plugin");
 
         std::string status_path = path + "/CameraCaptureCore_" + std::to_string(proc_idx_) + "/";
+
+        // Downstream distribution status
+        downstream_.status(status, status_path + "distribution/");
     }
 
     bool CameraCaptureCore::connect(void)
@@ -269,18 +225,12 @@ namespace FrameProcessor
 
     void* CameraCaptureCore::pop_empty_buffer(void)
     {
-        void* buffer;
-
-        if (unlikely(rte_ring_dequeue(clear_frames_ring_, (void **)&buffer)) != 0)
-        {
-            return nullptr;
-        }
-        return buffer;
+        return buffer_pool_->acquire();
     }
 
     void CameraCaptureCore::push_empty_buffer(void* buffer)
     {
-        rte_ring_enqueue(clear_frames_ring_, buffer);
+        buffer_pool_->release(buffer);
     }
 
     DPDKREGISTER(DpdkWorkerCore, CameraCaptureCore, "CameraCaptureCore");
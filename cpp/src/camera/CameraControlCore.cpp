@@ -59,21 +59,10 @@ namespace FrameProcessor
 
         LOG4CXX_INFO(logger_, "Core " << lcore_id_ << " starting up");
 
-
-        // Bind the IPC channel
-        // TODO: Move the address to a config param
-        Camera_Ctrl_Channel_.bind("tcp://0.0.0.0:9001");
-
-
-        LOG4CXX_INFO(logger_, "Core " << lcore_id_ << " Bound IPC channel to port 9001");
+        bind_channel();
 
         bool new_msg = false;
 
-        // Setup before fast loop
-
-        std::string latest_message;
-        std::string mesg_id;
-
         while (likely(run_lcore_))
         {
             // Do fast loop
@@ -82,112 +71,33 @@ namespace FrameProcessor
 
             if(new_msg)
             {
-                // Receive the control channel request and store the client identity so that the response
-                // can be routed back correctly.
-                std::string client_identity;
-                std::string ctrl_req_encoded = Camera_Ctrl_Channel_.recv(&client_identity);
-
-                // Create a reply message
-                OdinData::IpcMessage ctrl_reply;
-                OdinData::IpcMessage::MsgVal ctrl_reply_val = OdinData::IpcMessage::MsgValIllegal;
-
-                bool request_ok = true;
-                std::ostringstream error_ss;
+                handle_ctrl_request();
+            }
+        }
+        return true;
+    }
 
-                std::stringstream ss;
+    bool CameraControlCore::service_start(unsigned int lcore_id)
+    {
+        lcore_id_ = lcore_id;
 
-                try
-                {
+        LOG4CXX_INFO(logger_, "Core " << proc_idx_ << " starting up as a service on lcore " << lcore_id_);
 
-                    // Attempt to decode the incoming message and get the request type and value
-                    OdinData::IpcMessage ctrl_req(ctrl_req_encoded.c_str(), false);
-                    OdinData::IpcMessage::MsgType req_type = ctrl_req.get_msg_type();
-                    OdinData::IpcMessage::MsgVal req_val = ctrl_req.get_msg_val();
-
-                    // Pre-populate the appropriate fields in the response
-                    ctrl_reply.set_msg_id(ctrl_req.get_msg_id());
-                    ctrl_reply.set_msg_type(OdinData::IpcMessage::MsgTypeAck);
-                    ctrl_reply.set_msg_val(req_val);
-
-                    // Handle the request according to its type
-                    switch (req_type)
-                    {
-                    // Handle command reqests
-                    case OdinData::IpcMessage::MsgTypeCmd:
-
-                        // Handle command requests according to their value
-                        switch (req_val)
-                        {
-                        // Handle a configuration command
-                        case OdinData::IpcMessage::MsgValCmdConfigure:
-                            
-                            ss << ": Got camera control configure request from client " << client_identity
-                                << " : " << ctrl_req_encoded << std::endl;
-                            LOG4CXX_DEBUG(logger_, "Core " << lcore_id_ << ss.str());
-
-
-                            CameraController_->configure(ctrl_req, ctrl_reply);
-                            break;
-
-                        // Handle a configuration request command
-                        case OdinData::IpcMessage::MsgValCmdRequestConfiguration:
-                            
-                            ss << " Got camera control read configuration request from client " << client_identity
-                            << " : " << ctrl_req_encoded << std::endl;
-
-                            LOG4CXX_DEBUG(logger_, "Core " << lcore_id_ << ss.str());
-
-                            CameraController_->request_configuration(std::string(""), ctrl_reply);
-                            break;
-
-                        // Handle a status request command
-                        case OdinData::IpcMessage::MsgValCmdStatus:
-
-                            ss << " Got camera control status request from client " << client_identity
-                                << " : " << ctrl_req_encoded << std::endl;
-
-                            LOG4CXX_DEBUG(logger_, "Core " << lcore_id_ << ss.str());
-
-                            CameraController_->get_status(std::string(""), ctrl_reply);
-                            break;
-
-                        // Handle unsupported request values by setting the status and error message
-                        default:
-                            request_ok = false;
-                            error_ss << "Illegal command request value: " << req_val;
-                            break;
-                        }
-                        break;
-
-                    // Handle unsupported request types by setting the status and error message
-                    default:
-                        request_ok = false;
-                        error_ss << "Illegal command request type: " << req_type;
-                        break;
-                    }
-                }
+        bind_channel();
 
-                // Handle exceptions thrown during message decoding, setting the status and error message
-                // accordingly
-                catch (OdinData::IpcMessageException& e)
-                {
-                    request_ok = false;
-                    error_ss << e.what();
-                }
-
-                // If the request could not be decoded or handled, set the response type to NACK and populate
-                // the error parameter with the error string
-                if (!request_ok) {
-                    LOG4CXX_ERROR(logger_, "Error handling camera control channel request from client "
-                                << client_identity << ": " << error_ss.str());
-                    ctrl_reply.set_nack(error_ss.str());
-                }
+        return true;
+    }
 
-                // Send the encoded response back to the client
-                Camera_Ctrl_Channel_.send(ctrl_reply.encode(), 0, client_identity);
-            }
+    int32_t CameraControlCore::service_poll(void)
+    {
+        // Poll without blocking, as other services share the service lcore
+        if (!Camera_Ctrl_Channel_.poll(0))
+        {
+            return -EAGAIN;
         }
-        return true;
+
+        handle_ctrl_request();
+        return 0;
     }
 
     void CameraControlCore::stop(void)
@@ -233,5 +143,123 @@ namespace FrameProcessor
         LOG4CXX_INFO(logger_, config_.core_name << " : " << lcore_id_ << " Got update config.");
     }
 
+    //! Bind the camera control IPC channel
+    void CameraControlCore::bind_channel(void)
+    {
+        // Bind the IPC channel
+        // TODO: Move the address to a config param
+        Camera_Ctrl_Channel_.bind("tcp://0.0.0.0:9001");
+
+        LOG4CXX_INFO(logger_, "Core " << lcore_id_ << " Bound IPC channel to port 9001");
+    }
+
+    //! Receive, handle and reply to a request on the camera control IPC channel
+    void CameraControlCore::handle_ctrl_request(void)
+    {
+        // Receive the control channel request and store the client identity so that the response
+        // can be routed back correctly.
+        std::string client_identity;
+        std::string ctrl_req_encoded = Camera_Ctrl_Channel_.recv(&client_identity);
+
+        // Create a reply message
+        OdinData::IpcMessage ctrl_reply;
+        OdinData::IpcMessage::MsgVal ctrl_reply_val = OdinData::IpcMessage::MsgValIllegal;
+
+        bool request_ok = true;
+        std::ostringstream error_ss;
+
+        std::stringstream ss;
+
+        try
+        {
+
+            // Attempt to decode the incoming message and get the request type and value
+            OdinData::IpcMessage ctrl_req(ctrl_req_encoded.c_str(), false);
+            OdinData::IpcMessage::MsgType req_type = ctrl_req.get_msg_type();
+            OdinData::IpcMessage::MsgVal req_val = ctrl_req.get_msg_val();
+
+            // Pre-populate the appropriate fields in the response
+            ctrl_reply.set_msg_id(ctrl_req.get_msg_id());
+            ctrl_reply.set_msg_type(OdinData::IpcMessage::MsgTypeAck);
+            ctrl_reply.set_msg_val(req_val);
+
+            // Handle the request according to its type
+            switch (req_type)
+            {
+            // Handle command reqests
+            case OdinData::IpcMessage::MsgTypeCmd:
+
+                // Handle command requests according to their value
+                switch (req_val)
+                {
+                // Handle a configuration command
+                case OdinData::IpcMessage::MsgValCmdConfigure:
+                    
+                    ss << ": Got camera control configure request from client " << client_identity
+                        << " : " << ctrl_req_encoded << std::endl;
+                    LOG4CXX_DEBUG(logger_, "Core " << lcore_id_ << ss.str());
+
+
+                    CameraController_->configure(ctrl_req, ctrl_reply);
+                    break;
+
+                // Handle a configuration request command
+                case OdinData::IpcMessage::MsgValCmdRequestConfiguration:
+                    
+                    ss << " Got camera control read configuration request from client " << client_identity
+                    << " : " << ctrl_req_encoded << std::endl;
+
+                    LOG4CXX_DEBUG(logger_, "Core " << lcore_id_ << ss.str());
+
+                    CameraController_->request_configuration(std::string(""), ctrl_reply);
+                    break;
+
+                // Handle a status request command
+                case OdinData::IpcMessage::MsgValCmdStatus:
+
+                    ss << " Got camera control status request from client " << client_identity
+                        << " : " << ctrl_req_encoded << std::endl;
+
+                    LOG4CXX_DEBUG(logger_, "Core " << lcore_id_ << ss.str());
+
+                    CameraController_->get_status(std::string(""), ctrl_reply);
+                    break;
+
+                // Handle unsupported request values by setting the status and error message
+                default:
+                    request_ok = false;
+                    error_ss << "Illegal command request value: " << req_val;
+                    break;
+                }
+                break;
+
+            // Handle unsupported request types by setting the status and error message
+            default:
+                request_ok = false;
+                error_ss << "Illegal command request type: " << req_type;
+                break;
+            }
+        }
+
+        // Handle exceptions thrown during message decoding, setting the status and error message
+        // accordingly
+        catch (OdinData::IpcMessageException& e)
+        {
+            request_ok = false;
+            error_ss << e.what();
+        }
+
+        // If the request could not be decoded or handled, set the response type to NACK and populate
+        // the error parameter with the error string
+        if (!request_ok) {
+            LOG4CXX_ERROR(logger_, "Error handling camera control channel request from client "
+                        << client_identity << ": " << error_ss.str());
+            ctrl_reply.set_nack(error_ss.str());
+        }
+
+        // Send the encoded response back to the client
+        Camera_Ctrl_Channel_.send(ctrl_reply.encode(), 0, client_identity);
+    }
+
     DPDKREGISTER(DpdkWorkerCore, CameraControlCore, "CameraControlCore");
 }
\ No newline at end of file
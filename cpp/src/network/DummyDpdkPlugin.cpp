@@ -6,6 +6,7 @@
  */
 
 #include "network/DummyDpdkPlugin.h"
+#include "network/PacketProcessorCoreImpl.h"
 #include "version.h"
 
 namespace FrameProcessor
@@ -114,6 +115,9 @@ namespace FrameProcessor
     this->push(frame);
   }
 
+  // Packet processor core specialised for the dummy decoder, with decoder calls inlined
+  typedef PacketProcessorCoreT<DummyDpdkDecoder> DummyDpdkPacketProcessorCore;
+  PACKETPROCESSORREGISTER(DummyDpdkPacketProcessorCore, DummyDpdkDecoder, "DummyDpdkPacketProcessorCore");
 
 } /* namespace FrameProcessor */
 
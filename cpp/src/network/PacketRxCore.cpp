@@ -7,6 +7,11 @@
 
 namespace FrameProcessor
 {
+    static const char* device_bus_name(const std::string& device_name)
+    {
+        return (device_name.rfind("net_", 0) == 0) ? "vdev" : "pci";
+    }
+
     PacketRxCore::PacketRxCore(
         int proc_idx, int socket_id, DpdkWorkCoreReferences dpdkWorkCoreReferences
     ) :
@@ -23,13 +28,29 @@ namespace FrameProcessor
         total_packets_(0),
         port_id_(UINT16_MAX),
         device_configured_(false),
-        device_(nullptr)
+        device_(nullptr),
+        owns_device_(false),
+        frame_latch_(&local_frame_latch_),
+        frag_tbl_(NULL),
+        ip_fragments_(0),
+        ip_reassembled_(0),
+        ip_frag_timed_out_(0),
+        ip_frag_table_full_(0),
+        ip_frag_invalid_(0),
+        recorder_("packetrxcore_" + std::to_string(proc_idx), socket_id)
     {
 
         // Resolve configuration parameters for athis core from the config object passed as an
         // argument, and the current port ID
         config_.resolve(dpdkWorkCoreReferences.core_config);
 
+        // When multiple PacketRxCores are configured, each receives on its own device RX queue
+        // and sends replies on its own TX queue, offset from the configured queue IDs
+        queue_idx_ = (config_.num_cores > 0) ? (proc_idx_ % config_.num_cores) : 0;
+        rx_queue_id_ = config_.rx_queue_id_ + queue_idx_;
+        tx_queue_id_ = config_.tx_queue_id_ + queue_idx_;
+        local_frame_latch_.first_frame_number = -1;
+
         LOG4CXX_INFO(logger_, "FP.PacketRxCore " << proc_idx_ << " Created with config:"
             << " | core_name" << config_.core_name
             << " | num_cores: " << config_.num_cores
@@ -38,9 +59,12 @@ namespace FrameProcessor
         );
 
 
-        // Add devices provided in the configuration
+        // Add devices provided in the configuration. The first PacketRxCore adds and starts the
+        // device, the others attach to the running device to receive on their own queues
         if (!config_.pcie_device_.empty()) {
-            if (!add_device(config_.pcie_device_)) {
+            bool device_ok = (queue_idx_ == 0) ?
+                add_device(config_.pcie_device_) : attach_device(config_.pcie_device_);
+            if (!device_ok) {
                 LOG4CXX_ERROR(logger_, "Failed to add device specified in initial configuration: " << config_.pcie_device_);
             }
         }
@@ -75,16 +99,32 @@ namespace FrameProcessor
         std::string ring_name;
 
         // Create packet forwarding rings for each of the packet processing cores with the ring
-        // size rounded up to the next power of two
+        // size rounded up to the next power of two. The rings are shared by all PacketRxCores,
+        // so are only created by the first and are multi-producer if more than one is configured
         ring_size = nearest_power_two(config_.fwd_ring_size_);
+        unsigned int fwd_ring_flags = RING_F_SC_DEQ;
+        if (config_.num_cores <= 1)
+        {
+            fwd_ring_flags |= RING_F_SP_ENQ;
+        }
         for (int core_idx = 0; core_idx < config_.num_downstream_cores; core_idx++)
         {
             ring_name = ring_name_str(config_.core_name, socket_id_, core_idx);
+            if (queue_idx_ != 0)
+            {
+                struct rte_ring *fwd_ring = rte_ring_lookup(ring_name.c_str());
+                if (fwd_ring == NULL)
+                {
+                    LOG4CXX_ERROR(logger_, "Error looking up packet forward ring " << ring_name);
+                }
+                packet_forward_rings_.push_back(fwd_ring);
+                continue;
+            }
             LOG4CXX_INFO(logger_, "Creating packet forward ring name "
                 << ring_name << " of size " << ring_size << " numa node: " << socket_id_
             );
             struct rte_ring *fwd_ring = rte_ring_create(
-                ring_name.c_str(), ring_size, socket_id_, RING_F_SP_ENQ | RING_F_SC_DEQ  
+                ring_name.c_str(), ring_size, socket_id_, fwd_ring_flags
             );
             if (fwd_ring == NULL)
             {
@@ -96,13 +136,34 @@ namespace FrameProcessor
             packet_forward_rings_.push_back(fwd_ring);
         }
 
+        // In burst forwarding mode, packets are staged per forward ring for the duration of
+        // a single RX burst, so each staging array needs to hold at most one full burst
+        if (config_.fwd_burst_mode_)
+        {
+            fwd_staging_.assign(
+                config_.num_downstream_cores,
+                std::vector<struct rte_mbuf *>(config_.rx_burst_size_, nullptr)
+            );
+            fwd_staged_count_.assign(config_.num_downstream_cores, 0);
+            LOG4CXX_INFO(logger_, "Packet forwarding in burst mode with staging size "
+                << config_.rx_burst_size_
+            );
+        }
+
         // Create the packet release ring with the ring size rounded up to the next power of two
         ring_name = ring_name_pkt_release(socket_id_);
         ring_size = nearest_power_two(config_.release_ring_size_);
         LOG4CXX_DEBUG_LEVEL(2, logger_, "Creating packet release ring name "
             << ring_name << " of size " << ring_size << " numa node: " << socket_id_
         );
-        packet_release_ring_ = rte_ring_create(ring_name.c_str(), ring_size, socket_id_, 0);
+        if (queue_idx_ == 0)
+        {
+            packet_release_ring_ = rte_ring_create(ring_name.c_str(), ring_size, socket_id_, 0);
+        }
+        else
+        {
+            packet_release_ring_ = rte_ring_lookup(ring_name.c_str());
+        }
         if (packet_release_ring_ == NULL)
         {
             LOG4CXX_ERROR(logger_, "Error creating packet release ring " << ring_name
@@ -111,6 +172,65 @@ namespace FrameProcessor
             // TODO - raise exception here?
         }
 
+        // Create the IPv4 reassembly table for this core if enabled. Each core reassembles the
+        // datagrams received on its own queue, so the table is private to the core and sized for
+        // the configured number of datagrams in flight. Only the first fragment of a datagram
+        // holds the UDP header, so with RSS or flow steering across several queues the remaining
+        // fragments can arrive on another queue and the datagram could never be reassembled
+        death_row_.cnt = 0;
+        const DpdkDeviceConfiguration& device_config = config_.dpdk_device();
+        if (config_.ip_reassembly_ &&
+            (device_config.rx_steering() != "none") && (device_config.rx_rings() > 1))
+        {
+            LOG4CXX_ERROR(logger_, "IPv4 reassembly is not compatible with "
+                << device_config.rx_steering() << " steering across "
+                << device_config.rx_rings() << " RX queues, use rx_steering none"
+                << ", fragmented datagrams will be dropped"
+            );
+        }
+        else if (config_.ip_reassembly_)
+        {
+            frag_tbl_ = rte_ip_frag_table_create(
+                config_.ip_frag_flows_, IP_FRAG_BUCKET_ENTRIES, config_.ip_frag_flows_,
+                convert_ms_to_cycles(config_.ip_frag_timeout_ms_), socket_id_
+            );
+            if (frag_tbl_ == NULL)
+            {
+                LOG4CXX_ERROR(logger_, "Error creating IPv4 reassembly table for "
+                    << config_.ip_frag_flows_ << " flows : " << rte_strerror(rte_errno)
+                    << ", fragmented datagrams will be dropped"
+                );
+            }
+            else
+            {
+                LOG4CXX_INFO(logger_, "Reassembling IPv4 fragments for up to "
+                    << config_.ip_frag_flows_ << " datagrams with timeout "
+                    << config_.ip_frag_timeout_ms_ << "ms"
+                );
+            }
+        }
+
+        // Create, or look up, the frame number latch shared between the PacketRxCores. If this
+        // fails, fall back to a latch local to this core
+        std::string latch_name = rx_frame_latch_name_str(socket_id_);
+        const struct rte_memzone* latch_mz = (queue_idx_ == 0) ?
+            rte_memzone_reserve(latch_name.c_str(), sizeof(PacketRxFrameLatch), socket_id_, 0) :
+            rte_memzone_lookup(latch_name.c_str());
+        if (latch_mz != NULL)
+        {
+            frame_latch_ = static_cast<PacketRxFrameLatch*>(latch_mz->addr);
+            if (queue_idx_ == 0)
+            {
+                frame_latch_->first_frame_number = -1;
+            }
+        }
+        else
+        {
+            LOG4CXX_ERROR(logger_, "Error obtaining shared frame latch " << latch_name
+                << ", using a latch local to this core"
+            );
+        }
+
         // Check that at least one RX port has been defined
         if (config_.rx_ports_.size() == 0)
         {
@@ -135,18 +255,32 @@ namespace FrameProcessor
         // Stop the core polling loop so the run method terminates
         stop();
 
-        // Free the packet forwarding rings
-        for (auto& fwd_ring: packet_forward_rings_)
+        // Free any fragments awaiting reassembly, before the release ring can be freed
+        if (frag_tbl_ != NULL)
+        {
+            rte_ip_frag_free_death_row(&death_row_, 0);
+            rte_ip_frag_table_destroy(frag_tbl_);
+            frag_tbl_ = NULL;
+        }
+
+        // Free the packet forwarding and release rings if this core created them
+        if (queue_idx_ == 0)
         {
-            rte_ring_free(fwd_ring);
+            for (auto& fwd_ring: packet_forward_rings_)
+            {
+                rte_ring_free(fwd_ring);
+            }
+            rte_ring_free(packet_release_ring_);
+
+            if (frame_latch_ != &local_frame_latch_)
+            {
+                rte_memzone_free(rte_memzone_lookup(rx_frame_latch_name_str(socket_id_).c_str()));
+            }
         }
         packet_forward_rings_.clear();
         std::vector<struct rte_ring *>(packet_forward_rings_).swap(packet_forward_rings_);
 
-        // Free the packet release ring
-        rte_ring_free(packet_release_ring_);
-
-        if (device_) {
+        if (device_configured_) {
             remove_device();
         }
 
@@ -157,7 +291,11 @@ namespace FrameProcessor
         lcore_id_ = lcore_id;
         run_lcore_ = true;
 
-        LOG4CXX_INFO(logger_, "PacketRxCore " << lcore_id_ << " starting up");
+        LOG4CXX_INFO(logger_, "PacketRxCore " << lcore_id_ << " starting up on RX queue "
+            << rx_queue_id_ << " TX queue " << tx_queue_id_
+        );
+
+        recorder_.start();
 
         
 
@@ -174,9 +312,10 @@ namespace FrameProcessor
 
         bool pkt_tx_reply = false;
         bool pkt_forwarded = false;
+        bool pkt_held = false;
 
         // check to see if a valid device has been configured
-        if (!device_configured_ || !device_) {
+        if (!device_configured_) {
             LOG4CXX_ERROR(logger_, "No device configured. Stopping RxCore.");
             return false;
         }
@@ -184,13 +323,15 @@ namespace FrameProcessor
         while (likely(run_lcore_))
         {
             uint16_t num_rx_pkts = rte_eth_rx_burst(
-                port_id_, config_.rx_queue_id_, pkt_bufs, config_.rx_burst_size_
+                port_id_, rx_queue_id_, pkt_bufs, config_.rx_burst_size_
             );
+            uint64_t rx_cycles = rte_get_tsc_cycles();
 
             for (uint16_t idx = 0; idx < num_rx_pkts; idx++)
             {
                 pkt_tx_reply = false;
                 pkt_forwarded = false;
+                pkt_held = false;
 
                 if (likely(idx < num_rx_pkts - 1))
                 {
@@ -216,12 +357,31 @@ namespace FrameProcessor
                             (uint8_t *)pkt_ether_hdr + sizeof(struct rte_ether_hdr)
                         );
 
+                        // Only the first fragment of a datagram holds the UDP header, so if
+                        // reassembly is enabled, hold fragments until the whole datagram has
+                        // been received and then handle it as a chain of mbufs
+                        if (unlikely(rte_ipv4_frag_pkt_is_fragmented(pkt_ipv4_hdr)) &&
+                            (frag_tbl_ != NULL))
+                        {
+                            pkt = reassemble_fragment(pkt, pkt_ipv4_hdr, rx_cycles);
+                            if (pkt == NULL)
+                            {
+                                pkt_held = true;
+                                break;
+                            }
+                            pkt_ether_hdr = rte_pktmbuf_mtod(pkt, struct rte_ether_hdr *);
+                            pkt_ipv4_hdr = (struct rte_ipv4_hdr *)(
+                                (uint8_t *)pkt_ether_hdr + sizeof(struct rte_ether_hdr)
+                            );
+                        }
+
+                        // Locate the L4 header after any IPv4 options, as when reassembling
                         switch(pkt_ipv4_hdr->next_proto_id)
                         {
                             case IPPROTO_ICMP:
 
                                 pkt_icmp_hdr = (struct rte_icmp_hdr *)(
-                                    (uint8_t *)pkt_ipv4_hdr + sizeof(struct rte_ipv4_hdr)
+                                    (uint8_t *)pkt_ipv4_hdr + rte_ipv4_hdr_len(pkt_ipv4_hdr)
                                 );
 
                                 pkt_tx_reply = handle_icmp_request(
@@ -232,7 +392,7 @@ namespace FrameProcessor
                             case IPPROTO_UDP:
 
                                 pkt_udp_hdr = (struct rte_udp_hdr *)(
-                                    (uint8_t *)pkt_ipv4_hdr + sizeof(struct rte_ipv4_hdr)
+                                    (uint8_t *)pkt_ipv4_hdr + rte_ipv4_hdr_len(pkt_ipv4_hdr)
                                 );
 
                                 pkt_forwarded = handle_udp_packet(
@@ -259,16 +419,25 @@ namespace FrameProcessor
 
                 // If a handler wants to send a reply to the packet, add it to the buffer
                 // and increment the number of replies. If the packet has been forwarded by a
-                // handler (e.g. valid UDP packets) do nothing, otherwise free the packet mbuf
-                if (pkt_tx_reply)
+                // handler (e.g. valid UDP packets) or is a fragment held by the reassembly
+                // table do nothing, otherwise free the packet mbuf
+                if (pkt_held)
+                {
+                    // Fragment held for reassembly, or already on the reassembly death row
+                }
+                else if (pkt_tx_reply)
                 {
                     pkt_bufs[num_replies++] = pkt;
                     dropped_packets_++;
                 }
                 else if (pkt_forwarded)
                 {
-                    // Do nothing with the packet - handler has forwarded it
-                    captured_packets_++;
+                    // Do nothing with the packet - handler has forwarded it. In burst mode
+                    // the packet is only staged, and is accounted for when staging is flushed
+                    if (!config_.fwd_burst_mode_)
+                    {
+                        captured_packets_++;
+                    }
                 }
                 else
                 {
@@ -277,11 +446,28 @@ namespace FrameProcessor
                 }
             } // for (uint16_t idx = 0; idx < num_rx_pkts; idx++)
 
+            // Forward any packets staged during this burst to the packet processor cores
+            if (config_.fwd_burst_mode_)
+            {
+                flush_forward_staging();
+            }
+
+            // Time out any incomplete datagrams and release the fragments freed by reassembly
+            if (unlikely(frag_tbl_ != NULL))
+            {
+#ifdef DPDK_IP_FRAG_DEL_EXPIRED_ENTRIES
+                uint32_t num_freed = death_row_.cnt;
+                rte_ip_frag_table_del_expired_entries(frag_tbl_, &death_row_, rx_cycles);
+                ip_frag_timed_out_ += death_row_.cnt - num_freed;
+#endif
+                release_death_row();
+            }
+
             // If any replies have been generated, queue them for TX
             if (num_replies > 0)
             {
                 uint16_t num_tx_pkts = rte_eth_tx_burst(
-                    port_id_, config_.tx_queue_id_, pkt_bufs, num_replies
+                    port_id_, tx_queue_id_, pkt_bufs, num_replies
                 );
 
                 if (unlikely(num_tx_pkts < num_replies))
@@ -291,7 +477,7 @@ namespace FrameProcessor
                     {
                         //rte_delay_us(1);
                         num_tx_pkts += rte_eth_tx_burst(
-                            port_id_, config_.tx_queue_id_, &pkt_bufs[num_tx_pkts],
+                            port_id_, tx_queue_id_, &pkt_bufs[num_tx_pkts],
                             num_replies - num_tx_pkts
                         );
                     }
@@ -494,12 +680,24 @@ namespace FrameProcessor
 
             if(unlikely(first_frame_number_ == -1))
             {
+                // If another PacketRxCore has already latched the first frame number, use it so
+                // that frames are distributed consistently across all RX queues
+                int64_t latched_frame_number = frame_latch_->first_frame_number.load();
 
                 // Check if this is the first packet of a frame or the first seen packet of a new frame
 
-                if (packet_number == 0 || frame_number > first_seen_frame_number_)
+                if (latched_frame_number != -1)
                 {
-                    first_frame_number_ = frame_number;
+                    first_frame_number_ = latched_frame_number;
+                }
+                else if (packet_number == 0 || frame_number > first_seen_frame_number_)
+                {
+                    if (frame_latch_->first_frame_number.compare_exchange_strong(
+                        latched_frame_number, frame_number))
+                    {
+                        latched_frame_number = frame_number;
+                    }
+                    first_frame_number_ = latched_frame_number;
                     // LOG4CXX_INFO(logger_, "Frame latch updated to: " << first_frame_number_);
                 }
                 else
@@ -527,10 +725,28 @@ namespace FrameProcessor
             //     << " packet: " << decoder_->get_packet_number(pkt_header)
             // );
 
+            unsigned int fwd_ring_idx =
+                (current_frame_number / frame_outer_chunk_size) % config_.num_downstream_cores;
+
+            // Record the first packet of each super frame received
+            if (unlikely(packet_number == 0) && ((current_frame_number % frame_outer_chunk_size) == 0))
+            {
+                recorder_.record(
+                    current_frame_number / frame_outer_chunk_size, FlightRecorder::rx,
+                    FlightRecorder::first_packet
+                );
+            }
+
+            // In burst mode, stage the packet for the appropriate forwarding ring. The staged
+            // packets are enqueued together once the whole RX burst has been classified
+            if (likely(config_.fwd_burst_mode_))
+            {
+                fwd_staging_[fwd_ring_idx][fwd_staged_count_[fwd_ring_idx]++] = *pkt;
+                return true;
+            }
+
             // Queue the packet on the appropriate forwarding ring based on the frame number
-            int rc = rte_ring_enqueue(
-                packet_forward_rings_[(current_frame_number / frame_outer_chunk_size) % config_.num_downstream_cores], *pkt
-            );
+            int rc = rte_ring_enqueue(packet_forward_rings_[fwd_ring_idx], *pkt);
 
             // If the queueing failed, attempt to retry
             if (unlikely(rc != 0))
@@ -539,10 +755,7 @@ namespace FrameProcessor
                 while ((rc != 0) && (retry++ < config_.max_packet_queue_retries_))
                 {
                     //rte_delay_us(1);
-                    rc = rte_ring_enqueue(
-                        packet_forward_rings_[(current_frame_number / frame_outer_chunk_size) % config_.num_downstream_cores],
-                        *pkt
-                    );
+                    rc = rte_ring_enqueue(packet_forward_rings_[fwd_ring_idx], *pkt);
                 }
                 LOG4CXX_INFO(logger_, "PacketRxCore failed to enqueue packet, ring full");
             }
@@ -558,6 +771,146 @@ namespace FrameProcessor
         return pkt_forwarded;
     }
 
+    /**
+    * @brief Flushes the packets staged for each forwarding ring.
+    *
+    * Each non-empty staging array is enqueued on its forwarding ring with a single burst
+    * enqueue, retrying the remainder of a partially enqueued burst up to the configured number
+    * of queue retries. Packets that still cannot be queued are freed. The captured and dropped
+    * packet counters are updated with the number of packets actually enqueued and freed.
+    */
+    void PacketRxCore::flush_forward_staging(void)
+    {
+        for (unsigned int ring_idx = 0; ring_idx < fwd_staged_count_.size(); ring_idx++)
+        {
+            uint16_t num_staged = fwd_staged_count_[ring_idx];
+            if (num_staged == 0)
+            {
+                continue;
+            }
+
+            struct rte_mbuf **staged_pkts = fwd_staging_[ring_idx].data();
+            unsigned int num_enqueued = rte_ring_enqueue_burst(
+                packet_forward_rings_[ring_idx], (void **)staged_pkts, num_staged, NULL
+            );
+
+            // If only part of the burst was queued, retry with the remaining packets
+            if (unlikely(num_enqueued < num_staged))
+            {
+                uint32_t retry = 0;
+                while ((num_enqueued < num_staged) &&
+                    (retry++ < config_.max_packet_queue_retries_))
+                {
+                    num_enqueued += rte_ring_enqueue_burst(
+                        packet_forward_rings_[ring_idx], (void **)&staged_pkts[num_enqueued],
+                        num_staged - num_enqueued, NULL
+                    );
+                }
+            }
+
+            captured_packets_ += num_enqueued;
+
+            // Free any packets left over after the retries and count them as dropped
+            if (unlikely(num_enqueued < num_staged))
+            {
+                uint16_t num_unsent = num_staged - num_enqueued;
+                rte_pktmbuf_free_bulk(&staged_pkts[num_enqueued], num_unsent);
+                dropped_packets_ += num_unsent;
+                LOG4CXX_INFO(logger_, "PacketRxCore failed to enqueue " << num_unsent
+                    << " of " << num_staged << " packets, ring " << ring_idx << " full"
+                );
+            }
+
+            fwd_staged_count_[ring_idx] = 0;
+        }
+    }
+
+    /**
+    * @brief Adds an IPv4 fragment to the reassembly table.
+    *
+    * The fragment is held in the table until every fragment of its datagram has been received,
+    * when the datagram is returned as a chain of the fragment mbufs, with the protocol headers in
+    * the first segment. Fragments freed by the table are collected on the death row, and the
+    * fragment counters are updated from the fragments added to it by the table. Expired entries
+    * are normally removed on each polling loop, so a fragment freed alone is one the table had
+    * no room for, other fragments freed with it belong to an invalid datagram, and fragments
+    * freed while the new fragment is held belong to a timed out datagram whose entry was reused.
+    *
+    * @param pkt A pointer to the fragment.
+    * @param pkt_ipv4_hdr A pointer to the IPv4 header of the fragment.
+    * @param rx_cycles The TSC cycle count the fragment was received at.
+    *
+    * @return the reassembled datagram, or NULL if the fragment was held or freed.
+    */
+    struct rte_mbuf* PacketRxCore::reassemble_fragment(
+        struct rte_mbuf* pkt, struct rte_ipv4_hdr* pkt_ipv4_hdr, uint64_t rx_cycles
+    )
+    {
+        ip_fragments_++;
+
+        // Ensure the death row has room for the fragments the table could free on this call,
+        // those of a stale entry it reuses and those of the entry the fragment is added to
+        if (unlikely((death_row_.cnt + (2 * (RTE_LIBRTE_IP_FRAG_MAX_FRAG + 1))) >
+            RTE_IP_FRAG_DEATH_ROW_MBUF_LEN))
+        {
+            release_death_row();
+        }
+
+        pkt->l2_len = sizeof(struct rte_ether_hdr);
+        pkt->l3_len = rte_ipv4_hdr_len(pkt_ipv4_hdr);
+
+        uint32_t num_freed = death_row_.cnt;
+        struct rte_mbuf* datagram = rte_ipv4_frag_reassemble_packet(
+            frag_tbl_, &death_row_, pkt, rx_cycles, pkt_ipv4_hdr
+        );
+        num_freed = death_row_.cnt - num_freed;
+
+        if (datagram != NULL)
+        {
+            ip_reassembled_++;
+        }
+        else if (num_freed > 0)
+        {
+            if (death_row_.row[death_row_.cnt - 1] != pkt)
+            {
+                ip_frag_timed_out_ += num_freed;
+            }
+            else if (num_freed == 1)
+            {
+                ip_frag_table_full_++;
+            }
+            else
+            {
+                ip_frag_invalid_ += num_freed;
+            }
+        }
+
+        return datagram;
+    }
+
+    /**
+    * @brief Releases the fragments freed by the reassembly table.
+    *
+    * The fragments are passed to the packet release ring, to be freed in a burst along with the
+    * packets released by the packet processor cores. Any that cannot be queued are freed here.
+    */
+    void PacketRxCore::release_death_row(void)
+    {
+        if (death_row_.cnt == 0)
+        {
+            return;
+        }
+
+        unsigned int num_queued = rte_ring_enqueue_burst(
+            packet_release_ring_, (void **)death_row_.row, death_row_.cnt, NULL
+        );
+        if (unlikely(num_queued < death_row_.cnt))
+        {
+            rte_pktmbuf_free_bulk(&death_row_.row[num_queued], death_row_.cnt - num_queued);
+        }
+        death_row_.cnt = 0;
+    }
+
     bool PacketRxCore::add_device(const std::string& pci_address)
     {
         if (device_configured_) {
@@ -565,7 +918,9 @@ namespace FrameProcessor
             return false;
         }
 
-        int ret = rte_eal_hotplug_add("pci", pci_address.c_str(), "");
+        // Virtual devices, e.g. net_null or net_ring, are hot plugged on the vdev bus, allowing
+        // the RX path to be exercised without a physical NIC
+        int ret = rte_eal_hotplug_add(device_bus_name(pci_address), pci_address.c_str(), "");
         if (ret < 0) {
             LOG4CXX_ERROR(logger_, "Failed to hot plug device: " << pci_address);
             return false;
@@ -577,7 +932,10 @@ namespace FrameProcessor
             return false;
         }
 
-        device_ = new DpdkDevice(port_id_, config_.dpdk_device());
+        // Pass the size of the packet headers so the device can split them from the payload
+        device_ = new DpdkDevice(
+            port_id_, config_.dpdk_device(), decoder_->get_packet_payload_offset()
+        );
         if (!device_->start()) {
             LOG4CXX_ERROR(logger_, "Failed to start device: " << pci_address);
             delete device_;
@@ -585,10 +943,51 @@ namespace FrameProcessor
             return false;
         }
 
+        // Steer packets to the RX queues of the device. If the device does not support the
+        // requested steering, each core still receives on its own queue and frames continue to
+        // be distributed to the downstream cores in software
+        device_->configure_steering(config_.rx_ports_);
+
+        owns_device_ = true;
         device_configured_ = true;
         LOG4CXX_INFO(logger_, "Successfully added device: " << pci_address << " (Port ID: " << port_id_ << ")");
         return true;
     }
+
+    /**
+     * @brief Attaches to a device already added by the first PacketRxCore.
+     *
+     * Resolves the port ID of the device and checks that it has an RX queue for this core.
+     *
+     * @param pci_address PCIe address of the device.
+     * @return true if the device was attached, false otherwise.
+     */
+    bool PacketRxCore::attach_device(const std::string& pci_address)
+    {
+        int ret = rte_eth_dev_get_port_by_name(pci_address.c_str(), &port_id_);
+        if (ret != 0) {
+            LOG4CXX_ERROR(logger_, "Failed to get port ID for device: " << pci_address);
+            return false;
+        }
+
+        struct rte_eth_dev_info dev_info;
+        ret = rte_eth_dev_info_get(port_id_, &dev_info);
+        if ((ret != 0) || (rx_queue_id_ >= dev_info.nb_rx_queues) ||
+            (tx_queue_id_ >= dev_info.nb_tx_queues)) {
+            LOG4CXX_ERROR(logger_, "Device " << pci_address << " has no RX queue " << rx_queue_id_
+                << " or TX queue " << tx_queue_id_
+                << " - rx_rings and tx_rings must be at least num_cores"
+            );
+            port_id_ = UINT16_MAX;
+            return false;
+        }
+
+        device_configured_ = true;
+        LOG4CXX_INFO(logger_, "Attached to device: " << pci_address << " (Port ID: " << port_id_
+            << ") RX queue " << rx_queue_id_
+        );
+        return true;
+    }
     
     bool PacketRxCore::remove_device()
     {
@@ -596,18 +995,28 @@ namespace FrameProcessor
             return true;
         }
 
+        // Only the core which added the device stops and removes it
+        if (!owns_device_) {
+            device_configured_ = false;
+            port_id_ = UINT16_MAX;
+            return true;
+        }
+
         if (device_) {
             device_->stop();
             delete device_;
             device_ = nullptr;
         }
 
-        int ret = rte_eal_hotplug_remove("pci", config_.pcie_device_.c_str());
+        int ret = rte_eal_hotplug_remove(
+            device_bus_name(config_.pcie_device_), config_.pcie_device_.c_str()
+        );
         if (ret < 0) {
             LOG4CXX_ERROR(logger_, "Failed to hot unplug device: " << config_.pcie_device_);
             return false;
         }
 
+        owns_device_ = false;
         device_configured_ = false;
         port_id_ = UINT16_MAX;
         LOG4CXX_INFO(logger_, "Successfully removed device: " << config_.pcie_device_);
@@ -616,10 +1025,10 @@ namespace FrameProcessor
 
     void PacketRxCore::status(OdinData::IpcMessage& status, const std::string& path)
     {
-        LOG4CXX_DEBUG(logger_, "Status requested for packetrxcore_" << port_id_
+        LOG4CXX_DEBUG(logger_, "Status requested for packetrxcore_" << proc_idx_
             << " from the DPDK plugin");
 
-        std::string status_path = path + "/packetrxcore_" + std::to_string(port_id_) + "/";
+        std::string status_path = path + "/packetrxcore_" + std::to_string(proc_idx_) + "/";
 
         // Original status parameters
         status.set_param(status_path + "total_packets", total_packets_);
@@ -629,10 +1038,27 @@ namespace FrameProcessor
         status.set_param(status_path + "rx_frames", rx_frames_);
         status.set_param(status_path + "first_seen_frame_number", first_seen_frame_number_);
         status.set_param(status_path + "first_frame_number", first_frame_number_);
+        status.set_param(status_path + "port_id", (uint64_t)port_id_);
+        status.set_param(status_path + "rx_queue_id", (uint64_t)rx_queue_id_);
+        status.set_param(status_path + "tx_queue_id", (uint64_t)tx_queue_id_);
+        if (frag_tbl_ != NULL) {
+            status.set_param(status_path + "ip_reassembly/fragments", ip_fragments_);
+            status.set_param(status_path + "ip_reassembly/reassembled", ip_reassembled_);
+            status.set_param(status_path + "ip_reassembly/timed_out", ip_frag_timed_out_);
+            status.set_param(status_path + "ip_reassembly/table_full", ip_frag_table_full_);
+            status.set_param(status_path + "ip_reassembly/invalid", ip_frag_invalid_);
+        }
+        if (device_) {
+            status.set_param(status_path + "rx_steering", device_->rx_steering());
+            status.set_param(status_path + "hw_steering", device_->hw_steering());
+            status.set_param(status_path + "rx_buffer_split", device_->buffer_split());
+            status.set_param(status_path + "rx_single_segment", device_->single_segment());
+            status.set_param(status_path + "mbuf_data_room", (uint64_t)device_->mbuf_data_room());
+        }
 
         // RX Queue packet count
         if (device_configured_ && port_id_ != UINT16_MAX) {
-            int rx_queue_count = rte_eth_rx_queue_count(port_id_, config_.rx_queue_id_);
+            int rx_queue_count = rte_eth_rx_queue_count(port_id_, rx_queue_id_);
             if (rx_queue_count >= 0) {
                 status.set_param(status_path + "rx_queue_packet_count", (uint64_t)rx_queue_count);
             }
@@ -668,7 +1094,7 @@ namespace FrameProcessor
 
         // Memory pool monitoring - requires DpdkDevice::get_mbuf_pool() method
         // TODO: Add getter method to DpdkDevice class: struct rte_mempool* get_mbuf_pool() const { return mbuf_pool_; }
-        if (device_) {
+        if (device_configured_) {
             // Try to lookup mbuf pool by name (if mbuf_pool_name_str function is available)
             std::string mbuf_pool_name = mbuf_pool_name_str(socket_id_);
             struct rte_mempool* mbuf_pool = rte_mempool_lookup(mbuf_pool_name.c_str());
@@ -719,6 +1145,7 @@ namespace FrameProcessor
         status.set_param(status_path + "num_downstream_cores", (uint64_t)config_.num_downstream_cores);
         status.set_param(status_path + "rx_burst_size", (uint64_t)config_.rx_burst_size_);
         status.set_param(status_path + "max_packet_queue_retries", (uint64_t)config_.max_packet_queue_retries_);
+        status.set_param(status_path + "fwd_burst_mode", config_.fwd_burst_mode_);
     }
 
     bool PacketRxCore::connect(void)
@@ -748,6 +1175,7 @@ namespace FrameProcessor
         {   
             first_frame_number_ = -1;
             first_seen_frame_number_ = -1;
+            frame_latch_->first_frame_number = -1;
             rx_frames_ = config.get_param("rx_frames", rx_frames_);
             LOG4CXX_INFO(logger_, config_.core_name << " : " << proc_idx_ << " Reseting frame latch and setting rx_frames_ to: " <<  rx_frames_);
         }
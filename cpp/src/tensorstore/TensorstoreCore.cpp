@@ -54,7 +54,7 @@ namespace FrameProcessor
         shared_buf_(dpdkWorkCoreReferences.shared_buf),
         last_frame_(0),
         processed_frames_(0),
-        clear_frames_ring_(NULL),
+        buffer_pool_(dpdkWorkCoreReferences.buffer_pool),
         upstream_ring_(NULL),
         tensorstore_initialized_(false),
         data_type_("uint16"),
@@ -107,35 +107,12 @@ namespace FrameProcessor
             << " csv_path = " << csv_path_
         );
 
-        for (int ring_idx = 0; ring_idx < config_.num_downstream_cores; ring_idx++)
-        {
-            std::string downstream_ring_name = ring_name_str(config_.core_name, socket_id_, ring_idx);
-            struct rte_ring* downstream_ring = rte_ring_lookup(downstream_ring_name.c_str());
-            
-            if (downstream_ring == NULL)
-            {
-                unsigned int downstream_ring_size = nearest_power_two(shared_buf_->get_num_buffers()*2);
-                LOG4CXX_INFO(logger_, "Creating ring name "
-                    << downstream_ring_name << " of size " << downstream_ring_size
-                );
-                
-                downstream_ring = rte_ring_create(
-                    downstream_ring_name.c_str(), downstream_ring_size, socket_id_, 0
-                );
-                
-                if (downstream_ring == NULL)
-                {
-                    LOG4CXX_ERROR(logger_, "Error creating downstream ring " << downstream_ring_name
-                        << " : " << rte_strerror(rte_errno)
-                    );
-                }
-            }
-            
-            if (downstream_ring)
-            {
-                downstream_rings_.push_back(downstream_ring);
-            }
-        }
+        // Create the downstream rings, or look them up if already created by another core, and
+        // select the policy for distributing frames between them
+        downstream_.create_rings(
+            config_.core_name, config_.distribution_, config_.num_downstream_cores,
+            shared_buf_->get_num_buffers() * 2, socket_id_
+        );
     }
 
     TensorstoreCore::~TensorstoreCore(void)
@@ -401,6 +378,9 @@ namespace FrameProcessor
             }
         }
 
+        // Return any frame buffers cached on this lcore to the pool
+        buffer_pool_->flush();
+
         LOG4CXX_INFO(logger_, "Core " << lcore_id_ << " completed");
         return true;
     }
@@ -633,45 +613,24 @@ namespace FrameProcessor
     {
         int ret;
         
-        // Returns frame directly to clear_frames_ring_ if there are no downstream cores
-        if (config_.num_downstream_cores == 0 || downstream_rings_.empty()) {
-            if (clear_frames_ring_ != NULL) {
-                ret = rte_ring_enqueue(clear_frames_ring_, frame_buffer);
-                if (ret != 0) {
-                    LOG4CXX_ERROR(logger_, "Failed to return frame " << frame_number 
-                        << " to clear_frames_ring: " << rte_strerror(-ret));
-                } else {
-                    LOG4CXX_DEBUG_LEVEL(3, logger_, "Returned frame " << frame_number 
-                        << " to clear_frames_ring");
-                }
-            } else {
-                LOG4CXX_ERROR(logger_, "clear_frames_ring is NULL, cannot return frame " << frame_number);
-            }
+        // Returns frame directly to the buffer pool if there are no downstream cores
+        if (config_.num_downstream_cores == 0 || downstream_.empty()) {
+            buffer_pool_->release(frame_buffer);
+            LOG4CXX_DEBUG_LEVEL(3, logger_, "Returned frame " << frame_number 
+                << " to buffer pool");
             return;
         }
         
         // Distribute frames across downstream cores for load balancing 
-        ret = rte_ring_enqueue(
-            downstream_rings_[frame_number % (config_.num_downstream_cores)], 
-            frame_buffer
-        );
+        ret = downstream_.enqueue(frame_buffer, frame_number);
         if (ret != 0) {
             LOG4CXX_ERROR(logger_, "Failed to forward frame " << frame_number 
                 << " to downstream ring: " << rte_strerror(-ret));
             
-            // Attempt to return frame to clear_frames_ring_ if forwarding fails
-            if (clear_frames_ring_ != NULL) {
-                int clear_ret = rte_ring_enqueue(clear_frames_ring_, frame_buffer);
-                if (clear_ret != 0) {
-                    LOG4CXX_ERROR(logger_, "Failed to return frame " << frame_number 
-                        << " to clear_frames_ring: " << rte_strerror(-clear_ret));
-                } else {
-                    LOG4CXX_DEBUG_LEVEL(2, logger_, "Returned frame " << frame_number 
-                        << " to clear_frames_ring");
-                }
-            } else {
-                LOG4CXX_ERROR(logger_, "Failed to return frame " << frame_number << ": clear_frames_ring is null");
-            }
+            // Return frame to the buffer pool if forwarding fails
+            buffer_pool_->release(frame_buffer);
+            LOG4CXX_DEBUG_LEVEL(2, logger_, "Returned frame " << frame_number 
+                << " to buffer pool");
         }
     }
 
@@ -720,8 +679,8 @@ namespace FrameProcessor
 
         status.set_param(ring_status + ring_name_str(config_.upstream_core, socket_id_, proc_idx_) + "_count", rte_ring_count(upstream_ring_));
         status.set_param(ring_status + ring_name_str(config_.upstream_core, socket_id_, proc_idx_) + "_size", rte_ring_get_size(upstream_ring_));
-        status.set_param(ring_status + ring_name_clear_frames(socket_id_) + "_count" , rte_ring_count(clear_frames_ring_));
-        status.set_param(ring_status + ring_name_clear_frames(socket_id_) + "_size" , rte_ring_get_size(clear_frames_ring_));
+
+        downstream_.status(status, status_path + "distribution/");
 
         status.set_param(ts_status + "initialized", tensorstore_initialized_);
         status.set_param(ts_status + "storage_path", config_.path_);
@@ -738,7 +697,9 @@ namespace FrameProcessor
     bool TensorstoreCore::connect(void)
     {
         std::string upstream_ring_name = ring_name_str(config_.upstream_core, socket_id_, proc_idx_);
-        struct rte_ring* upstream_ring = rte_ring_lookup(upstream_ring_name.c_str());
+        struct rte_ring* upstream_ring = DownstreamDistributor::lookup_upstream_ring(
+            config_.upstream_core, socket_id_, proc_idx_
+        );
         
         if (upstream_ring == NULL)
         {
@@ -750,15 +711,6 @@ namespace FrameProcessor
             upstream_ring_ = upstream_ring; 
         }
 
-        std::string clear_frames_ring_name = ring_name_clear_frames(socket_id_);
-        clear_frames_ring_ = rte_ring_lookup(clear_frames_ring_name.c_str());
-        
-        if (clear_frames_ring_ == NULL)
-        {
-            LOG4CXX_INFO(logger_, config_.core_name << " : " << proc_idx_ << " Failed to Connect to upstream resources!");
-            return false;
-        }
-        
         LOG4CXX_INFO(logger_, config_.core_name << " : " << proc_idx_ << " Connected to upstream resources successfully!");
         return true;
     }